@@ -0,0 +1,339 @@
+/*
+ * Backlog Redemption Engine - Implementation
+ * Walks the log index from the sync watermark and uploads blocks in order
+ */
+
+#include "backlog_redemption.h"
+#include "soc_core.h"
+#include "network_client.h"
+#include "nvme_controller.h"
+#include "ethernet_mac.h"
+#include "network_config.h"
+#include <stddef.h>
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+/* ============================================================================
+ * DURABLE WATERMARK
+ * ============================================================================ */
+
+#define REDEMPTION_STATE_MAGIC      0x4B53594E  // "NYSK"
+#define REDEMPTION_STATE_VERSION    1
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t last_sync_offset;
+    uint64_t last_sync_timestamp;
+    uint32_t checksum;
+    uint32_t reserved;
+} RedemptionStateRecord;
+
+static uint32_t state_checksum(const RedemptionStateRecord* rec) {
+    // FNV-1a over everything before the checksum field
+    const uint8_t* p = (const uint8_t*)rec;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < offsetof(RedemptionStateRecord, checksum); i++) {
+        hash ^= p[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Write-to-temp + fsync + rename so a crash leaves either the old or the new
+// watermark on disk, never a torn one.
+static bool redemption_persist(BlackBoxSoC* soc) {
+    RedemptionStateRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.magic = REDEMPTION_STATE_MAGIC;
+    rec.version = REDEMPTION_STATE_VERSION;
+    rec.last_sync_offset = soc->cloud_sync.last_sync_offset;
+    rec.last_sync_timestamp = soc->cloud_sync.last_sync_timestamp;
+    rec.checksum = state_checksum(&rec);
+
+    const char* tmp_path = REDEMPTION_STATE_PATH ".tmp";
+    FILE* f = fopen(tmp_path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(&rec, sizeof(rec), 1, f) == 1;
+    ok = ok && fflush(f) == 0;
+#ifdef __unix__
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    fclose(f);
+    if (!ok) return false;
+
+#ifdef _WIN32
+    remove(REDEMPTION_STATE_PATH);
+#endif
+    return rename(tmp_path, REDEMPTION_STATE_PATH) == 0;
+}
+
+static bool redemption_load(RedemptionStateRecord* rec) {
+    FILE* f = fopen(REDEMPTION_STATE_PATH, "rb");
+    if (!f) return false;
+    bool ok = fread(rec, sizeof(*rec), 1, f) == 1;
+    fclose(f);
+    return ok && rec->magic == REDEMPTION_STATE_MAGIC &&
+           rec->version == REDEMPTION_STATE_VERSION &&
+           rec->checksum == state_checksum(rec);
+}
+
+/* ============================================================================
+ * LOG INDEX ORDERING
+ * ============================================================================ */
+
+// Pull index entries added since the last call into the file-ordered array.
+// New entries are prepended to soc->log_index, so only the fresh prefix of
+// the list is walked.
+static void redemption_refresh(BlackBoxSoC* soc) {
+    RedemptionEngine* eng = &soc->redemption;
+    LogIndex* head = soc->log_index;
+    if (head == eng->snapshot_head) return;
+
+    uint32_t fresh = 0;
+    for (LogIndex* it = head; it && it != eng->snapshot_head; it = it->next) {
+        fresh++;
+    }
+
+    uint32_t needed = eng->ordered_count + fresh;
+    if (needed > eng->ordered_capacity) {
+        uint32_t cap = eng->ordered_capacity ? eng->ordered_capacity : 64;
+        while (cap < needed) cap *= 2;
+        LogIndex** grown = (LogIndex**)realloc(eng->ordered, cap * sizeof(LogIndex*));
+        if (!grown) return;
+        eng->ordered = grown;
+        eng->ordered_capacity = cap;
+    }
+
+    uint32_t pos = needed;
+    for (LogIndex* it = head; it && it != eng->snapshot_head; it = it->next) {
+        eng->ordered[--pos] = it;
+    }
+    eng->ordered_count = needed;
+    eng->snapshot_head = head;
+}
+
+// First block at or beyond the watermark (blocks are in offset order)
+static uint32_t redemption_find_resume_point(BlackBoxSoC* soc) {
+    RedemptionEngine* eng = &soc->redemption;
+    uint32_t lo = 0, hi = eng->ordered_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (eng->ordered[mid]->file_offset < soc->cloud_sync.last_sync_offset) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* ============================================================================
+ * ENGINE CONTROL
+ * ============================================================================ */
+
+void redemption_init(BlackBoxSoC* soc) {
+    memset(&soc->redemption, 0, sizeof(RedemptionEngine));
+    soc->redemption.tokens = REDEMPTION_BURST_BYTES;
+    soc->redemption.last_refill_ns = monotonic_ns();
+
+    RedemptionStateRecord rec;
+    if (redemption_load(&rec) && rec.last_sync_offset <= soc->nvme.bytes_written) {
+        soc->cloud_sync.last_sync_offset = rec.last_sync_offset;
+        soc->cloud_sync.last_sync_timestamp = rec.last_sync_timestamp;
+    } else {
+        // Stale or missing watermark (e.g. storage was truncated)
+        soc->cloud_sync.last_sync_offset = 0;
+        soc->cloud_sync.last_sync_timestamp = 0;
+        redemption_persist(soc);
+    }
+    soc->cloud_sync.backlog_bytes = soc->nvme.bytes_written - soc->cloud_sync.last_sync_offset;
+}
+
+void redemption_cleanup(BlackBoxSoC* soc) {
+    free(soc->redemption.ordered);
+    memset(&soc->redemption, 0, sizeof(RedemptionEngine));
+}
+
+static bool redemption_has_pending(BlackBoxSoC* soc) {
+    for (uint32_t i = 0; i < REDEMPTION_WINDOW; i++) {
+        if (soc->redemption.window[i].chunks_pending > 0) return true;
+    }
+    return false;
+}
+
+void redemption_start(BlackBoxSoC* soc) {
+    RedemptionEngine* eng = &soc->redemption;
+
+    // Let uploads from an aborted run settle before reusing their slots
+    while (redemption_has_pending(soc)) {
+        network_client_poll(100);
+        ethernet_reap_tx(soc);
+    }
+
+    redemption_refresh(soc);
+    eng->next_issue = redemption_find_resume_point(soc);
+    eng->window_head = 0;
+    eng->window_count = 0;
+    soc->cloud_sync.redemption_in_progress = true;
+}
+
+void redemption_abort(BlackBoxSoC* soc) {
+    // In-flight chunks still complete (and unmap) but their acks are ignored
+    soc->redemption.generation++;
+    soc->cloud_sync.redemption_in_progress = false;
+}
+
+bool redemption_is_drained(BlackBoxSoC* soc) {
+    return soc->cloud_sync.last_sync_offset >= soc->nvme.bytes_written;
+}
+
+void redemption_ack(BlackBoxSoC* soc, uint32_t slot, bool success) {
+    RedemptionEngine* eng = &soc->redemption;
+    uint32_t rel = (slot + REDEMPTION_WINDOW - eng->window_head) % REDEMPTION_WINDOW;
+    if (rel >= eng->window_count) return;
+
+    if (!success) {
+        // Link is down: drop the window, resume from the watermark later
+        eng->send_failures++;
+        redemption_abort(soc);
+        soc->cloud_sync.connected = false;
+        if (soc->cloud_sync.probing) {
+            // A retry that never got through was never announced either
+            soc->cloud_sync.probing = false;
+        } else {
+            add_event_marker(soc, "Backlog-Stalled", "{\"event\": \"cloud_send_failed\"}");
+        }
+        return;
+    }
+
+    cloud_sync_confirm(soc);
+    eng->window[slot].acked = true;
+
+    // Advance the watermark over the contiguous acknowledged prefix only
+    bool advanced = false;
+    while (eng->window_count > 0 && eng->window[eng->window_head].acked) {
+        RedemptionSlot* head = &eng->window[eng->window_head];
+        LogIndex* entry = head->entry;
+        soc->cloud_sync.last_sync_offset = entry->file_offset + entry->compressed_size;
+        soc->cloud_sync.last_sync_timestamp = entry->timestamp_end;
+        eng->blocks_redeemed++;
+        eng->bytes_redeemed += entry->compressed_size;
+        head->entry = NULL;
+        head->acked = false;
+        eng->window_head = (eng->window_head + 1) % REDEMPTION_WINDOW;
+        eng->window_count--;
+        advanced = true;
+    }
+
+    if (advanced) {
+        soc->cloud_sync.backlog_bytes = soc->nvme.bytes_written - soc->cloud_sync.last_sync_offset;
+        if (!redemption_persist(soc)) {
+            fprintf(stderr, "Redemption: Failed to persist watermark\n");
+        }
+    }
+}
+
+/* ============================================================================
+ * BLOCK UPLOAD
+ * ============================================================================ */
+
+static void redemption_chunk_done(BlackBoxSoC* soc, void* user, bool success) {
+    RedemptionEngine* eng = &soc->redemption;
+    RedemptionSlot* rs = (RedemptionSlot*)user;
+
+    if (!success) rs->failed = true;
+    if (--rs->chunks_pending > 0) return;
+
+    nvme_unmap_region(&rs->region);
+    if (rs->generation != eng->generation) {
+        rs->entry = NULL;    // Completed after an abort: discard
+        return;
+    }
+    redemption_ack(soc, (uint32_t)(rs - eng->window), !rs->failed);
+}
+
+// Map the block and queue all of its MAC-sized chunks without waiting
+static void redemption_issue(BlackBoxSoC* soc, RedemptionSlot* rs) {
+    rs->failed = false;
+    rs->acked = false;
+    rs->generation = soc->redemption.generation;
+
+    if (!nvme_map_region(soc, rs->entry->file_offset, rs->entry->compressed_size, &rs->region)) {
+        rs->chunks_pending = 1;
+        redemption_chunk_done(soc, rs, false);
+        return;
+    }
+    if (!rs->region.mapped) {
+        soc->eth_mac.bytes_copied += rs->region.length;
+    }
+
+    uint32_t length = rs->region.length;
+    uint32_t chunks = (length + ETH_TX_MAX_CHUNK - 1) / ETH_TX_MAX_CHUNK;
+
+    // Hold one extra reference so early completions cannot retire the slot
+    // before every chunk is queued
+    rs->chunks_pending = chunks + 1;
+    for (uint32_t sent = 0; sent < length; sent += ETH_TX_MAX_CHUNK) {
+        uint32_t chunk = length - sent;
+        if (chunk > ETH_TX_MAX_CHUNK) chunk = ETH_TX_MAX_CHUNK;
+        if (!ethernet_transmit_buffer_async(soc, rs->region.data + sent, chunk,
+                                            redemption_chunk_done, rs)) {
+            redemption_chunk_done(soc, rs, false);
+        }
+    }
+    redemption_chunk_done(soc, rs, true);
+}
+
+uint32_t redemption_pump(BlackBoxSoC* soc, uint32_t max_blocks) {
+    RedemptionEngine* eng = &soc->redemption;
+
+    // Retire whatever completed since the last tick. The transport only
+    // queues completions; acks, aborts and the watermark update run here.
+    network_client_poll(0);
+    ethernet_reap_tx(soc);
+
+    if (!soc->cloud_sync.redemption_in_progress || !soc->cloud_sync.connected) {
+        return 0;
+    }
+
+    redemption_refresh(soc);
+
+    // Refill the token bucket from wall-clock time
+    uint64_t now = monotonic_ns();
+    eng->tokens += (double)(now - eng->last_refill_ns) * REDEMPTION_RATE_BYTES_PER_SEC / 1e9;
+    if (eng->tokens > REDEMPTION_BURST_BYTES) eng->tokens = REDEMPTION_BURST_BYTES;
+    eng->last_refill_ns = now;
+
+    uint64_t retired_before = eng->blocks_redeemed;
+    uint32_t issued = 0;
+
+    while (issued < max_blocks &&
+           eng->window_count < REDEMPTION_WINDOW &&
+           eng->next_issue < eng->ordered_count &&
+           eng->tokens > 0 &&
+           soc->cloud_sync.redemption_in_progress) {
+        uint32_t slot = (eng->window_head + eng->window_count) % REDEMPTION_WINDOW;
+        RedemptionSlot* rs = &eng->window[slot];
+        if (rs->chunks_pending > 0) break;   // Still draining an aborted upload
+
+        rs->entry = eng->ordered[eng->next_issue++];
+        eng->window_count++;
+        eng->tokens -= rs->entry->compressed_size;
+        issued++;
+        redemption_issue(soc, rs);
+    }
+
+    if (soc->cloud_sync.redemption_in_progress && eng->window_count == 0 &&
+        redemption_is_drained(soc)) {
+        soc->cloud_sync.redemption_in_progress = false;
+        // Nothing went out on a retry: the link is still unconfirmed
+        if (!soc->cloud_sync.probing) {
+            add_event_marker(soc, "Backlog-Complete", "{\"event\": \"backlog_drained\"}");
+        }
+    }
+
+    return (uint32_t)(eng->blocks_redeemed - retired_before);
+}
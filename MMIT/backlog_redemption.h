@@ -0,0 +1,37 @@
+/*
+ * Backlog Redemption Engine - Header
+ * Drains NVMe log blocks newer than the cloud sync watermark
+ */
+
+#ifndef BACKLOG_REDEMPTION_H
+#define BACKLOG_REDEMPTION_H
+
+#include "blackbox_common.h"
+
+// Durable watermark (survives crashes and restarts)
+#define REDEMPTION_STATE_PATH   "cloud_sync.state"
+
+/* ============================================================================
+ * BACKLOG REDEMPTION FUNCTIONS
+ * ============================================================================ */
+
+// Load the persisted watermark into soc->cloud_sync (call after storage open)
+void redemption_init(BlackBoxSoC* soc);
+void redemption_cleanup(BlackBoxSoC* soc);
+
+// Begin/abort draining. Abort discards the in-flight window; the next start
+// resumes from the last acknowledged block.
+void redemption_start(BlackBoxSoC* soc);
+void redemption_abort(BlackBoxSoC* soc);
+
+// Retire completed uploads, then queue up to max_blocks more within the rate
+// budget and in-flight window. Call from idle slots of the live loop.
+// Returns blocks retired.
+uint32_t redemption_pump(BlackBoxSoC* soc, uint32_t max_blocks);
+
+// Acknowledge the block held in window[slot]
+void redemption_ack(BlackBoxSoC* soc, uint32_t slot, bool success);
+
+bool redemption_is_drained(BlackBoxSoC* soc);
+
+#endif // BACKLOG_REDEMPTION_H
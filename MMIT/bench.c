@@ -0,0 +1,1880 @@
+/*
+ * BlackBox DPU - Benchmarks Implementation
+ */
+
+#include <math.h>
+#include "bench.h"
+#include "telemetry_json.h"
+#include "telemetry_wire.h"
+#include "network_config.h"
+#include "realistic_drive_sim.h"
+#include "http_transport.h"
+#include "rate_scheduler.h"
+#include "drive_fleet.h"
+#include "sample_ring.h"
+#include "rpu_dsp.h"
+#include "sample_quant.h"
+#include "channel_registry.h"
+#include "core_runtime.h"
+#include "payload_codec.h"
+#include "history_rollup.h"
+
+/* ============================================================================
+ * BENCHMARK: TELEMETRY UPLOAD THROUGHPUT
+ * ============================================================================ */
+
+static double upload_packets(int count, uint32_t batch_packets, TelemetrySenderStats* stats,
+                             uint64_t* wire_bytes) {
+    TelemetrySenderStats before;
+    HttpTransportStats http_before, http_after;
+    telemetry_sender_get_stats(&before);
+    http_transport_get_stats(&http_before);
+    telemetry_sender_set_batching(batch_packets, TELEMETRY_BATCH_MAX_LATENCY_MS);
+    init_realistic_drive_simulation();
+
+    uint64_t start = monotonic_ns();
+    for (int i = 0; i < count; i++) {
+        MMITTelemetryPacket packet;
+        memset(&packet, 0, sizeof(packet));
+        snprintf(packet.vehicle_id, sizeof(packet.vehicle_id), "BENYON_001");
+        packet.timestamp_ns = telemetry_now_ns();
+        update_realistic_drive_simulation(&packet, 0.01);
+        telemetry_sender_enqueue(&packet);
+    }
+    telemetry_sender_flush();
+    double elapsed = (monotonic_ns() - start) / 1e9;
+
+    http_transport_get_stats(&http_after);
+    *wire_bytes = http_after.body_bytes_wire - http_before.body_bytes_wire;
+    telemetry_sender_get_stats(stats);
+    stats->packets_sent -= before.packets_sent;
+    stats->packets_failed -= before.packets_failed;
+    stats->requests -= before.requests;
+    stats->payload_bytes -= before.payload_bytes;
+    stats->packets_suppressed -= before.packets_suppressed;
+    stats->fields_offered -= before.fields_offered;
+    stats->fields_sent -= before.fields_sent;
+    // Samples handled: a suppressed sample is delivered by the backend's merge
+    uint64_t handled = stats->packets_sent + stats->packets_suppressed;
+    return elapsed > 0 ? handled / elapsed : 0.0;
+}
+
+/* ============================================================================
+ * BENCHMARK: HTTP VS WEBSOCKET PER-SAMPLE LATENCY
+ * ============================================================================ */
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void print_latency_row(const char* label, uint64_t* samples_ns, int count, double elapsed_s) {
+    if (count == 0) {
+        printf("%-24s %10s\n", label, "n/a");
+        return;
+    }
+    qsort(samples_ns, count, sizeof(uint64_t), compare_u64);
+    printf("%-24s %10.1f %10.1f %10.1f %10.1f %12.0f\n", label,
+           samples_ns[count / 2] / 1000.0,
+           samples_ns[(int)(count * 0.9)] / 1000.0,
+           samples_ns[(int)(count * 0.99)] / 1000.0,
+           samples_ns[count - 1] / 1000.0,
+           elapsed_s > 0 ? count / elapsed_s : 0.0);
+}
+
+static void make_bench_packet(MMITTelemetryPacket* packet) {
+    memset(packet, 0, sizeof(MMITTelemetryPacket));
+    snprintf(packet->vehicle_id, sizeof(packet->vehicle_id), "BENYON_001");
+    packet->timestamp_ns = telemetry_now_ns();
+    update_realistic_drive_simulation(packet, 0.01);
+}
+
+typedef struct {
+    bool received;
+} WsEchoState;
+
+static void ws_echo_received(void* user, WsOpcode opcode, const uint8_t* payload, size_t len) {
+    (void)opcode;
+    (void)payload;
+    (void)len;
+    ((WsEchoState*)user)->received = true;
+}
+
+static void run_ws_benchmark(BlackBoxSoC* soc, int count, TelemetryFormat format) {
+    (void)soc;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*      Benchmark: HTTP POST vs WebSocket Frame Latency     *\n");
+    printf("************************************************************\n");
+    printf("Backend: %s:%d, %d samples per transport, %s\n\n", BACKEND_API_HOST, BACKEND_API_PORT,
+           count, format == TELEMETRY_FORMAT_BINARY ? "binary" : "JSON");
+
+    uint64_t* http_ns = (uint64_t*)calloc(count, sizeof(uint64_t));
+    uint64_t* ws_ns = (uint64_t*)calloc(count, sizeof(uint64_t));
+    uint64_t* echo_ns = (uint64_t*)calloc(count, sizeof(uint64_t));
+    if (!http_ns || !ws_ns || !echo_ns) {
+        free(http_ns);
+        free(ws_ns);
+        free(echo_ns);
+        return;
+    }
+    init_realistic_drive_simulation();
+    telemetry_sender_init(BACKEND_API_HOST, BACKEND_API_PORT);
+    telemetry_sender_set_format(format);
+
+    // HTTP: a sample is done when the POST round trip completes
+    telemetry_sender_set_transport(TELEMETRY_TRANSPORT_HTTP);
+    int http_ok = 0;
+    uint64_t start = monotonic_ns();
+    for (int i = 0; i < count; i++) {
+        MMITTelemetryPacket packet;
+        make_bench_packet(&packet);
+        uint64_t t0 = monotonic_ns();
+        if (telemetry_send_to_backend(&packet)) http_ns[http_ok++] = monotonic_ns() - t0;
+    }
+    double http_s = (monotonic_ns() - start) / 1e9;
+
+    // WebSocket: a sample is done once its frame is handed to the socket
+    telemetry_sender_set_transport(TELEMETRY_TRANSPORT_WEBSOCKET);
+    int ws_ok = 0;
+    start = monotonic_ns();
+    for (int i = 0; i < count; i++) {
+        MMITTelemetryPacket packet;
+        make_bench_packet(&packet);
+        uint64_t t0 = monotonic_ns();
+        if (telemetry_send_to_backend(&packet)) ws_ns[ws_ok++] = monotonic_ns() - t0;
+        telemetry_sender_poll();
+    }
+    double ws_s = (monotonic_ns() - start) / 1e9;
+    telemetry_sender_cleanup();
+
+    // Echo: time until the backend's broadcast of our own frame comes back
+    WsClient ws;
+    WsEchoState echo = {false};
+    int echo_ok = 0;
+    double echo_s = 0.0;
+    if (ws_client_init(&ws, BACKEND_API_HOST, BACKEND_API_PORT, "/ws/telemetry/BENYON_001") &&
+        ws_client_connect(&ws)) {
+        ws.on_message = ws_echo_received;
+        ws.user = &echo;
+        char payload[TELEMETRY_JSON_MAX];
+        start = monotonic_ns();
+        for (int i = 0; i < count; i++) {
+            MMITTelemetryPacket packet;
+            make_bench_packet(&packet);
+            size_t len = format == TELEMETRY_FORMAT_BINARY
+                ? telemetry_wire_encode((uint8_t*)payload, sizeof(payload), &packet)
+                : telemetry_json_write(payload, sizeof(payload), &packet);
+            echo.received = false;
+            uint64_t t0 = monotonic_ns();
+            if (!ws_client_send(&ws, format == TELEMETRY_FORMAT_BINARY ? WS_OP_BINARY : WS_OP_TEXT,
+                                payload, len)) {
+                break;
+            }
+            uint64_t deadline = t0 + 1000000000ULL;
+            while (!echo.received && ws.connected && monotonic_ns() < deadline) {
+                ws_client_poll(&ws, 100);
+            }
+            if (!echo.received) break;
+            echo_ns[echo_ok++] = monotonic_ns() - t0;
+        }
+        echo_s = (monotonic_ns() - start) / 1e9;
+    }
+    ws_client_free(&ws);
+
+    printf("%-24s %10s %10s %10s %10s %12s\n", "Per-sample latency (us)", "p50", "p90", "p99", "max",
+           "samples/s");
+    printf("------------------------------------------------------------------------------\n");
+    print_latency_row("HTTP POST round trip", http_ns, http_ok, http_s);
+    print_latency_row("WebSocket frame send", ws_ns, ws_ok, ws_s);
+    print_latency_row("WebSocket echo (RTT)", echo_ns, echo_ok, echo_s);
+    if (ws_ok == 0) {
+        printf("\nWebSocket endpoint unavailable at ws://%s:%d/ws/telemetry/\n",
+               BACKEND_API_HOST, BACKEND_API_PORT);
+    }
+
+    free(http_ns);
+    free(ws_ns);
+    free(echo_ns);
+}
+
+static void run_upload_benchmark(BlackBoxSoC* soc, int count, TelemetryFormat format) {
+    (void)soc;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: Telemetry Upload Throughput           *\n");
+    printf("************************************************************\n");
+    printf("Backend: http://%s:%d, %d packets per run, %s, gzip %s\n\n", BACKEND_API_HOST,
+           BACKEND_API_PORT, count, format == TELEMETRY_FORMAT_BINARY ? "binary" : "JSON",
+           http_transport_get_compression() ? "on" : "off");
+
+    const uint32_t batch_sizes[] = {1, 10, 50, 100};
+    double baseline = 0.0;
+    bool deadband = telemetry_sender_get_deadband();
+    telemetry_sender_init(BACKEND_API_HOST, BACKEND_API_PORT);
+    telemetry_sender_set_format(format);
+    telemetry_sender_set_deadband(false);
+
+    printf("%-8s %-10s %-11s %-13s %-9s %-11s %s\n", "Batch", "Requests", "Delivered",
+           "Packets/sec", "Speedup", "Bytes/pkt", "Wire/pkt");
+    printf("-------------------------------------------------------------------------------\n");
+    for (int i = 0; i < 4; i++) {
+        TelemetrySenderStats stats;
+        uint64_t wire_bytes = 0;
+        double pps = upload_packets(count, batch_sizes[i], &stats, &wire_bytes);
+        if (i == 0) baseline = pps;
+        printf("%-8u %-10lu %-11lu %-13.0f %-9.1f %-11.1f %.1f\n", batch_sizes[i], stats.requests,
+               stats.packets_sent, pps, baseline > 0 ? pps / baseline : 0.0,
+               count > 0 ? (double)stats.payload_bytes / count : 0.0,
+               count > 0 ? (double)wire_bytes / count : 0.0);
+    }
+
+    if (deadband) {
+        // Same stream with send-on-change deltas
+        TelemetrySenderStats stats;
+        uint64_t wire_bytes = 0;
+        char label[32];
+        snprintf(label, sizeof(label), "%d+db", TELEMETRY_BATCH_MAX_PACKETS);
+        telemetry_sender_set_deadband(true);
+        double pps = upload_packets(count, TELEMETRY_BATCH_MAX_PACKETS, &stats, &wire_bytes);
+        printf("%-8s %-10lu %-11lu %-13.0f %-9.1f %-11.1f %.1f\n", label, stats.requests,
+               stats.packets_sent, pps, baseline > 0 ? pps / baseline : 0.0,
+               count > 0 ? (double)stats.payload_bytes / count : 0.0,
+               count > 0 ? (double)wire_bytes / count : 0.0);
+        printf("\nDeadband: %lu / %lu fields sent (%.1f%%), %lu of %d samples suppressed\n",
+               stats.fields_sent, stats.fields_offered,
+               stats.fields_offered ? 100.0 * stats.fields_sent / stats.fields_offered : 0.0,
+               stats.packets_suppressed, count);
+    }
+    telemetry_sender_cleanup();
+}
+
+/* ============================================================================
+ * BENCHMARK: JSON SERIALIZATION
+ * ============================================================================ */
+
+// Overwrite some fields with values that stress rounding and sign handling
+static void apply_json_edge_cases(MMITTelemetryPacket* packet, int i) {
+    static const float edge_values[] = {
+        0.0f, -0.0f, 0.005f, 0.015f, 0.125f, 0.375f, 2.675f, -1.005f, -0.001f,
+        99.995f, 1e-7f, 123456.789f, -98765.4321f, 3.4e38f, 1e16f, 16777216.5f
+    };
+    const int n = (int)(sizeof(edge_values) / sizeof(edge_values[0]));
+    packet->throttle_pct = edge_values[i % n];
+    packet->brake_pct = edge_values[(i * 7) % n];
+    packet->gps_lat = edge_values[(i * 3) % n];
+    packet->gps_lon = -edge_values[(i * 5) % n];
+    packet->gear = (i % 9) - 1;
+    if (i % 97 == 0) packet->rpm = NAN;
+    if (i % 89 == 0) packet->humidity_pct = -INFINITY;
+}
+
+static void run_json_benchmark(BlackBoxSoC* soc, int count, TelemetryFormat format) {
+    (void)soc;
+    (void)format;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: Telemetry JSON Serialization          *\n");
+    printf("************************************************************\n");
+
+    MMITTelemetryPacket* packets = (MMITTelemetryPacket*)calloc(count, sizeof(MMITTelemetryPacket));
+    if (!packets) return;
+
+    // Realistic drive samples, every fourth with edge-case values
+    init_realistic_drive_simulation();
+    uint64_t ts = telemetry_now_ns();
+    for (int i = 0; i < count; i++) {
+        snprintf(packets[i].vehicle_id, sizeof(packets[i].vehicle_id), "BENYON_%03d", i % 1000);
+        packets[i].timestamp_ns = ts + (uint64_t)i * 1000000ULL;
+        update_realistic_drive_simulation(&packets[i], 0.1);
+        packets[i].cpu_usage_pct = 45.0f + (i % 10) * 2.0f;
+        packets[i].ram_usage_pct = 62.0f + (i % 5) * 1.5f;
+        packets[i].network_latency_ms = 5.0f + (i % 3) * 0.5f;
+        packets[i].abs_active = (i % 2) == 0;
+        packets[i].traction_control = (i % 3) == 0;
+        if (i % 4 == 0) apply_json_edge_cases(&packets[i], i);
+    }
+
+    // Byte-identical output check
+    char fast[TELEMETRY_JSON_MAX];
+    char ref[TELEMETRY_JSON_MAX];
+    int mismatches = 0;
+    for (int i = 0; i < count; i++) {
+        size_t a = telemetry_json_write(fast, sizeof(fast), &packets[i]);
+        size_t b = telemetry_json_write_reference(ref, sizeof(ref), &packets[i]);
+        if (a != b || memcmp(fast, ref, a) != 0) {
+            if (mismatches++ < 3) {
+                printf("  MISMATCH packet %d:\n    fast: %s\n    ref:  %s\n", i, fast, ref);
+            }
+        }
+    }
+    printf("Output check: %d packets, %d mismatches\n\n", count, mismatches);
+
+    // Timing (checksum keeps the work observable)
+    const int rounds = 5;
+    size_t checksum = 0;
+    uint64_t start = monotonic_ns();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < count; i++) {
+            checksum += telemetry_json_write_reference(ref, sizeof(ref), &packets[i]);
+        }
+    }
+    double ref_ns = (double)(monotonic_ns() - start) / ((double)count * rounds);
+
+    start = monotonic_ns();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < count; i++) {
+            checksum += telemetry_json_write(fast, sizeof(fast), &packets[i]);
+        }
+    }
+    double fast_ns = (double)(monotonic_ns() - start) / ((double)count * rounds);
+
+    // Binary wire format: round-trip check, then timing
+    uint8_t wire[TELEMETRY_WIRE_MAX];
+    size_t json_bytes = 0;
+    size_t wire_bytes = 0;
+    int wire_errors = 0;
+    for (int i = 0; i < count; i++) {
+        MMITTelemetryPacket decoded;
+        size_t n = telemetry_wire_encode(wire, sizeof(wire), &packets[i]);
+        if (n == 0 || telemetry_wire_decode(wire, n, &decoded) != n ||
+            memcmp(&decoded.timestamp_ns, &packets[i].timestamp_ns, sizeof(uint64_t)) != 0 ||
+            telemetry_json_write(fast, sizeof(fast), &decoded) !=
+                telemetry_json_write(ref, sizeof(ref), &packets[i]) ||
+            strcmp(fast, ref) != 0) {
+            wire_errors++;
+        }
+        wire_bytes += n;
+        json_bytes += strlen(ref);
+    }
+    printf("Wire round-trip: %d packets, %d errors\n\n", count, wire_errors);
+
+    start = monotonic_ns();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < count; i++) {
+            checksum += telemetry_wire_encode(wire, sizeof(wire), &packets[i]);
+        }
+    }
+    double wire_ns = (double)(monotonic_ns() - start) / ((double)count * rounds);
+
+    printf("%-22s %12s %12s\n", "Serializer", "ns/packet", "bytes/packet");
+    printf("--------------------------------------------------\n");
+    printf("%-22s %12.1f %12.1f\n", "snprintf (reference)", ref_ns, (double)json_bytes / count);
+    printf("%-22s %12.1f %12.1f\n", "telemetry_json_write", fast_ns, (double)json_bytes / count);
+    printf("%-22s %12.1f %12.1f\n", "telemetry_wire_encode", wire_ns, (double)wire_bytes / count);
+    printf("Speedup: %.1fx (checksum %zu)\n", fast_ns > 0 ? ref_ns / fast_ns : 0.0, checksum);
+
+    free(packets);
+}
+
+// Lane-by-lane equality of two fleets' readings and state
+static bool drive_fleet_lanes_equal(const DriveFleet* a, uint32_t a_first,
+                                    const DriveFleet* b, uint32_t b_first, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        MMITTelemetryPacket pa, pb;
+        memset(&pa, 0, sizeof(pa));
+        memset(&pb, 0, sizeof(pb));
+        drive_fleet_packet(a, a_first + i, &pa);
+        drive_fleet_packet(b, b_first + i, &pb);
+        if (memcmp(&pa, &pb, sizeof(pa)) != 0 ||
+            a->rng0[a_first + i] != b->rng0[b_first + i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void run_drive_benchmark(BlackBoxSoC* soc, int vehicles, TelemetryFormat format) {
+    (void)soc;
+    (void)format;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: Drive Simulation Kernel               *\n");
+    printf("************************************************************\n");
+
+    const int steps = 100;
+    const double dt = 1.0;
+    uint64_t seed = 12345;
+
+    // Determinism: same seed twice, and the fleet split into two shards
+    DriveFleet a, b, lo, hi;
+    uint32_t half = (uint32_t)vehicles / 2;
+    if (half == 0 || !drive_fleet_init(&a, vehicles, seed) || !drive_fleet_init(&b, vehicles, seed) ||
+        !drive_fleet_init(&lo, half, seed) || !drive_fleet_init(&hi, vehicles - half, seed + half)) {
+        printf("Could not allocate %d vehicles\n", vehicles);
+        return;
+    }
+    for (int s = 0; s < steps; s++) {
+        drive_fleet_step(&a, dt);
+        drive_fleet_step(&b, dt);
+        drive_fleet_step(&lo, dt);
+        drive_fleet_step(&hi, dt);
+    }
+    bool repeat_ok = drive_fleet_lanes_equal(&a, 0, &b, 0, vehicles);
+    bool shard_ok = drive_fleet_lanes_equal(&a, 0, &lo, 0, half) &&
+                    drive_fleet_lanes_equal(&a, half, &hi, 0, vehicles - half);
+    printf("Determinism: repeat %s, sharded %s (%d vehicles, %d steps)\n\n",
+           repeat_ok ? "identical" : "DIFFERS", shard_ok ? "identical" : "DIFFERS", vehicles, steps);
+    drive_fleet_free(&b);
+    drive_fleet_free(&lo);
+    drive_fleet_free(&hi);
+
+    // Scalar model, one DriveState per vehicle
+    DriveState* states = (DriveState*)malloc((size_t)vehicles * sizeof(DriveState));
+    MMITTelemetryPacket packet;
+    double checksum = 0.0;
+    if (!states) {
+        drive_fleet_free(&a);
+        return;
+    }
+    for (int i = 0; i < vehicles; i++) drive_sim_init(&states[i], seed + i);
+    uint64_t start = monotonic_ns();
+    for (int s = 0; s < steps; s++) {
+        for (int i = 0; i < vehicles; i++) {
+            drive_sim_update(&states[i], &packet, dt);
+            checksum += packet.speed_kph;
+        }
+    }
+    double scalar_ns = (double)(monotonic_ns() - start) / ((double)vehicles * steps);
+    free(states);
+
+    // SoA kernel, state only, then with every packet filled
+    start = monotonic_ns();
+    for (int s = 0; s < steps; s++) {
+        drive_fleet_step(&a, dt);
+        checksum += a.out_speed_kph[s % vehicles];
+    }
+    double soa_ns = (double)(monotonic_ns() - start) / ((double)vehicles * steps);
+
+    start = monotonic_ns();
+    for (int s = 0; s < steps; s++) {
+        drive_fleet_step(&a, dt);
+        for (int i = 0; i < vehicles; i++) {
+            drive_fleet_packet(&a, i, &packet);
+            checksum += packet.speed_kph;
+        }
+    }
+    double soa_packet_ns = (double)(monotonic_ns() - start) / ((double)vehicles * steps);
+    drive_fleet_free(&a);
+
+    printf("%-26s %14s %18s\n", "Kernel", "ns/vehicle", "vehicles/core@1Hz");
+    printf("--------------------------------------------------------------\n");
+    printf("%-26s %14.1f %18.0f\n", "drive_sim_update (scalar)", scalar_ns, 1e9 / scalar_ns);
+    printf("%-26s %14.1f %18.0f\n", "drive_fleet_step (SoA)", soa_ns, 1e9 / soa_ns);
+    printf("%-26s %14.1f %18.0f\n", "  + drive_fleet_packet", soa_packet_ns, 1e9 / soa_packet_ns);
+    printf("Speedup: %.1fx (checksum %.0f)\n", soa_ns > 0 ? scalar_ns / soa_ns : 0.0, checksum);
+}
+
+// Read back the newest logged block and check it is channel's sample block
+// ending at last_ts
+static bool sample_block_verify(BlackBoxSoC* soc, uint32_t channel, uint64_t last_ts) {
+    const LogIndex* e = soc->log_index;
+    NVMeRegion region;
+    if (!e || !nvme_map_region(soc, e->file_offset, e->compressed_size, &region)) return false;
+    uint8_t* raw = (uint8_t*)malloc(e->uncompressed_size);
+    uint32_t n = raw ? simple_decompress(region.data, region.length, raw, e->uncompressed_size) : 0;
+    nvme_unmap_region(&region);
+
+    bool ok = false;
+    uint32_t id, count;
+    uint64_t ts;
+    if (n == e->uncompressed_size && n >= SAMPLE_BLOCK_HEADER_SIZE &&
+        raw[0] == SAMPLE_BLOCK_MAGIC0 && raw[1] == SAMPLE_BLOCK_MAGIC1) {
+        memcpy(&id, raw + 4, sizeof(id));
+        memcpy(&count, raw + 8, sizeof(count));
+        if (count > 0 && n == SAMPLE_BLOCK_HEADER_SIZE + count * SAMPLE_BLOCK_BYTES_PER_SAMPLE) {
+            memcpy(&ts, raw + SAMPLE_BLOCK_HEADER_SIZE + (size_t)(count - 1) * sizeof(uint64_t),
+                   sizeof(ts));
+            ok = id == channel && ts == last_ts && e->timestamp_end == last_ts;
+        }
+    }
+    free(raw);
+    return ok;
+}
+
+// Bulk ingest into every channel's sample ring, drained through the
+// logging pipeline whenever a ring is half full
+static void run_sample_benchmark(BlackBoxSoC* soc, int samples_per_channel, TelemetryFormat format) {
+    (void)format;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: Channel Sample Ingest                 *\n");
+    printf("************************************************************\n");
+
+    enum { CHUNK = 256 };
+    uint32_t channels = soc->channels.count;
+    uint64_t ts[CHUNK];
+    float values[CHUNK];
+    uint64_t pushed = 0, dropped = 0, logged = 0;
+    uint64_t push_ns = 0;
+    const SensorChannel* ch0 = channel_registry_at(&soc->channels, 0);
+    uint64_t period_ns = 1000000000ULL / ch0->sample_rate;
+
+    printf("Channels: %u, %d samples each, %lu-sample rings, %d per push\n\n", channels,
+           samples_per_channel, ch0->samples ? ch0->samples->capacity : 0, CHUNK);
+
+    uint64_t start = monotonic_ns();
+    for (int done = 0; done < samples_per_channel; done += CHUNK) {
+        uint32_t n = samples_per_channel - done < CHUNK ? samples_per_channel - done : CHUNK;
+        bool drain = false;
+        for (uint32_t c = 0; c < channels; c++) {
+            SensorChannel* ch = channel_registry_at(&soc->channels, c);
+            for (uint32_t k = 0; k < n; k++) {
+                ts[k] = (uint64_t)(done + k) * period_ns;
+                values[k] = (float)c + 0.001f * (float)((done + k) % 1000);
+            }
+            uint64_t t0 = monotonic_ns();
+            uint32_t accepted = sensor_channel_push_samples(ch, ts, values, n);
+            push_ns += monotonic_ns() - t0;
+            pushed += accepted;
+            dropped += n - accepted;
+            if (ch->samples && sample_ring_depth(ch->samples) * 2 >= ch->samples->capacity) {
+                drain = true;
+            }
+        }
+        if (drain) logged += sensor_channels_drain(soc);
+    }
+    logged += sensor_channels_drain(soc);
+    double wall_s = (monotonic_ns() - start) / 1e9;
+
+    uint64_t last_ts = (uint64_t)(samples_per_channel - 1) * period_ns;
+    bool verify_ok = samples_per_channel > 0 && sample_block_verify(soc, channels - 1, last_ts);
+
+    printf("Pushed:     %lu samples, %lu dropped, %lu logged (%s)\n", pushed, dropped, logged,
+           logged == pushed ? "all" : "MISSING");
+    printf("Read-back:  newest block %s\n", verify_ok ? "matches" : "DIFFERS");
+    printf("Ingest:     %.1f ns/sample push, %.1f M samples/s\n",
+           pushed > 0 ? (double)push_ns / pushed : 0.0, push_ns > 0 ? pushed * 1e3 / push_ns : 0.0);
+    printf("End to end: %.1f M samples/s through Zstd -> DMA -> NVMe (%.2f s)\n",
+           wall_s > 0 ? pushed / wall_s / 1e6 : 0.0, wall_s);
+}
+
+// Synthetic fault classes for the health benchmark, one per channel in turn
+enum { HEALTH_OK, HEALTH_STUCK, HEALTH_SPIKES, HEALTH_DROPOUT, HEALTH_NOISY, HEALTH_DEAD,
+       HEALTH_CLASSES };
+static const char* const health_class_names[HEALTH_CLASSES] = {
+    "healthy", "stuck", "out-of-bounds spikes", "50% dropout", "noisy", "stuck out of range"
+};
+
+// Fill one tick of a channel's samples; returns how many it delivered
+static uint32_t make_health_samples(int cls, uint32_t channel, uint64_t tick, uint32_t due,
+                                    uint64_t t0_ns, uint64_t period_ns, uint64_t* ts, float* values) {
+    uint32_t n = cls == HEALTH_DROPOUT ? due / 2 : due;
+    for (uint32_t k = 0; k < n; k++) {
+        uint64_t i = tick * due + k;
+        uint32_t h = (uint32_t)((i + channel) * 2654435761u);
+        float noise = (float)(h >> 8) / 16777216.0f - 0.5f;
+        ts[k] = t0_ns + i * period_ns;
+        switch (cls) {
+            case HEALTH_STUCK: values[k] = 42.0f; break;
+            case HEALTH_SPIKES: values[k] = k == 0 ? 5000.0f : 20.0f + noise; break;
+            case HEALTH_NOISY: values[k] = 20.0f + 1000.0f * noise; break;
+            case HEALTH_DEAD: values[k] = 9999.0f; break;
+            default: values[k] = 20.0f + noise; break;
+        }
+    }
+    return n;
+}
+
+// Health of every channel per tick, batched kernel vs the per-sample scalar
+// monitor over the same samples
+static void run_health_benchmark(BlackBoxSoC* soc, int channels, TelemetryFormat format) {
+    (void)format;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: Batched Sensor Health                 *\n");
+    printf("************************************************************\n");
+
+    const uint32_t rate_hz = 1000;
+    const uint64_t tick_ns = 10000000ULL;     // 10 ms: 10 samples per channel
+    const uint32_t ticks = 1000;
+    const uint32_t due = (uint32_t)(rate_hz * tick_ns / 1000000000ULL);
+    const uint64_t period_ns = 1000000000ULL / rate_hz;
+
+    while (soc->channels.count < (uint32_t)channels) {
+        uint32_t before = soc->channels.count;
+        sensor_channel_add(soc, "Bench");
+        if (soc->channels.count == before) break;
+    }
+    uint32_t count = soc->channels.count;
+    for (uint32_t c = 0; c < count; c++) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, c);
+        sensor_channel_set_state(ch, CHANNEL_ON, 0);
+        sensor_channel_set_sample_rate(ch, rate_hz);
+    }
+
+    // The scalar monitor runs on copies so both see identical input
+    SensorChannel* scalar = (SensorChannel*)malloc(count * sizeof(SensorChannel));
+    uint64_t* tick_cost = (uint64_t*)malloc(ticks * sizeof(uint64_t));
+    uint64_t* ts = (uint64_t*)malloc(due * sizeof(uint64_t));
+    float* values = (float*)malloc(due * sizeof(float));
+    if (!scalar || !tick_cost || !ts || !values) {
+        free(scalar);
+        free(tick_cost);
+        free(ts);
+        free(values);
+        return;
+    }
+    for (uint32_t c = 0; c < count; c++) scalar[c] = *channel_registry_at(&soc->channels, c);
+    printf("Channels: %u at %u Hz, %.0f ms ticks (%u samples each), %u ticks\n\n",
+           count, rate_hz, tick_ns / 1e6, due, ticks);
+
+    uint64_t scalar_ns = 0;
+    for (uint32_t t = 0; t < ticks; t++) {
+        for (uint32_t c = 0; c < count; c++) {
+            uint32_t n = make_health_samples(c % HEALTH_CLASSES, c, t, due, 0, period_ns, ts, values);
+            sensor_channel_push_samples(channel_registry_at(&soc->channels, c), ts, values, n);
+            uint64_t s0 = monotonic_ns();
+            for (uint32_t k = 0; k < n; k++) {
+                rpu_monitor_sensor_health(&soc->rpu, &scalar[c], values[k]);
+            }
+            scalar_ns += monotonic_ns() - s0;
+        }
+
+        uint64_t start = monotonic_ns();
+        rpu_monitor_channels(soc, tick_ns, (t + 1) * tick_ns);
+        tick_cost[t] = monotonic_ns() - start;
+
+        // Stand-in for the logging drain
+        for (uint32_t c = 0; c < count; c++) {
+            SampleRing* ring = channel_registry_at(&soc->channels, c)->samples;
+            while (sample_ring_pop(ring, ts, values, due) > 0) {
+            }
+        }
+    }
+
+    double mean_ns = 0.0;
+    for (uint32_t t = 0; t < ticks; t++) mean_ns += tick_cost[t];
+    mean_ns /= ticks;
+    qsort(tick_cost, ticks, sizeof(uint64_t), compare_u64);
+
+    printf("%-22s %10s %10s %14s\n", "Class", "Channels", "Health", "Frozen");
+    printf("--------------------------------------------------------------\n");
+    for (int cls = 0; cls < HEALTH_CLASSES; cls++) {
+        uint32_t members = 0, frozen = 0;
+        double health = 0.0;
+        for (uint32_t c = cls; c < count; c += HEALTH_CLASSES) {
+            members++;
+            const SensorChannel* ch = channel_registry_at(&soc->channels, c);
+            health += ch->health_score;
+            if (ch->state == CHANNEL_FROZEN) frozen++;
+        }
+        if (members == 0) continue;
+        printf("%-22s %10u %9.0f%% %14u\n", health_class_names[cls], members,
+               100.0 * health / members, frozen);
+    }
+    printf("\n");
+    printf("Batched kernel: mean %.2f us, p50 %.2f us, p99 %.2f us per tick (%.1f ns/channel)\n",
+           mean_ns / 1e3, tick_cost[ticks / 2] / 1e3, tick_cost[(ticks * 99) / 100] / 1e3,
+           mean_ns / count);
+    printf("Scalar monitor: %.2f us per tick (one call per sample)\n",
+           (double)scalar_ns / ticks / 1e3);
+
+    free(scalar);
+    free(tick_cost);
+    free(ts);
+    free(values);
+}
+
+// 1 Hz sine around 20 with white noise and a rare spike, as a raw sensor
+static float dsp_bench_signal(uint64_t i, uint32_t channel) {
+    uint32_t h = (uint32_t)((i + channel * 7919u) * 2654435761u);
+    float noise = (float)(h >> 8) / 16777216.0f - 0.5f;
+    float spike = (i % 5000 == 4999) ? 3000.0f : 0.0f;
+    return 20.0f + 10.0f * sinf((float)(i % 1000) * 0.0062831853f) + 4.0f * noise + spike;
+}
+
+// Log the same samples through every channel with the RPU chain off, then
+// on; returns NVMe bytes written
+static uint64_t dsp_bench_log(BlackBoxSoC* soc, int samples_per_channel, uint64_t* logged) {
+    enum { CHUNK = 256 };
+    uint64_t ts[CHUNK];
+    float values[CHUNK];
+    uint64_t before = soc->nvme.bytes_written;
+    uint64_t period_ns = 1000000000ULL / channel_registry_at(&soc->channels, 0)->sample_rate;
+
+    *logged = 0;
+    for (int done = 0; done < samples_per_channel; done += CHUNK) {
+        uint32_t n = samples_per_channel - done < CHUNK ? samples_per_channel - done : CHUNK;
+        bool drain = false;
+        for (uint32_t c = 0; c < soc->channels.count; c++) {
+            SensorChannel* ch = channel_registry_at(&soc->channels, c);
+            for (uint32_t k = 0; k < n; k++) {
+                ts[k] = (uint64_t)(done + k) * period_ns;
+                values[k] = dsp_bench_signal(done + k, c);
+            }
+            sensor_channel_push_samples(ch, ts, values, n);
+            if (sample_ring_depth(ch->samples) * 2 >= ch->samples->capacity) drain = true;
+        }
+        if (drain) *logged += sensor_channels_drain(soc);
+    }
+    *logged += sensor_channels_drain(soc);
+    return soc->nvme.bytes_written - before;
+}
+
+static void run_dsp_benchmark(BlackBoxSoC* soc, int samples_per_channel, TelemetryFormat format) {
+    (void)format;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: RPU DSP Plugin Chain                  *\n");
+    printf("************************************************************\n");
+
+    const uint32_t decimation = 10;
+    RpuDspConfig config;
+    rpu_dsp_config_defaults(&config);
+    config.decimation = decimation;
+    config.offset = 20.0f;       // Centre the signal...
+    config.scale = 0.1f;         // ...on +-1
+    config.threshold = 2.0f;     // Squash spikes 4:1 past +-2
+
+    for (uint32_t c = 0; c < soc->channels.count; c++) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, c);
+        sensor_channel_set_state(ch, CHANNEL_ON, 0);
+        sensor_channel_set_sample_rate(ch, 1000);
+        if (ch->dsp) rpu_dsp_configure(ch->dsp, &config);
+    }
+    printf("Channels: %u at 1000 Hz, %d samples each\n", soc->channels.count, samples_per_channel);
+    const RpuDspChain* dsp0 = channel_registry_at(&soc->channels, 0)->dsp;
+    printf("Chain: FIR low-pass (%d taps, cutoff %.3f fs), decimate 1:%u, normalize, 4:1 above 2\n\n",
+           RPU_DSP_FIR_TAPS, dsp0 ? dsp0->config.cutoff : 0.0f, decimation);
+
+    uint64_t raw_logged, dsp_logged;
+    soc->rpu.filter_enabled = soc->rpu.normalize_enabled = soc->rpu.compress_dynamics = false;
+    uint64_t raw_bytes = dsp_bench_log(soc, samples_per_channel, &raw_logged);
+    soc->rpu.filter_enabled = soc->rpu.normalize_enabled = soc->rpu.compress_dynamics = true;
+    uint64_t dsp_bytes = dsp_bench_log(soc, samples_per_channel, &dsp_logged);
+
+    printf("%-16s %14s %16s\n", "Chain", "Samples logged", "NVMe bytes");
+    printf("--------------------------------------------------------------\n");
+    printf("%-16s %14lu %16lu\n", "off", raw_logged, raw_bytes);
+    printf("%-16s %14lu %16lu\n", "on", dsp_logged, dsp_bytes);
+    printf("Log size: %.1fx smaller\n\n", dsp_bytes > 0 ? (double)raw_bytes / dsp_bytes : 0.0);
+
+    // Per-sample cost of each stage on one long block
+    enum { N = 1 << 16 };
+    float* block = (float*)malloc(N * sizeof(float));
+    RpuDspChain* chain = (RpuDspChain*)malloc(sizeof(RpuDspChain));
+    if (!block || !chain) {
+        free(block);
+        free(chain);
+        return;
+    }
+    static const struct {
+        const char* name;
+        RpuDspLowpass lowpass;
+        uint32_t decimation;
+        bool filter, normalize, compress;
+    } stages[] = {
+        {"FIR low-pass", RPU_DSP_LOWPASS_FIR, 1, true, false, false},
+        {"IIR low-pass", RPU_DSP_LOWPASS_IIR, 1, true, false, false},
+        {"FIR + 1:10", RPU_DSP_LOWPASS_FIR, 10, true, false, false},
+        {"normalize", RPU_DSP_LOWPASS_FIR, 1, false, true, false},
+        {"dynamics", RPU_DSP_LOWPASS_FIR, 1, false, false, true},
+        {"full chain", RPU_DSP_LOWPASS_FIR, 10, true, true, true},
+    };
+    RPUCore rpu = soc->rpu;
+    printf("%-16s %14s\n", "Stage", "ns/sample");
+    printf("--------------------------------------------------------------\n");
+    for (size_t s = 0; s < sizeof(stages) / sizeof(stages[0]); s++) {
+        config.lowpass = stages[s].lowpass;
+        config.decimation = stages[s].decimation;
+        rpu_dsp_configure(chain, &config);
+        rpu.filter_enabled = stages[s].filter;
+        rpu.normalize_enabled = stages[s].normalize;
+        rpu.compress_dynamics = stages[s].compress;
+
+        const int reps = 20;
+        uint64_t elapsed = 0;
+        for (int r = 0; r < reps; r++) {
+            for (uint32_t i = 0; i < N; i++) block[i] = dsp_bench_signal(i, 0);
+            uint64_t start = monotonic_ns();
+            rpu_dsp_process(chain, &rpu, NULL, block, N);
+            elapsed += monotonic_ns() - start;
+        }
+        printf("%-16s %14.2f\n", stages[s].name, (double)elapsed / ((double)reps * N));
+    }
+    free(block);
+    free(chain);
+}
+
+// Read back the newest logged block and check it decodes to the last
+// samples dsp_bench_log gave channel, each within half a step
+static bool quant_block_verify(BlackBoxSoC* soc, uint32_t channel, int samples_per_channel) {
+    const LogIndex* e = soc->log_index;
+    NVMeRegion region;
+    if (!e || !nvme_map_region(soc, e->file_offset, e->compressed_size, &region)) return false;
+    uint8_t* raw = (uint8_t*)malloc(e->uncompressed_size);
+    uint32_t n = raw ? simple_decompress(region.data, region.length, raw, e->uncompressed_size) : 0;
+    nvme_unmap_region(&region);
+
+    uint32_t max = n > 0 ? n : 1;
+    uint64_t* ts = (uint64_t*)malloc(max * sizeof(uint64_t));
+    float* values = (float*)malloc(max * sizeof(float));
+    uint32_t count = 0;
+    if (n == e->uncompressed_size && ts && values) {
+        count = sample_quant_decode(raw, n, ts, values, max);
+    }
+
+    bool ok = false;
+    uint32_t id;
+    if (count > 0 && count <= (uint32_t)samples_per_channel) {
+        memcpy(&id, raw + 4, sizeof(id));
+        uint32_t rate = channel_registry_at(&soc->channels, channel)->sample_rate;
+        uint64_t period_ns = 1000000000ULL / rate;
+        uint64_t first = (uint64_t)(samples_per_channel - count);
+        float step;
+        memcpy(&step, raw + 36, sizeof(step));
+        ok = id == channel && ts[count - 1] == (uint64_t)(samples_per_channel - 1) * period_ns;
+        for (uint32_t k = 0; ok && k < count; k++) {
+            float expect = dsp_bench_signal(first + k, channel);
+            ok = fabsf(values[k] - expect) <= 0.5f * step;
+        }
+    }
+    free(raw);
+    free(ts);
+    free(values);
+    return ok;
+}
+
+// Noisy sine of the given amplitude for the per-depth table
+static float quant_bench_signal(uint64_t i, float noise) {
+    uint32_t h = (uint32_t)(i * 2654435761u);
+    return 20.0f + 10.0f * sinf((float)(i % 1000) * 0.0062831853f) +
+           noise * ((float)(h >> 8) / 16777216.0f - 0.5f);
+}
+
+// Log footprint at fixed and adaptive precision, then the encoder's cost
+// and error at each depth
+static void run_quant_benchmark(BlackBoxSoC* soc, int samples_per_channel, TelemetryFormat format) {
+    (void)format;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: Adaptive Precision Encoder            *\n");
+    printf("************************************************************\n");
+
+    for (uint32_t c = 0; c < soc->channels.count; c++) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, c);
+        sensor_channel_set_state(ch, CHANNEL_ON, 0);
+        sensor_channel_set_sample_rate(ch, 1000);
+    }
+    soc->rpu.filter_enabled = soc->rpu.normalize_enabled = soc->rpu.compress_dynamics = false;
+    printf("Channels: %u at 1000 Hz, %d samples each (sine + noise + rare spikes)\n\n",
+           soc->channels.count, samples_per_channel);
+
+    static const struct {
+        const char* name;
+        uint8_t bit_depth;
+        bool adaptive;
+    } modes[] = {
+        {"float (32)", 32, false},
+        {"fixed 16", 16, false},
+        {"fixed 12", 12, false},
+        {"adaptive <=24", 24, true},
+    };
+    const double device_bytes = 1e12;
+    const double samples_per_s = soc->channels.count * 1000.0;
+    uint64_t float_bytes = 0;
+    bool verify_ok = true;
+    printf("%-16s %14s %14s %12s %12s\n", "Precision", "Samples", "NVMe bytes", "B/sample",
+           "Hours/TB");
+    printf("----------------------------------------------------------------------\n");
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        for (uint32_t c = 0; c < soc->channels.count; c++) {
+            SensorChannel* ch = channel_registry_at(&soc->channels, c);
+            ch->bit_depth = modes[m].bit_depth;
+            ch->adaptive_precision = modes[m].adaptive;
+        }
+        uint64_t logged;
+        uint64_t bytes = dsp_bench_log(soc, samples_per_channel, &logged);
+        if (m == 0) float_bytes = bytes;
+        if (modes[m].bit_depth < 32 && samples_per_channel > 0) {
+            verify_ok = verify_ok &&
+                        quant_block_verify(soc, soc->channels.count - 1, samples_per_channel);
+        }
+        double per_sample = logged > 0 ? (double)bytes / logged : 0.0;
+        double hours = per_sample > 0 ? device_bytes / (per_sample * samples_per_s) / 3600.0
+                                      : 0.0;
+        printf("%-16s %14lu %14lu %12.2f %12.1f", modes[m].name, logged, bytes, per_sample, hours);
+        if (m > 0 && bytes > 0) printf("   (%.1fx)", (double)float_bytes / bytes);
+        printf("\n");
+    }
+    for (uint32_t c = 0; c < soc->channels.count; c++) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, c);
+        ch->bit_depth = 32;
+        ch->adaptive_precision = false;
+    }
+    printf("Read-back of the newest block: %s\n\n", verify_ok ? "ok" : "FAILED");
+
+    // Encoder cost and error on one long block per noise level
+    enum { N = 1 << 16 };
+    uint64_t* ts = (uint64_t*)malloc(N * sizeof(uint64_t));
+    float* block = (float*)malloc(N * sizeof(float));
+    float* decoded = (float*)malloc(N * sizeof(float));
+    uint32_t cap = (uint32_t)sample_quant_block_size(32, N, false);
+    uint8_t* packed = (uint8_t*)malloc(cap);
+    if (!ts || !block || !decoded || !packed) {
+        free(ts);
+        free(block);
+        free(decoded);
+        free(packed);
+        return;
+    }
+    static const struct {
+        const char* name;
+        uint8_t bit_depth;
+        bool adaptive;
+        float noise;
+    } rows[] = {
+        {"8", 8, false, 4.0f},
+        {"12", 12, false, 4.0f},
+        {"16", 16, false, 4.0f},
+        {"24", 24, false, 4.0f},
+        {"32", 32, false, 4.0f},
+        {"adaptive, 4", 24, true, 4.0f},
+        {"adaptive, 0.1", 24, true, 0.1f},
+        {"adaptive, 0.001", 24, true, 0.001f},
+    };
+    for (uint32_t i = 0; i < N; i++) ts[i] = (uint64_t)i * 1000000ULL;
+    printf("%-16s %5s %10s %12s %12s %10s %10s\n", "Depth, noise", "Bits", "B/sample",
+           "Max error", "Half step", "Enc ns", "Dec ns");
+    printf("----------------------------------------------------------------------------------\n");
+    for (size_t r = 0; r < sizeof(rows) / sizeof(rows[0]); r++) {
+        for (uint32_t i = 0; i < N; i++) block[i] = quant_bench_signal(i, rows[r].noise);
+
+        const int reps = 20;
+        uint32_t len = 0, count = 0;
+        uint64_t enc_ns = 0, dec_ns = 0;
+        for (int k = 0; k < reps; k++) {
+            uint64_t start = monotonic_ns();
+            len = sample_quant_encode(0, rows[r].bit_depth, rows[r].adaptive, ts, block, N,
+                                      packed, cap);
+            uint64_t mid = monotonic_ns();
+            count = sample_quant_decode(packed, len, NULL, decoded, N);
+            enc_ns += mid - start;
+            dec_ns += monotonic_ns() - mid;
+        }
+
+        float step;
+        memcpy(&step, packed + 36, sizeof(step));
+        float max_err = 0.0f, limit = 0.0f;
+        for (uint32_t i = 0; i < count; i++) {
+            float err = fabsf(decoded[i] - block[i]);
+            float bound = 0.5f * step;
+            max_err = err > max_err ? err : max_err;
+            limit = bound > limit ? bound : limit;
+        }
+        bool ok = count == N && max_err <= limit;
+        verify_ok = verify_ok && ok;
+        printf("%-16s %5u %10.3f %12.6f %12.6f %10.2f %10.2f%s\n", rows[r].name,
+               count ? packed[3] : 0, (double)len / N, max_err, 0.5f * step,
+               (double)enc_ns / ((double)reps * N), (double)dec_ns / ((double)reps * N),
+               ok ? "" : "  FAILED");
+    }
+    printf("Round trip: %s\n", verify_ok ? "ok" : "FAILED");
+
+    free(ts);
+    free(block);
+    free(decoded);
+    free(packed);
+}
+
+// Redundant sensors around a shared truth: four wheel speeds with slightly
+// different tyre radii, and two temperature probes. Wheel 3 sticks halfway.
+enum { FUSION_WHEELS = 4, FUSION_PROBES = 2, FUSION_MEMBERS = FUSION_WHEELS + FUSION_PROBES };
+
+static float fusion_bench_truth(uint64_t i, uint32_t member) {
+    if (member < FUSION_WHEELS) return 20.0f + 5.0f * sinf((float)(i % 5000) * 0.00125663706f);
+    return 90.0f + 2.0f * sinf((float)(i % 60000) * 0.000104719755f);
+}
+
+static float fusion_bench_sample(uint64_t i, uint32_t member, uint64_t stick_at) {
+    if (member == FUSION_WHEELS - 1 && i > stick_at) i = stick_at;
+    uint32_t h = (uint32_t)((i + member * 7919u) * 2654435761u);
+    float noise = (float)(h >> 8) / 16777216.0f - 0.5f;
+    if (member < FUSION_WHEELS) {
+        return fusion_bench_truth(i, member) * (1.0f + 0.002f * ((float)member - 1.5f)) + 0.1f * noise;
+    }
+    return fusion_bench_truth(i, member) + 0.05f * noise;
+}
+
+// Push samples_per_channel into the members from sample base on, scoring
+// health every tick and draining whenever a ring is half full. The second
+// member trails the others by lag samples and catches up at the end.
+// Returns NVMe bytes written.
+static uint64_t fusion_bench_log(BlackBoxSoC* soc, uint32_t first, int samples_per_channel,
+                                 uint64_t base, uint32_t lag, uint64_t* logged) {
+    enum { TICK = 64 };
+    uint64_t ts[TICK];
+    float values[TICK];
+    uint64_t before = soc->nvme.bytes_written;
+    uint64_t period_ns = 1000000000ULL / channel_registry_at(&soc->channels, first)->sample_rate;
+
+    *logged = 0;
+    uint64_t trailing = 0;
+    for (int done = 0; done <= samples_per_channel; done += TICK) {
+        uint32_t n = samples_per_channel - done < TICK ? samples_per_channel - done : TICK;
+        bool drain = false;
+        for (uint32_t m = 0; m < FUSION_MEMBERS; m++) {
+            SensorChannel* ch = channel_registry_at(&soc->channels, first + m);
+            uint64_t from = done, to = done + n;
+            if (m == 1 && lag > 0) {
+                from = trailing;
+                to = n < TICK ? to : (to > lag ? to - lag : 0);
+                trailing = to;
+            }
+            for (uint64_t i = from; i < to; i += TICK) {
+                uint32_t count = to - i < TICK ? (uint32_t)(to - i) : TICK;
+                for (uint32_t k = 0; k < count; k++) {
+                    ts[k] = (base + i + k) * period_ns;
+                    values[k] = fusion_bench_sample(base + i + k, m, samples_per_channel / 2);
+                }
+                sensor_channel_push_samples(ch, ts, values, count);
+            }
+            if (sample_ring_depth(ch->samples) * 2 >= ch->samples->capacity) drain = true;
+        }
+        if (n == 0) break;
+        rpu_monitor_channels(soc, n * period_ns, (base + done + n - 1) * period_ns);
+        if (drain) *logged += sensor_channels_drain(soc);
+    }
+    *logged += sensor_channels_drain(soc);
+    return soc->nvme.bytes_written - before;
+}
+
+// Decode the blocks logged for channel with timestamps from sample base
+// on, as floats indexed by sample; returns how many were found
+static uint32_t fusion_bench_read(BlackBoxSoC* soc, uint32_t channel, bool deviation, uint64_t base,
+                                  uint64_t period_ns, float* out, bool* have, uint32_t count) {
+    uint32_t found = 0;
+    for (const LogIndex* e = soc->log_index; e; e = e->next) {
+        if (e->timestamp_end < base * period_ns) continue;
+        NVMeRegion region;
+        if (!nvme_map_region(soc, e->file_offset, e->compressed_size, &region)) continue;
+        uint8_t* raw = (uint8_t*)malloc(e->uncompressed_size);
+        uint32_t n = raw ? simple_decompress(region.data, region.length, raw, e->uncompressed_size) : 0;
+        nvme_unmap_region(&region);
+
+        // Quantized blocks, or full-precision ones (never deviations)
+        uint32_t id = 0;
+        if (n >= SAMPLE_BLOCK_HEADER_SIZE) memcpy(&id, raw + 4, sizeof(id));
+        bool quantized = n >= SAMPLE_QUANT_HEADER_SIZE && raw[0] == SAMPLE_QUANT_MAGIC0 &&
+                         raw[1] == SAMPLE_QUANT_MAGIC1;
+        bool full = !deviation && n >= SAMPLE_BLOCK_HEADER_SIZE && raw[0] == SAMPLE_BLOCK_MAGIC0 &&
+                    raw[1] == SAMPLE_BLOCK_MAGIC1;
+        if (n != e->uncompressed_size || id != channel || !(quantized || full) ||
+            (quantized && !(raw[12] & SAMPLE_QUANT_FLAG_DEVIATION) != !deviation)) {
+            free(raw);
+            continue;
+        }
+        uint64_t* ts = (uint64_t*)malloc(n * sizeof(uint64_t));
+        float* values = (float*)malloc(n * sizeof(float));
+        uint32_t got = 0;
+        if (ts && values && quantized) {
+            got = sample_quant_decode(raw, n, ts, values, n);
+        } else if (ts && values) {
+            memcpy(&got, raw + 8, sizeof(got));
+            memcpy(ts, raw + SAMPLE_BLOCK_HEADER_SIZE, (size_t)got * sizeof(uint64_t));
+            memcpy(values, raw + SAMPLE_BLOCK_HEADER_SIZE + (size_t)got * sizeof(uint64_t), got * sizeof(float));
+        }
+        for (uint32_t i = 0; i < got; i++) {
+            uint64_t sample = ts[i] / period_ns;
+            if (sample < base || sample - base >= count) continue;
+            out[sample - base] = values[i];
+            have[sample - base] = true;
+            found++;
+        }
+        free(ts);
+        free(values);
+        free(raw);
+    }
+    return found;
+}
+
+// Every member's logged deviation plus the logged composite at the same
+// timestamp must give back the sample the member took then
+static bool fusion_bench_aligned(BlackBoxSoC* soc, uint32_t first, const SensorGroup* group,
+                                 uint32_t member_offset, uint64_t base, uint32_t count,
+                                 int samples_per_channel, uint32_t* mismatches) {
+    uint64_t period_ns = 1000000000ULL / channel_registry_at(&soc->channels, first)->sample_rate;
+    float* composite = (float*)malloc(count * sizeof(float));
+    float* deviation = (float*)malloc(count * sizeof(float));
+    bool* have = (bool*)calloc(count, sizeof(bool));
+    bool* have_dev = (bool*)calloc(count, sizeof(bool));
+    bool ok = composite && deviation && have && have_dev &&
+              fusion_bench_read(soc, group->composite, false, base, period_ns, composite, have, count) == count;
+    for (uint32_t m = 0; ok && m < group->member_count; m++) {
+        memset(have_dev, 0, count * sizeof(bool));
+        ok = fusion_bench_read(soc, group->members[m], true, base, period_ns, deviation, have_dev, count) == count;
+        for (uint32_t i = 0; ok && i < count; i++) {
+            float sample = fusion_bench_sample(base + i, member_offset + m, samples_per_channel / 2);
+            float err = fabsf(composite[i] + deviation[i] - sample);
+            if (err > 0.5f * group->deviation_step + 1e-4f) (*mismatches)++;
+        }
+    }
+    free(composite);
+    free(deviation);
+    free(have);
+    free(have_dev);
+    return ok && *mismatches == 0;
+}
+
+// Newest deviation block logged for channel: largest |deviation| in it
+static bool fusion_bench_evidence(BlackBoxSoC* soc, uint32_t channel, float* max_dev) {
+    for (const LogIndex* e = soc->log_index; e; e = e->next) {
+        NVMeRegion region;
+        if (!nvme_map_region(soc, e->file_offset, e->compressed_size, &region)) continue;
+        uint8_t* raw = (uint8_t*)malloc(e->uncompressed_size);
+        uint32_t n = raw ? simple_decompress(region.data, region.length, raw, e->uncompressed_size) : 0;
+        nvme_unmap_region(&region);
+
+        uint32_t id = 0;
+        if (n >= SAMPLE_QUANT_HEADER_SIZE) memcpy(&id, raw + 4, sizeof(id));
+        if (n != e->uncompressed_size || n < SAMPLE_QUANT_HEADER_SIZE ||
+            raw[0] != SAMPLE_QUANT_MAGIC0 || raw[1] != SAMPLE_QUANT_MAGIC1 || id != channel ||
+            !(raw[12] & SAMPLE_QUANT_FLAG_DEVIATION)) {
+            free(raw);
+            continue;
+        }
+        float* dev = (float*)malloc(n * sizeof(float));
+        uint32_t count = dev ? sample_quant_decode(raw, n, NULL, dev, n) : 0;
+        *max_dev = 0.0f;
+        for (uint32_t i = 0; i < count; i++) {
+            if (fabsf(dev[i]) > *max_dev) *max_dev = fabsf(dev[i]);
+        }
+        free(dev);
+        free(raw);
+        return count > 0;
+    }
+    return false;
+}
+
+// Log redundant channels independently, then fused, and compare the vote
+// strategies against the shared truth
+static void run_fusion_benchmark(BlackBoxSoC* soc, int samples_per_channel, TelemetryFormat format) {
+    (void)format;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: Sensor Redundancy Fusion              *\n");
+    printf("************************************************************\n");
+
+    static const char* names[FUSION_MEMBERS] = {
+        "Wheel_FL", "Wheel_FR", "Wheel_RL", "Wheel_RR", "Temp_A", "Temp_B"
+    };
+    uint32_t first = soc->channels.count;
+    for (uint32_t m = 0; m < FUSION_MEMBERS; m++) sensor_channel_add(soc, names[m]);
+    if (soc->channels.count != first + FUSION_MEMBERS) return;
+    for (uint32_t c = 0; c < soc->channels.count; c++) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, c);
+        ch->bit_depth = 24;
+        ch->adaptive_precision = true;
+    }
+    soc->rpu.filter_enabled = soc->rpu.normalize_enabled = soc->rpu.compress_dynamics = false;
+    printf("Members: %d wheel speeds + %d temperature probes at 1000 Hz, %d samples each\n",
+           FUSION_WHEELS, FUSION_PROBES, samples_per_channel);
+    printf("Fault: %s sticks after %d samples; all channels adaptive <= 24 bits\n\n",
+           names[FUSION_WHEELS - 1], samples_per_channel / 2);
+
+    uint64_t solo_logged, fused_logged;
+    uint64_t solo_bytes = fusion_bench_log(soc, first, samples_per_channel, 0, 0, &solo_logged);
+
+    uint32_t wheels[FUSION_WHEELS], probes[FUSION_PROBES];
+    for (uint32_t m = 0; m < FUSION_WHEELS; m++) wheels[m] = first + m;
+    for (uint32_t m = 0; m < FUSION_PROBES; m++) probes[m] = first + FUSION_WHEELS + m;
+    int32_t wheel_group = sensor_group_add(soc, "Wheel_Speed", wheels, FUSION_WHEELS,
+                                           SENSOR_FUSION_WEIGHTED, 1.0f);
+    int32_t probe_group = sensor_group_add(soc, "Temp", probes, FUSION_PROBES,
+                                           SENSOR_FUSION_WEIGHTED, 0.5f);
+    if (wheel_group < 0 || probe_group < 0) {
+        printf("Could not create the fusion groups\n");
+        return;
+    }
+    for (uint32_t c = 0; c < soc->channels.count; c++) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, c);
+        sensor_channel_set_state(ch, c >= first ? CHANNEL_ON : ch->state, 0);
+        ch->health_score = 1.0f;
+        ch->bit_depth = 24;
+        ch->adaptive_precision = true;
+    }
+    uint64_t fused_bytes = fusion_bench_log(soc, first, samples_per_channel, 0, 0, &fused_logged);
+
+    // Per member sample, so the composites count against the fused run
+    double member_samples = (double)FUSION_MEMBERS * samples_per_channel;
+    printf("%-24s %16s %14s %12s\n", "Logging", "Samples logged", "NVMe bytes", "B/member");
+    printf("----------------------------------------------------------------------\n");
+    printf("%-24s %16lu %14lu %12.2f\n", "independent", solo_logged, solo_bytes,
+           member_samples > 0 ? solo_bytes / member_samples : 0.0);
+    printf("%-24s %16lu %14lu %12.2f   (%.1fx)\n", "composite + deviations", fused_logged,
+           fused_bytes, member_samples > 0 ? fused_bytes / member_samples : 0.0,
+           fused_bytes ? (double)solo_bytes / fused_bytes : 0.0);
+    printf("\n");
+
+    // Again with the second wheel trailing by most of a tick, logged at a
+    // finer deviation step (composites in full) so a sample voted at the
+    // wrong time stands out
+    enum { FUSION_LAG = 40 };
+    int32_t lag_groups[] = {wheel_group, probe_group};
+    for (size_t g = 0; g < sizeof(lag_groups) / sizeof(lag_groups[0]); g++) {
+        SensorGroup* group = &soc->groups[lag_groups[g]];
+        SensorChannel* out = channel_registry_at(&soc->channels, group->composite);
+        group->deviation_step = 0.001f;
+        out->bit_depth = 32;
+        out->adaptive_precision = false;
+    }
+    uint64_t lag_logged;
+    fusion_bench_log(soc, first, samples_per_channel, samples_per_channel, FUSION_LAG, &lag_logged);
+    uint32_t wheel_mismatches = 0, probe_mismatches = 0;
+    bool aligned = fusion_bench_aligned(soc, first, &soc->groups[wheel_group], 0, samples_per_channel,
+                                        samples_per_channel, samples_per_channel, &wheel_mismatches) &&
+                   fusion_bench_aligned(soc, first, &soc->groups[probe_group], FUSION_WHEELS,
+                                        samples_per_channel, samples_per_channel, samples_per_channel,
+                                        &probe_mismatches);
+    printf("%s trailing by %d samples: %lu logged, %u misaligned, aligned: %s\n\n", names[1], FUSION_LAG,
+           lag_logged, wheel_mismatches + probe_mismatches, aligned ? "yes" : "NO");
+
+    printf("%-14s %12s %14s %12s %10s %8s\n", "Group", "Fused", "Outvoted", "No quorum", "Silent", "Late");
+    printf("----------------------------------------------------------------------------\n");
+    for (uint32_t g = 0; g < soc->num_groups; g++) {
+        const SensorGroup* group = &soc->groups[g];
+        printf("%-14s %12lu %14lu %12lu %10lu %8lu\n", group->name, group->samples_fused,
+               group->votes_rejected, group->passes_without_quorum, group->passes_member_silent,
+               group->samples_late);
+    }
+    float evidence = 0.0f;
+    const SensorChannel* stuck = channel_registry_at(&soc->channels, first + FUSION_WHEELS - 1);
+    if (fusion_bench_evidence(soc, stuck->channel_id, &evidence)) {
+        printf("%s: %s, health %.2f, newest deviation block peaks at %.2f\n", stuck->name,
+               stuck->state == CHANNEL_FROZEN ? "frozen" : "voting", stuck->health_score, evidence);
+    } else {
+        printf("%s: no deviation block found\n", stuck->name);
+    }
+    printf("\n");
+
+    // Vote quality against the truth on one long pass of the wheel speeds
+    enum { N = 1 << 16 };
+    float* members = (float*)malloc((size_t)FUSION_WHEELS * N * sizeof(float));
+    float* composite = (float*)malloc(N * sizeof(float));
+    if (!members || !composite) {
+        free(members);
+        free(composite);
+        return;
+    }
+    for (uint32_t m = 0; m < FUSION_WHEELS; m++) {
+        for (uint32_t i = 0; i < N; i++) members[(size_t)m * N + i] = fusion_bench_sample(i, m, N / 2);
+    }
+    static const struct {
+        const char* name;
+        SensorFusionMode mode;
+        float tolerance;
+    } votes[] = {
+        {"mean (no vote)", SENSOR_FUSION_WEIGHTED, 0.0f},
+        {"median", SENSOR_FUSION_MEDIAN, 1.0f},
+        {"weighted, tol 1.0", SENSOR_FUSION_WEIGHTED, 1.0f},
+    };
+    const float weights[FUSION_WHEELS] = {1.0f, 1.0f, 1.0f, 1.0f};
+    printf("%-20s %14s %14s %12s\n", "Vote (4 wheels)", "RMS error", "Outvoted", "ns/sample");
+    printf("----------------------------------------------------------------------\n");
+    for (size_t v = 0; v < sizeof(votes) / sizeof(votes[0]); v++) {
+        const int reps = 20;
+        uint64_t rejected = 0, elapsed = 0;
+        for (int r = 0; r < reps; r++) {
+            uint64_t start = monotonic_ns();
+            rejected = sensor_fusion_vote(votes[v].mode, votes[v].tolerance, members, N, weights,
+                                          FUSION_WHEELS, N, composite);
+            elapsed += monotonic_ns() - start;
+        }
+        double sq = 0.0;
+        for (uint32_t i = 0; i < N; i++) {
+            double e = composite[i] - fusion_bench_truth(i, 0);
+            sq += e * e;
+        }
+        printf("%-20s %14.4f %14lu %12.2f\n", votes[v].name, sqrt(sq / N), rejected,
+               (double)elapsed / ((double)reps * N));
+    }
+    free(members);
+    free(composite);
+}
+
+// Signal names as a CAN decode table would produce them
+static void channel_bench_name(char* name, size_t size, uint32_t i) {
+    snprintf(name, size, "CAN_%03X_SIG%u", 0x100 + i / 8, i % 8);
+}
+
+// Register n channels at runtime, then look each one up by name
+static void run_channel_benchmark(BlackBoxSoC* soc, int count, TelemetryFormat format) {
+    (void)format;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: Channel Registry                      *\n");
+    printf("************************************************************\n");
+
+    uint32_t n = (uint32_t)count;
+    uint32_t first = soc->channels.count;
+    char name[32];
+    printf("Registering %u channels after the %u built in (%u per chunk)\n\n", n, first,
+           CHANNEL_REGISTRY_CHUNK);
+
+    // The table alone, as the old array grew (one realloc per add) and chunked
+    SensorChannel* flat = NULL;
+    uint64_t start = monotonic_ns();
+    for (uint32_t i = 0; i < n; i++) {
+        SensorChannel* grown = (SensorChannel*)realloc(flat, (i + 1) * sizeof(SensorChannel));
+        if (!grown) break;
+        flat = grown;
+        memset(&flat[i], 0, sizeof(SensorChannel));
+        channel_bench_name(flat[i].name, sizeof(flat[i].name), i);
+    }
+    uint64_t flat_ns = monotonic_ns() - start;
+    free(flat);
+
+    ChannelRegistry table;
+    channel_registry_init(&table);
+    start = monotonic_ns();
+    for (uint32_t i = 0; i < n; i++) {
+        channel_bench_name(name, sizeof(name), i);
+        if (!channel_registry_append(&table, name)) break;
+    }
+    uint64_t table_ns = monotonic_ns() - start;
+    channel_registry_free(&table);
+
+    // Full registration: ring and DSP chain per channel
+    const SensorChannel* anchor = channel_registry_at(&soc->channels, 0);
+    uint32_t added = 0;
+    start = monotonic_ns();
+    channel_registry_reserve(&soc->channels, first + n);
+    for (uint32_t i = 0; i < n; i++) {
+        channel_bench_name(name, sizeof(name), i);
+        if (sensor_channel_add(soc, name) == CHANNEL_HANDLE_INVALID) break;
+        added++;
+    }
+    uint64_t add_ns = monotonic_ns() - start;
+    bool stable = anchor == channel_registry_at(&soc->channels, 0);
+
+    printf("%-30s %14s %14s\n", "Registration", "Total ms", "ns/channel");
+    printf("--------------------------------------------------------------\n");
+    printf("%-30s %14.3f %14.1f\n", "table, realloc per add (old)", flat_ns / 1e6,
+           n ? (double)flat_ns / n : 0.0);
+    printf("%-30s %14.3f %14.1f\n", "table, chunked + name index", table_ns / 1e6,
+           n ? (double)table_ns / n : 0.0);
+    printf("%-30s %14.3f %14.1f\n", "sensor_channel_add (full)", add_ns / 1e6,
+           added ? (double)add_ns / added : 0.0);
+    printf("Added %u, earlier channels %s\n\n", added, stable ? "never moved" : "MOVED");
+
+    // Lookups: every name through the index, a sample by linear scan
+    uint32_t found = 0;
+    start = monotonic_ns();
+    for (uint32_t i = 0; i < added; i++) {
+        channel_bench_name(name, sizeof(name), i);
+        if (channel_registry_find(&soc->channels, name) == first + i) found++;
+    }
+    uint64_t find_ns = monotonic_ns() - start;
+
+    uint32_t scans = added < 1000 ? added : 1000;
+    uint32_t scanned = 0;
+    start = monotonic_ns();
+    for (uint32_t k = 0; k < scans; k++) {
+        uint32_t i = (uint32_t)(((uint64_t)k * added) / scans);
+        channel_bench_name(name, sizeof(name), i);
+        for (uint32_t c = 0; c < soc->channels.count; c++) {
+            if (strcmp(channel_registry_at(&soc->channels, c)->name, name) == 0) {
+                scanned += c == first + i;
+                break;
+            }
+        }
+    }
+    uint64_t scan_ns = monotonic_ns() - start;
+    bool missing_ok = channel_registry_find(&soc->channels, "CAN_FFF_SIG9") == CHANNEL_HANDLE_INVALID;
+
+    printf("%-30s %14s %14s\n", "Lookup by name", "Lookups", "ns/lookup");
+    printf("--------------------------------------------------------------\n");
+    printf("%-30s %14u %14.1f\n", "hash index", added, added ? (double)find_ns / added : 0.0);
+    printf("%-30s %14u %14.1f\n", "linear scan", scans, scans ? (double)scan_ns / scans : 0.0);
+    printf("Lookups: %s\n", found == added && scanned == scans && missing_ok ? "ok" : "FAILED");
+}
+
+#define CORE_BENCH_CHANNELS      16
+#define CORE_BENCH_UPLOAD_BYTES  (4 * 1024 * 1024)
+#define CORE_BENCH_UPLOAD_TICKS  100     // Single-thread run: one upload per 100 ms
+#define CORE_BENCH_STALL_NS      500000000ULL    // APU hang in the full-queue run
+
+typedef struct {
+    ChannelHandle first;
+    uint64_t sample;
+} CoreBenchSignal;
+
+// RPU sampler: each channel's samples for the tick, evenly spaced
+static void core_bench_sample(BlackBoxSoC* soc, uint64_t now_ns, uint64_t period_ns, void* user) {
+    enum { N = 256 };
+    CoreBenchSignal* signal = (CoreBenchSignal*)user;
+    uint64_t ts[N];
+    float values[N];
+    for (uint32_t c = 0; c < CORE_BENCH_CHANNELS; c++) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, signal->first + c);
+        if (ch->state == CHANNEL_OFF) continue;
+        uint64_t n = (uint64_t)ch->sample_rate * period_ns / 1000000000ULL;
+        if (n > N) n = N;
+        for (uint64_t i = 0; i < n; i++) {
+            ts[i] = now_ns - period_ns + (i + 1) * (period_ns / n);
+            values[i] = quant_bench_signal(signal->sample + i + c * 7919u, 0.2f);
+        }
+        sensor_channel_push_samples(ch, ts, values, (uint32_t)n);
+    }
+    signal->sample += period_ns / 1000000ULL;
+}
+
+typedef struct {
+    const uint8_t* body;
+    uint8_t* out;
+    _Atomic uint64_t done;
+    uint64_t busy_ns;
+} CoreBenchUpload;
+
+// Stand-in for a cloud upload: gzip a log-sized request body, the CPU-bound
+// part of sending one (the network wait itself costs the RPU nothing)
+static void core_bench_upload(BlackBoxSoC* soc, void* user) {
+    (void)soc;
+    CoreBenchUpload* upload = (CoreBenchUpload*)user;
+    uint64_t start = monotonic_ns();
+    payload_codec_gzip(upload->body, CORE_BENCH_UPLOAD_BYTES, upload->out, CORE_BENCH_UPLOAD_BYTES,
+                       PAYLOAD_LEVEL_MEDIUM);
+    upload->busy_ns += monotonic_ns() - start;
+    atomic_fetch_add(&upload->done, 1);
+}
+
+// APU job that stands in for a hung upload
+static void core_bench_stall(BlackBoxSoC* soc, void* user) {
+    (void)soc;
+    (void)user;
+    rate_scheduler_sleep_until(monotonic_ns() + CORE_BENCH_STALL_NS);
+}
+
+// Samples pushed into, logged from and dropped by the bench channels
+static void core_bench_totals(BlackBoxSoC* soc, ChannelHandle first, uint64_t* pushed,
+                              uint64_t* logged, uint64_t* dropped) {
+    *pushed = *logged = *dropped = 0;
+    for (uint32_t c = 0; c < CORE_BENCH_CHANNELS; c++) {
+        const SensorChannel* ch = channel_registry_at(&soc->channels, first + c);
+        *pushed += sample_ring_head(ch->samples);
+        *logged += ch->samples_recorded;
+        *dropped += sample_ring_dropped(ch->samples);
+    }
+}
+
+static void core_bench_row(const char* label, const CoreRuntimeStats* stats, uint64_t uploads) {
+    printf("%-28s %7lu %7lu %6lu %9.1f %9.1f %9.1f %8lu\n", label, stats->ticks, stats->missed,
+           stats->late_ticks, stats->delay_max_us, stats->jitter_p99_us, stats->work_max_us, uploads);
+}
+
+// RPU loop timing with the APU idle, with the APU uploading back to back,
+// and with both folded into one thread as before
+static void run_cores_benchmark(BlackBoxSoC* soc, int seconds, TelemetryFormat format) {
+    (void)format;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: RPU/APU Core Threads                  *\n");
+    printf("************************************************************\n");
+
+    CoreBenchSignal signal = {soc->channels.count, 0};
+    char name[32];
+    for (uint32_t c = 0; c < CORE_BENCH_CHANNELS; c++) {
+        snprintf(name, sizeof(name), "Core_Bench_%02u", c);
+        ChannelHandle handle = sensor_channel_add(soc, name);
+        SensorChannel* ch = channel_registry_at(&soc->channels, handle);
+        if (!ch) return;
+        ch->bit_depth = 16;
+    }
+
+    CoreBenchUpload upload = {0};
+    uint8_t* body = (uint8_t*)malloc(CORE_BENCH_UPLOAD_BYTES);
+    upload.out = (uint8_t*)malloc(CORE_BENCH_UPLOAD_BYTES);
+    if (!body || !upload.out) {
+        free(body);
+        free(upload.out);
+        return;
+    }
+    for (size_t len = 0, i = 0; len < CORE_BENCH_UPLOAD_BYTES; i++) {
+        char line[64];
+        int n = snprintf(line, sizeof(line), "{\"t\":%zu,\"ch\":%zu,\"v\":%.3f}\n", i * 1000,
+                         i % CORE_BENCH_CHANNELS, quant_bench_signal(i, 0.2f));
+        size_t take = CORE_BENCH_UPLOAD_BYTES - len < (size_t)n ? CORE_BENCH_UPLOAD_BYTES - len : (size_t)n;
+        memcpy(body + len, line, take);
+        len += take;
+    }
+    upload.body = body;
+
+    CoreRuntimeConfig config;
+    core_runtime_config_defaults(&config);
+    config.sample = core_bench_sample;
+    config.sample_user = &signal;
+    uint64_t run_ns = (uint64_t)seconds * 1000000000ULL;
+    printf("%u channels at 1 kHz, RPU tick %u Hz, drain every %u ticks, %d s per run\n",
+           CORE_BENCH_CHANNELS, config.rate_hz, config.drain_ticks, seconds);
+    printf("Upload: gzip of a %u MB request body\n\n", CORE_BENCH_UPLOAD_BYTES / (1024 * 1024));
+
+    CoreRuntime runtime;
+    CoreRuntimeStats idle, loaded;
+    bool started = core_runtime_start(&runtime, soc, &config);
+    if (started) {
+        rate_scheduler_sleep_until(monotonic_ns() + run_ns);
+        core_runtime_stop(&runtime);
+        core_runtime_get_stats(&runtime, &idle);
+        started = core_runtime_start(&runtime, soc, &config);
+    }
+    if (!started) {
+        printf("Core threads unavailable on this platform\n");
+        free(body);
+        free(upload.out);
+        return;
+    }
+
+    // Keep one upload queued behind the one running, plus configuration
+    // from a local and a remote (refused) requester
+    uint64_t submitted = 0;
+    RpuCommand off = {RPU_COMMAND_SET_STATE, signal.first, CHANNEL_OFF};
+    RpuCommand on = {RPU_COMMAND_SET_STATE, signal.first, CHANNEL_ON};
+    core_runtime_configure(&runtime, &off, true);
+    core_runtime_configure(&runtime, &on, true);
+    core_runtime_configure(&runtime, &off, false);
+    for (uint64_t end = monotonic_ns() + run_ns; monotonic_ns() < end;) {
+        if (submitted - atomic_load(&upload.done) < 2 &&
+            core_runtime_submit(&runtime, core_bench_upload, &upload)) {
+            submitted++;
+        }
+        rate_scheduler_sleep_until(monotonic_ns() + 1000000ULL);
+    }
+    core_runtime_stop(&runtime);
+    core_runtime_get_stats(&runtime, &loaded);
+    uint64_t threaded_uploads = atomic_load(&upload.done);
+    double upload_ms = threaded_uploads ? upload.busy_ns / 1e6 / threaded_uploads : 0.0;
+
+    // Hang the APU while the RPU drains every tick: the handoff queue fills
+    // and the samples wait in their rings, so every one pushed is logged
+    uint64_t pushed0, logged0, dropped0, pushed, logged, dropped;
+    core_bench_totals(soc, signal.first, &pushed0, &logged0, &dropped0);
+    CoreRuntimeConfig stall_config = config;
+    stall_config.drain_ticks = 1;
+    CoreRuntimeStats stalled = {0};
+    if (core_runtime_start(&runtime, soc, &stall_config)) {
+        core_runtime_submit(&runtime, core_bench_stall, NULL);
+        rate_scheduler_sleep_until(monotonic_ns() + 2 * CORE_BENCH_STALL_NS);
+        core_runtime_stop(&runtime);
+        core_runtime_get_stats(&runtime, &stalled);
+    }
+    core_bench_totals(soc, signal.first, &pushed, &logged, &dropped);
+    pushed -= pushed0;
+    logged -= logged0;
+    dropped -= dropped0;
+
+    // One thread: the tick runs the RPU path, logs inline and takes its
+    // turn at the upload
+    CoreRuntimeStats inline_stats = {0};
+    RateScheduler sched;
+    rate_scheduler_init(&sched, config.rate_hz);
+    uint64_t now_ns = 0, ticks = 0, delay_max = 0, work_max = 0;
+    atomic_store(&upload.done, 0);
+    while (sched.next_ns - sched.start_ns < run_ns) {
+        uint64_t due = sched.next_ns;
+        uint32_t periods = rate_scheduler_wait(&sched);
+        uint64_t start = monotonic_ns();
+        uint64_t delay = start > due ? start - due : 0;
+        if (delay > delay_max) delay_max = delay;
+        if (delay >= sched.period_ns) inline_stats.late_ticks++;
+
+        uint64_t period_ns = (uint64_t)periods * sched.sim_period_ns;
+        now_ns += period_ns;
+        core_bench_sample(soc, now_ns, period_ns, &signal);
+        rpu_monitor_channels(soc, period_ns, now_ns);
+        if (++ticks % config.drain_ticks == 0) sensor_channels_drain(soc);
+        if (ticks % CORE_BENCH_UPLOAD_TICKS == 0) core_bench_upload(soc, &upload);
+
+        uint64_t work = monotonic_ns() - start;
+        if (work > work_max) work_max = work;
+    }
+    sensor_channels_drain(soc);
+    RateSchedulerStats sched_stats;
+    rate_scheduler_get_stats(&sched, &sched_stats);
+    inline_stats.ticks = sched_stats.ticks;
+    inline_stats.missed = sched_stats.missed;
+    inline_stats.delay_max_us = delay_max / 1000.0;
+    inline_stats.jitter_p99_us = sched_stats.jitter_p99_us;
+    inline_stats.work_max_us = work_max / 1000.0;
+
+    printf("%-28s %7s %7s %6s %9s %9s %9s %8s\n", "RPU loop", "Ticks", "Missed", "Late",
+           "Delay max", "Wake p99", "Work max", "Uploads");
+    printf("%-28s %7s %7s %6s %9s %9s %9s %8s\n", "", "", "", "", "us", "us", "us", "");
+    printf("------------------------------------------------------------------------------------\n");
+    core_bench_row("own thread, APU idle", &idle, 0);
+    core_bench_row("own thread, APU uploading", &loaded, threaded_uploads);
+    core_bench_row("one thread, inline uploads", &inline_stats, atomic_load(&upload.done));
+
+    printf("\nRPU thread: %s, %s%s\n", loaded.realtime ? "SCHED_FIFO" : "normal scheduling (SCHED_FIFO not permitted)",
+           loaded.pinned ? "pinned" : "not pinned", loaded.shared_cpu ? ", sharing the only CPU with the APU" : "");
+    printf("Upload: %.1f ms of APU time each\n", upload_ms);
+    printf("Log handoff: %lu blocks, %lu logged, %lu failed, %lu put off by a full queue\n",
+           loaded.blocks_handed_off, loaded.blocks_logged, loaded.log_failures, loaded.handoff_stalls);
+    printf("History: %lu rollup records stored by the APU, %lu refused\n", loaded.rollups_stored,
+           loaded.rollup_failures);
+    printf("APU hung %.0f ms, draining every tick: %lu handoffs put off, %lu pushed, %lu logged, "
+           "%lu dropped: %s\n", CORE_BENCH_STALL_NS / 1e6, stalled.handoff_stalls, pushed, logged, dropped,
+           stalled.handoff_stalls > 0 && pushed == logged && dropped == 0 && stalled.log_failures == 0
+               ? "none lost" : "LOST");
+    printf("Configuration: %lu applied, %lu refused\n", loaded.commands_applied, loaded.commands_rejected);
+    printf("Sampling %s by uploads on the core threads\n",
+           loaded.late_ticks == 0 && loaded.missed == 0 ? "never delayed" : "DELAYED");
+
+    free(body);
+    free(upload.out);
+}
+
+#define HISTORY_BENCH_CHANNELS   16
+#define HISTORY_BENCH_RATE_HZ    100
+#define HISTORY_BENCH_BLOCK      1000    // Samples per channel per drain
+#define HISTORY_BENCH_WIDTH      600     // Points a dashboard plot asks for
+#define HISTORY_BENCH_BASE       "history_bench"
+
+static float history_bench_signal(uint64_t i, uint32_t channel) {
+    double hours = (double)i / HISTORY_BENCH_RATE_HZ / 3600.0;
+    return quant_bench_signal(i + channel * 7919u, 0.2f) + 5.0f * (float)sin(hours * 2.0943951);
+}
+
+static void history_bench_store(HistoryRollup* history) {
+    for (uint32_t level = 0; level < HISTORY_LEVELS; level++) {
+        history_rollup_store(history, level, history->pending[level], history->pending_count[level]);
+        history->pending_count[level] = 0;
+    }
+}
+
+// Ingest channel 0 samples [from, to) and store the closed buckets
+static void history_bench_extend(HistoryRollup* history, float* raw, uint64_t* ts, float* values,
+                                 uint64_t from, uint64_t to, uint64_t period_ns) {
+    for (uint64_t base = from; base < to; base += HISTORY_BENCH_BLOCK) {
+        uint32_t n = to - base < HISTORY_BENCH_BLOCK ? (uint32_t)(to - base) : HISTORY_BENCH_BLOCK;
+        for (uint32_t i = 0; i < n; i++) {
+            ts[i] = (base + i) * period_ns;
+            values[i] = raw[base + i] = history_bench_signal(base + i, 0);
+        }
+        history_rollup_ingest(history, 0, ts, values, n);
+        history_bench_store(history);
+    }
+}
+
+// Recompute a query's points from the raw samples of channel 0
+static bool history_bench_check(const HistoryRecord* points, uint32_t count, const float* raw,
+                                uint64_t period_ns) {
+    for (uint32_t p = 0; p < count; p++) {
+        uint64_t first = points[p].start_ns / period_ns;
+        if (points[p].count == 0) return false;
+        float lo = raw[first], hi = raw[first];
+        double sum = 0.0;
+        for (uint64_t i = first; i < first + points[p].count; i++) {
+            lo = raw[i] < lo ? raw[i] : lo;
+            hi = raw[i] > hi ? raw[i] : hi;
+            sum += raw[i];
+        }
+        float mean = (float)(sum / points[p].count);
+        if (lo != points[p].min || hi != points[p].max || fabsf(mean - points[p].mean) > 1e-4f * (1.0f + fabsf(mean)) ||
+            raw[first + points[p].count - 1] != points[p].last) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Build hours of 1 s / 1 min / 1 h rollups while ingesting, then query
+// spans from a minute to the whole run at dashboard width
+static void run_history_benchmark(BlackBoxSoC* soc, int hours, TelemetryFormat format) {
+    (void)soc;
+    (void)format;
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Benchmark: History Rollup Pyramid                *\n");
+    printf("************************************************************\n");
+
+    const uint64_t period_ns = 1000000000ULL / HISTORY_BENCH_RATE_HZ;
+    const uint64_t total = (uint64_t)hours * 3600 * HISTORY_BENCH_RATE_HZ;
+    printf("%u channels at %u Hz for %d h: %lu samples per channel\n\n", HISTORY_BENCH_CHANNELS,
+           HISTORY_BENCH_RATE_HZ, hours, total);
+
+    HistoryRollup history;
+    const uint64_t extended = total + 3600ULL * HISTORY_BENCH_RATE_HZ;     // Resumed hour
+    float* raw = (float*)malloc(extended * sizeof(float));
+    uint64_t* ts = (uint64_t*)malloc(HISTORY_BENCH_BLOCK * sizeof(uint64_t));
+    float* values = (float*)malloc(HISTORY_BENCH_BLOCK * sizeof(float));
+    HistoryRecord* points = (HistoryRecord*)malloc(HISTORY_READ_WINDOW * 64 * sizeof(HistoryRecord));
+    if (!raw || !ts || !values || !points || !history_rollup_open(&history, HISTORY_BENCH_BASE, false)) {
+        free(raw);
+        free(ts);
+        free(values);
+        free(points);
+        return;
+    }
+
+    // Ingest as the drain would: a block per channel, then store the closed buckets
+    uint64_t ingest_ns = 0;
+    for (uint64_t base = 0; base < total; base += HISTORY_BENCH_BLOCK) {
+        uint32_t n = total - base < HISTORY_BENCH_BLOCK ? (uint32_t)(total - base) : HISTORY_BENCH_BLOCK;
+        for (uint32_t i = 0; i < n; i++) ts[i] = (base + i) * period_ns;
+        for (uint32_t c = 0; c < HISTORY_BENCH_CHANNELS; c++) {
+            for (uint32_t i = 0; i < n; i++) values[i] = history_bench_signal(base + i, c);
+            if (c == 0) memcpy(raw + base, values, n * sizeof(float));
+            uint64_t start = monotonic_ns();
+            history_rollup_ingest(&history, c, ts, values, n);
+            ingest_ns += monotonic_ns() - start;
+        }
+        uint64_t start = monotonic_ns();
+        history_bench_store(&history);
+        ingest_ns += monotonic_ns() - start;
+    }
+    history_rollup_flush(&history);
+    history_bench_store(&history);
+
+    uint64_t samples = total * HISTORY_BENCH_CHANNELS;
+    printf("Ingest: %.2f ns/sample (rollups built and stored)\n", samples ? (double)ingest_ns / samples : 0.0);
+    printf("%-8s %12s %14s\n", "Level", "Records", "Side file KB");
+    for (uint32_t level = 0; level < HISTORY_LEVELS; level++) {
+        static const char* const names[HISTORY_LEVELS] = {"1 s", "1 min", "1 h"};
+        printf("%-8s %12u %14.1f\n", names[level], history.records[level],
+               history.records[level] * sizeof(HistoryRecord) / 1024.0);
+    }
+    printf("Raw samples (timestamp + value): %.1f KB\n\n", samples * 12.0 / 1024.0);
+
+    // Dashboard queries on channel 0, against a scan of its raw samples
+    // (in memory, so before any decompression the raw path would need)
+    static const uint64_t spans_s[] = {60, 3600, 6 * 3600, 0};
+    uint64_t end_ns = total * period_ns;
+    bool match = true;
+    printf("%-10s %10s %8s %8s %12s %14s %12s\n", "Span", "Res s", "Level", "Points", "Query us",
+           "Raw samples", "Raw scan us");
+    printf("------------------------------------------------------------------------------\n");
+    for (size_t q = 0; q < sizeof(spans_s) / sizeof(spans_s[0]); q++) {
+        uint64_t span_ns = spans_s[q] ? spans_s[q] * 1000000000ULL : end_ns;
+        if (span_ns > end_ns) continue;
+        uint64_t from_ns = end_ns - span_ns;
+        uint64_t resolution_ns = span_ns / HISTORY_BENCH_WIDTH;
+
+        enum { REPEAT = 20 };
+        uint32_t got = 0;
+        uint64_t start = monotonic_ns();
+        for (int r = 0; r < REPEAT; r++) {
+            got = history_rollup_query(&history, 0, from_ns, end_ns, resolution_ns, points, HISTORY_BENCH_WIDTH * 64);
+        }
+        double query_us = (monotonic_ns() - start) / 1e3 / REPEAT;
+        match = match && got > 0 && history_bench_check(points, got, raw, period_ns);
+
+        uint64_t first = from_ns / period_ns;
+        volatile float sink = 0.0f;
+        start = monotonic_ns();
+        float lo = raw[first], hi = raw[first];
+        double sum = 0.0;
+        for (uint64_t i = first; i < total; i++) {
+            lo = raw[i] < lo ? raw[i] : lo;
+            hi = raw[i] > hi ? raw[i] : hi;
+            sum += raw[i];
+        }
+        sink = lo + hi + (float)sum;
+        (void)sink;
+        double scan_us = (monotonic_ns() - start) / 1e3;
+
+        char label[32];
+        if (spans_s[q]) snprintf(label, sizeof(label), "%lu %s", spans_s[q] >= 3600 ? spans_s[q] / 3600 : spans_s[q] / 60,
+                                 spans_s[q] >= 3600 ? "h" : "min");
+        else snprintf(label, sizeof(label), "all %d h", hours);
+        printf("%-10s %10.1f %8s %8u %12.1f %14lu %12.1f\n", label, resolution_ns / 1e9,
+               (const char*[]){"1 s", "1 min", "1 h"}[history_rollup_level_for(resolution_ns)], got, query_us,
+               total - first, scan_us);
+    }
+
+    // Same range, finer resolution: the cost follows the points returned
+    uint64_t start = monotonic_ns();
+    uint32_t fine = history_rollup_query(&history, 0, 0, end_ns, HISTORY_RESOLUTION_1S, points, HISTORY_READ_WINDOW * 64);
+    double fine_us = (monotonic_ns() - start) / 1e3;
+    match = match && history_bench_check(points, fine, raw, period_ns);
+    printf("\nWhole run at 1 s: %u points in %.1f us (%.3f us/point)\n", fine, fine_us, fine ? fine_us / fine : 0.0);
+    printf("Rollups match the raw samples: %s\n", match ? "yes" : "NO");
+
+    // Close 90.5 s into the next hour, after a late block, then resume: the
+    // partial buckets flushed at close merge with their continuation
+    uint64_t split = total + 90 * HISTORY_BENCH_RATE_HZ + HISTORY_BENCH_RATE_HZ / 2;
+    history_bench_extend(&history, raw, ts, values, total, split, period_ns);
+    history_bench_extend(&history, raw, ts, values, split - HISTORY_BENCH_BLOCK, split, period_ns);
+    uint64_t late = history.samples_late;
+    history_rollup_close(&history);
+    bool resumed = history_rollup_open(&history, HISTORY_BENCH_BASE, true);
+    uint32_t per_level[HISTORY_LEVELS] = {0};
+    uint64_t merged = 0;
+    if (resumed) {
+        history_bench_extend(&history, raw, ts, values, split, extended, period_ns);
+        history_rollup_flush(&history);
+        history_bench_store(&history);
+        merged = history.records_merged;
+        for (uint32_t level = 0; level < HISTORY_LEVELS; level++) {
+            per_level[level] = history_rollup_query(&history, 0, total * period_ns, extended * period_ns,
+                                                    history_rollup_resolution(level), points, HISTORY_READ_WINDOW * 64);
+            resumed = resumed && history_bench_check(points, per_level[level], raw, period_ns);
+        }
+    }
+    resumed = resumed && per_level[0] == 3600 && per_level[1] == 60 && per_level[2] == 1 && late == HISTORY_BENCH_BLOCK;
+    printf("Resumed mid-hour: %u / %u / %u points at 1 s / 1 min / 1 h, %lu records merged, %lu late "
+           "samples dropped: %s\n", per_level[0], per_level[1], per_level[2], merged, late, resumed ? "ok" : "NO");
+
+    history_rollup_close(&history);
+    static const char* const suffixes[HISTORY_LEVELS] = {".h1s", ".h1m", ".h1h"};
+    for (uint32_t level = 0; level < HISTORY_LEVELS; level++) {
+        char path[64];
+        snprintf(path, sizeof(path), "%s%s", HISTORY_BENCH_BASE, suffixes[level]);
+        remove(path);
+    }
+    free(raw);
+    free(ts);
+    free(values);
+    free(points);
+}
+/* ============================================================================
+ * DISPATCH
+ * ============================================================================ */
+
+static const BenchEntry bench_table[] = {
+    { "--bench-upload", "[n]", 1000, run_upload_benchmark,
+      "Benchmark upload throughput vs batch size", NULL },
+    { "--bench-json", "[n]", 100000, run_json_benchmark,
+      "Benchmark JSON serialization (ns/packet)", NULL },
+    { "--bench-ws", "[n]", 500, run_ws_benchmark,
+      "Compare HTTP vs WebSocket per-sample latency", NULL },
+    { "--bench-drive", "[n]", 100000, run_drive_benchmark,
+      "Benchmark the drive model over n vehicles", NULL },
+    { "--bench-samples", "[n]", 1000000, run_sample_benchmark,
+      "Benchmark n samples per channel into the log", NULL },
+    { "--bench-health", "[n]", 256, run_health_benchmark,
+      "Benchmark batched health over n channels", NULL },
+    { "--bench-dsp", "[n]", 100000, run_dsp_benchmark,
+      "Log n samples per channel with the RPU DSP", "chain off and on" },
+    { "--bench-quant", "[n]", 100000, run_quant_benchmark,
+      "Log n samples per channel at fixed and", "adaptive precision" },
+    { "--bench-fusion", "[n]", 100000, run_fusion_benchmark,
+      "Log n samples of redundant sensors on their", "own and fused" },
+    { "--bench-channels", "[n]", 5000, run_channel_benchmark,
+      "Register n channels at runtime and look", "them up by name" },
+    { "--bench-cores", "[s]", 2, run_cores_benchmark,
+      "Time the RPU loop on its own thread, idle and",
+      "under APU uploads, for s seconds each" },
+    { "--bench-history", "[h]", 24, run_history_benchmark,
+      "Build h hours of history rollups and query", "them at dashboard resolution" },
+};
+
+#define BENCH_COUNT (sizeof(bench_table) / sizeof(bench_table[0]))
+
+const BenchEntry* bench_find(const char* flag) {
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        if (strcmp(flag, bench_table[i].flag) == 0) return &bench_table[i];
+    }
+    return NULL;
+}
+
+void bench_print_usage(void) {
+    for (size_t i = 0; i < BENCH_COUNT; i++) {
+        const BenchEntry* entry = &bench_table[i];
+        char usage[32];
+        snprintf(usage, sizeof(usage), "%s %s", entry->flag, entry->arg);
+        printf("      %-19s %s\n", usage, entry->help);
+        if (entry->help_more) printf("%26s%s\n", "", entry->help_more);
+    }
+}
@@ -0,0 +1,30 @@
+/*
+ * BlackBox DPU - Benchmarks
+ * The --bench-* modes: each one sets up a workload, times it and prints a
+ * report, selected from a flag table shared by the parser and --help
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "soc_core.h"
+#include "telemetry_sender.h"
+
+typedef void (*BenchFn)(BlackBoxSoC* soc, int count, TelemetryFormat format);
+
+typedef struct {
+    const char* flag;            // "--bench-json"
+    const char* arg;             // Placeholder for the optional count in --help
+    int default_count;           // Used when the flag has no count after it
+    BenchFn run;
+    const char* help;
+    const char* help_more;       // Continuation line, or NULL
+} BenchEntry;
+
+// Entry for a command line flag, or NULL if it is not a benchmark
+const BenchEntry* bench_find(const char* flag);
+
+// One --help line (two for long descriptions) per benchmark
+void bench_print_usage(void);
+
+#endif // BENCH_H
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include <time.h>
 
 /* ============================================================================
@@ -25,6 +26,13 @@
     #include <unistd.h>  // POSIX: usleep, sleep
 #endif
 
+// Monotonic wall clock in nanoseconds (for rate limiting and latency stats)
+static inline uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
 /* ============================================================================
  * MEMORY MAP DEFINITIONS (From Section 4.1)
  * ============================================================================ */
@@ -34,6 +42,13 @@
 #define SBM_BASE                0x04000000  // Shared Buffer Memory
 #define SBM_SIZE                (4 * 1024 * 1024)
 
+// SBM is carved into four 1MB slots, one per pipeline stage
+#define SBM_SLOT_SIZE           (1 * 1024 * 1024)
+#define SBM_INPUT_BUF           (SBM_BASE + 0 * SBM_SLOT_SIZE)
+#define SBM_COMP_BUF            (SBM_BASE + 1 * SBM_SLOT_SIZE)
+#define SBM_NVME_BUF            (SBM_BASE + 2 * SBM_SLOT_SIZE)
+#define SBM_ETH_BUF             (SBM_BASE + 3 * SBM_SLOT_SIZE)
+
 #define APU_L2_CACHE_BASE       0x08000000
 #define APU_L2_CACHE_SIZE       (1 * 1024 * 1024)
 
@@ -110,8 +125,14 @@ typedef struct EthernetMAC EthernetMAC;
 typedef struct NVMeController NVMeController;
 typedef struct NoCStatistics NoCStatistics;
 typedef struct SensorChannel SensorChannel;
+typedef struct SampleRing SampleRing;
+typedef struct SensorHealthBatch SensorHealthBatch;
+typedef struct RpuDspChain RpuDspChain;
+typedef struct SensorGroup SensorGroup;
 typedef struct APUCore APUCore;
 typedef struct RPUCore RPUCore;
+typedef struct CoreRuntime CoreRuntime;
+typedef struct HistoryRollup HistoryRollup;
 typedef struct LogIndex LogIndex;
 typedef struct EventMarker EventMarker;
 
@@ -185,6 +206,11 @@ struct EthernetMAC {
     // Statistics
     uint64_t bytes_transmitted;
     uint32_t packets_transmitted;
+    uint64_t bytes_copied;      // CPU copies made to feed the MAC
+
+    // Async frames the transport finished, pushed from whichever thread
+    // polled it and reaped by ethernet_reap_tx on the SoC's own loop
+    _Atomic(struct EthTxContext*) tx_done;
 };
 
 // NVMe controller model
@@ -200,6 +226,7 @@ struct NVMeController {
     
     // Virtual storage (file-backed)
     FILE* storage_file;
+    FILE* index_file;        // Append-only log index sidecar
 };
 
 // Network-on-Chip interconnect statistics
@@ -235,14 +262,34 @@ struct SensorChannel {
     
     // Configuration
     uint32_t sample_rate;        // Hz
-    uint8_t bit_depth;           // 16, 24, 32 bits
-    bool adaptive_precision;
+    uint8_t bit_depth;           // Logged precision: 8, 12, 16, 24, 32 (float) bits
+    bool adaptive_precision;     // Fit bit_depth to each block (ceiling bit_depth)
+    
+    // Raw samples awaiting the logging pipeline (sample_ring.h)
+    SampleRing* samples;
+    RpuDspChain* dsp;            // Conditioning ahead of logging (rpu_dsp.h)
+    int32_t fusion_group;        // Index into BlackBoxSoC.groups, -1 = logged on its own
     
     // Statistics
     uint64_t samples_recorded;
     uint64_t freeze_start_time;
 };
 
+// A channel's handle is its channel_id; channels are never removed
+typedef uint32_t ChannelHandle;
+
+// Chunked channel table (channel_registry.h)
+typedef struct {
+    SensorChannel** chunks;      // Fixed-size chunks, never moved once allocated
+    uint32_t chunk_slots;        // Capacity of chunks (doubles)
+    uint32_t count;
+
+    // Name index: open addressing, linear probing, handle + 1 per slot
+    // (0 = empty), kept at most half full
+    uint32_t* index;
+    uint32_t index_mask;
+} ChannelRegistry;
+
 // Event marker (DAW-style bookmarks)
 struct EventMarker {
     uint64_t timestamp;
@@ -292,16 +339,82 @@ struct RPUCore {
     // Sensor health monitoring
     uint32_t monitored_channels;
     float health_threshold;
+    SensorHealthBatch* health_batch;   // Batched kernel state (sensor_health.h)
+
+    // Drain scratch, allocated once by rpu_init so sensor_channels_drain
+    // never allocates: a log block and its packed form, and the fusion
+    // pass (member values, deviations and composite; member timestamps)
+    uint8_t* drain_block;
+    uint8_t* drain_packed;
+    float* fusion_values;
+    uint64_t* fusion_ts;
 };
 
+// Read-only view of a byte range in NVMe storage. On POSIX this is an mmap
+// of the backing file (no copy); elsewhere it falls back to a heap buffer.
+typedef struct {
+    const uint8_t* data;     // First byte of the requested range
+    uint32_t length;
+    void* base;              // Mapping/allocation actually owned
+    size_t base_length;
+    bool mapped;             // true = mmap, false = heap copy
+} NVMeRegion;
+
+// On-disk log index record (sidecar file next to NVMe storage)
+typedef struct {
+    uint64_t timestamp_start;
+    uint64_t timestamp_end;
+    uint64_t file_offset;
+    uint32_t compressed_size;
+    uint32_t uncompressed_size;
+} LogIndexRecord;
+
 // Cloud sync state
 typedef struct {
     bool connected;
     uint64_t last_sync_timestamp;  // Watermark
+    uint64_t last_sync_offset;     // Storage bytes acknowledged by the cloud
     uint64_t backlog_bytes;
     bool redemption_in_progress;
+    bool probing;                  // Link assumed up on a retry, announced on the first ack
 } CloudSyncState;
 
+// Backlog redemption engine (drains the log from the watermark)
+#define REDEMPTION_WINDOW       8
+
+typedef struct {
+    LogIndex* entry;
+    NVMeRegion region;       // Held mapped until every chunk completes
+    uint32_t chunks_pending;
+    uint32_t generation;     // Engine generation at issue (detects aborts)
+    bool failed;
+    bool acked;
+} RedemptionSlot;
+
+typedef struct {
+    // Log index in file order (the live list is newest-first)
+    LogIndex** ordered;
+    uint32_t ordered_count;
+    uint32_t ordered_capacity;
+    LogIndex* snapshot_head;
+    uint32_t next_issue;
+
+    // Bounded in-flight window, acknowledged strictly in order
+    RedemptionSlot window[REDEMPTION_WINDOW];
+    uint32_t window_head;
+    uint32_t window_count;
+    uint32_t generation;
+
+    // Token bucket rate limiter (bytes)
+    double tokens;
+    uint64_t last_refill_ns;
+
+    // Statistics
+    uint64_t blocks_redeemed;
+    uint64_t bytes_redeemed;
+    uint32_t send_failures;
+} RedemptionEngine;
+
 // Complete SoC model
 struct BlackBoxSoC {
     MemoryModel memory;
@@ -315,10 +428,13 @@ struct BlackBoxSoC {
     // Heterogeneous cores
     APUCore apu;
     RPUCore rpu;
+    CoreRuntime* runtime;        // Set while the cores run as threads (core_runtime.h)
     
     // Sensor management
-    SensorChannel* channels;
-    uint32_t num_channels;
+    ChannelRegistry channels;    // Stable handles, lookup by name (channel_registry.h)
+    SensorGroup* groups;         // Redundant channels fused into one (sensor_fusion.h)
+    uint32_t num_groups;
+    HistoryRollup* history;      // 1 s / 1 min / 1 h rollups of the drained channels (history_rollup.h)
     
     // Event markers & indexing
     EventMarker* markers;
@@ -326,6 +442,7 @@ struct BlackBoxSoC {
     
     // Cloud sync
     CloudSyncState cloud_sync;
+    RedemptionEngine redemption;
     
     // Configuration
     bool verbose;
@@ -0,0 +1,105 @@
+/*
+ * BlackBox DPU - Sensor Channel Registry Implementation
+ */
+
+#include "channel_registry.h"
+
+// FNV-1a over the stored (NUL-terminated, truncated) name
+static uint32_t name_hash(const char* name) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < sizeof(((SensorChannel*)0)->name) && name[i]; i++) {
+        h ^= (uint8_t)name[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void index_insert(uint32_t* index, uint32_t mask, const SensorChannel* channel) {
+    uint32_t slot = name_hash(channel->name) & mask;
+    while (index[slot] != 0) slot = (slot + 1) & mask;
+    index[slot] = channel->channel_id + 1;
+}
+
+// Rebuild the index with slots slots, in handle order so the first channel
+// registered under a name stays the first one found
+static bool index_resize(ChannelRegistry* registry, uint32_t slots) {
+    uint32_t* index = (uint32_t*)calloc(slots, sizeof(uint32_t));
+    if (!index) return false;
+    for (ChannelHandle h = 0; h < registry->count; h++) {
+        index_insert(index, slots - 1, channel_registry_at(registry, h));
+    }
+    free(registry->index);
+    registry->index = index;
+    registry->index_mask = slots - 1;
+    return true;
+}
+
+void channel_registry_init(ChannelRegistry* registry) {
+    memset(registry, 0, sizeof(ChannelRegistry));
+}
+
+void channel_registry_free(ChannelRegistry* registry) {
+    uint32_t used = (registry->count + CHANNEL_REGISTRY_CHUNK - 1) >> CHANNEL_REGISTRY_CHUNK_SHIFT;
+    for (uint32_t c = 0; c < used; c++) free(registry->chunks[c]);
+    free(registry->chunks);
+    free(registry->index);
+    memset(registry, 0, sizeof(ChannelRegistry));
+}
+
+bool channel_registry_reserve(ChannelRegistry* registry, uint32_t count) {
+    uint32_t chunks = (count + CHANNEL_REGISTRY_CHUNK - 1) >> CHANNEL_REGISTRY_CHUNK_SHIFT;
+    if (chunks > registry->chunk_slots) {
+        SensorChannel** grown = (SensorChannel**)realloc(registry->chunks, chunks * sizeof(SensorChannel*));
+        if (!grown) return false;
+        registry->chunks = grown;
+        registry->chunk_slots = chunks;
+    }
+
+    uint32_t slots = registry->index ? registry->index_mask + 1 : CHANNEL_REGISTRY_MIN_INDEX;
+    while (slots < 2 * (uint64_t)count) slots *= 2;
+    if (!registry->index || slots > registry->index_mask + 1) return index_resize(registry, slots);
+    return true;
+}
+
+SensorChannel* channel_registry_append(ChannelRegistry* registry, const char* name) {
+    if (registry->count == CHANNEL_HANDLE_INVALID) return NULL;
+    ChannelHandle handle = registry->count;
+    uint32_t chunk = handle >> CHANNEL_REGISTRY_CHUNK_SHIFT;
+
+    if (chunk >= registry->chunk_slots) {
+        uint32_t slots = registry->chunk_slots ? registry->chunk_slots * 2 : 1;
+        SensorChannel** grown = (SensorChannel**)realloc(registry->chunks, slots * sizeof(SensorChannel*));
+        if (!grown) return NULL;
+        registry->chunks = grown;
+        registry->chunk_slots = slots;
+    }
+    if ((handle & (CHANNEL_REGISTRY_CHUNK - 1)) == 0) {
+        registry->chunks[chunk] = (SensorChannel*)calloc(CHANNEL_REGISTRY_CHUNK, sizeof(SensorChannel));
+        if (!registry->chunks[chunk]) return NULL;
+    }
+    if (!registry->index || 2 * ((uint64_t)handle + 1) > (uint64_t)registry->index_mask + 1) {
+        uint32_t slots = registry->index ? (registry->index_mask + 1) * 2 : CHANNEL_REGISTRY_MIN_INDEX;
+        if (!index_resize(registry, slots)) return NULL;
+    }
+
+    SensorChannel* channel = &registry->chunks[chunk][handle & (CHANNEL_REGISTRY_CHUNK - 1)];
+    channel->channel_id = handle;
+    snprintf(channel->name, sizeof(channel->name), "%s", name);
+    index_insert(registry->index, registry->index_mask, channel);
+    registry->count++;
+    return channel;
+}
+
+ChannelHandle channel_registry_find(const ChannelRegistry* registry, const char* name) {
+    if (!registry->index) return CHANNEL_HANDLE_INVALID;
+
+    // Compare against the name as it would have been stored
+    char key[sizeof(((SensorChannel*)0)->name)];
+    snprintf(key, sizeof(key), "%s", name);
+    for (uint32_t slot = name_hash(key) & registry->index_mask; registry->index[slot] != 0;
+         slot = (slot + 1) & registry->index_mask) {
+        const SensorChannel* channel = channel_registry_at(registry, registry->index[slot] - 1);
+        if (strcmp(channel->name, key) == 0) return channel->channel_id;
+    }
+    return CHANNEL_HANDLE_INVALID;
+}
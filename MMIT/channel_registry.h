@@ -0,0 +1,47 @@
+/*
+ * BlackBox DPU - Sensor Channel Registry
+ * Channel table in fixed-size chunks: a channel never moves once added, so
+ * handles and pointers to it stay valid however many channels follow (e.g.
+ * thousands registered from a CAN decode table). The chunk directory grows
+ * geometrically and a hash index finds channels by name.
+ */
+
+#ifndef CHANNEL_REGISTRY_H
+#define CHANNEL_REGISTRY_H
+
+#include "blackbox_common.h"
+
+#define CHANNEL_REGISTRY_CHUNK_SHIFT    6
+#define CHANNEL_REGISTRY_CHUNK          (1u << CHANNEL_REGISTRY_CHUNK_SHIFT)    // Channels per chunk
+#define CHANNEL_REGISTRY_MIN_INDEX      64      // Hash slots to start with (power of two)
+
+#define CHANNEL_HANDLE_INVALID          UINT32_MAX
+
+/* ============================================================================
+ * CHANNEL REGISTRY FUNCTIONS
+ * ============================================================================ */
+
+void channel_registry_init(ChannelRegistry* registry);
+
+// Frees the table only; the caller releases each channel's own resources
+void channel_registry_free(ChannelRegistry* registry);
+
+// Size the directory and name index for count channels up front
+bool channel_registry_reserve(ChannelRegistry* registry, uint32_t count);
+
+// Append a zeroed channel named name (indexed under that name) and return
+// it, NULL if out of memory. Its handle is registry->count - 1 afterwards.
+SensorChannel* channel_registry_append(ChannelRegistry* registry, const char* name);
+
+// First channel registered under name, CHANNEL_HANDLE_INVALID if none
+ChannelHandle channel_registry_find(const ChannelRegistry* registry, const char* name);
+
+// Channel for a handle, NULL if out of range
+static inline SensorChannel* channel_registry_at(const ChannelRegistry* registry,
+                                                 ChannelHandle handle) {
+    if (handle >= registry->count) return NULL;
+    return &registry->chunks[handle >> CHANNEL_REGISTRY_CHUNK_SHIFT]
+                            [handle & (CHANNEL_REGISTRY_CHUNK - 1)];
+}
+
+#endif // CHANNEL_REGISTRY_H
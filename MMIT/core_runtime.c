@@ -0,0 +1,435 @@
+/*
+ * BlackBox DPU - RPU/APU Core Threads Implementation
+ *
+ * The RPU never waits on the APU: a full handoff queue leaves the samples in
+ * their rings for a later drain, and the APU picks up commands only through
+ * a queue the RPU polls at the top of each tick. Encoded blocks go into a
+ * byte arena in order; a block never wraps (the tail is skipped instead), so
+ * the APU frees space just by publishing how far it has logged.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE                 // CPU affinity
+#endif
+
+#include "core_runtime.h"
+#include "soc_core.h"
+#include "channel_registry.h"
+#include "sample_ring.h"
+
+#ifdef __unix__
+#include <sched.h>
+#include <time.h>
+#endif
+
+#define HANDOFF_LOG_BLOCK   0    // Otherwise 1 + the rollup level
+#define HANDOFF_ALIGN       8
+
+// One encoded block (or run of rollup records) in the arena
+typedef struct {
+    uint64_t ts_start;
+    uint64_t ts_end;
+    uint64_t end;                // log_write just past the block (and any skipped tail)
+    uint32_t offset;
+    uint32_t length;
+    uint32_t kind;
+} LogHandoff;
+
+typedef struct {
+    bool configure;
+    bool is_local;
+    ApuJobFn job;
+    void* user;
+    RpuCommand command;
+} ApuRequest;
+
+void core_runtime_config_defaults(CoreRuntimeConfig* config) {
+    memset(config, 0, sizeof(CoreRuntimeConfig));
+    config->rate_hz = CORE_RUNTIME_RATE_HZ;
+    config->drain_ticks = CORE_RUNTIME_DRAIN_TICKS;
+    config->rpu_cpu = -1;
+    config->apu_cpu = -1;
+    config->rpu_priority = CORE_RUNTIME_RPU_PRIORITY;
+}
+
+static void release_queues(CoreRuntime* runtime) {
+    spsc_ring_free(&runtime->log_queue);
+    spsc_ring_free(&runtime->commands);
+    spsc_ring_free(&runtime->requests);
+    free(runtime->log_arena);
+    runtime->log_arena = NULL;
+}
+
+/* ============================================================================
+ * RPU -> APU LOG HANDOFF
+ * ============================================================================ */
+
+// Blocks start 8-byte aligned, so rollup records can be read in place
+static bool handoff(CoreRuntime* runtime, uint32_t kind, const void* block, uint32_t length,
+                    uint64_t ts_start, uint64_t ts_end) {
+    const uint64_t size = CORE_RUNTIME_LOG_ARENA;
+    if (length == 0 || length > size / 2) return false;
+
+    uint64_t start = (runtime->log_write + HANDOFF_ALIGN - 1) & ~(uint64_t)(HANDOFF_ALIGN - 1);
+    uint64_t offset = start % size;
+    if (offset + length > size) {
+        start += size - offset;
+        offset = 0;
+    }
+    uint64_t end = start + length;
+    uint64_t read = atomic_load_explicit(&runtime->log_read, memory_order_acquire);
+    if (end - read > size) {
+        runtime->handoff_stalls++;
+        return false;
+    }
+
+    memcpy(runtime->log_arena + offset, block, length);
+    LogHandoff entry = {ts_start, ts_end, end, (uint32_t)offset, length, kind};
+    if (!spsc_ring_push(&runtime->log_queue, &entry)) {
+        runtime->handoff_stalls++;
+        return false;
+    }
+    runtime->log_write = end;
+    if (kind == HANDOFF_LOG_BLOCK) runtime->blocks_handed_off++;
+    return true;
+}
+
+bool core_runtime_log_room(CoreRuntime* runtime, uint32_t bytes, uint32_t blocks) {
+    // Worst case: every block pads to alignment and one skips the arena tail
+    uint64_t need = 2 * (uint64_t)bytes + (uint64_t)blocks * HANDOFF_ALIGN;
+    uint64_t read = atomic_load_explicit(&runtime->log_read, memory_order_acquire);
+    uint64_t free_bytes = CORE_RUNTIME_LOG_ARENA - (runtime->log_write - read);
+    if (need <= free_bytes && spsc_ring_depth(&runtime->log_queue) + blocks <= runtime->log_queue.capacity) {
+        return true;
+    }
+    runtime->handoff_stalls++;
+    return false;
+}
+
+bool core_runtime_handoff_log(CoreRuntime* runtime, const uint8_t* block, uint32_t length,
+                              uint64_t ts_start, uint64_t ts_end) {
+    return handoff(runtime, HANDOFF_LOG_BLOCK, block, length, ts_start, ts_end);
+}
+
+bool core_runtime_handoff_rollup(CoreRuntime* runtime, uint32_t level, const HistoryRecord* records,
+                                 uint32_t count) {
+    if (level >= HISTORY_LEVELS) return false;
+    return handoff(runtime, 1 + level, records, count * (uint32_t)sizeof(HistoryRecord),
+                   records[0].start_ns, records[count - 1].start_ns);
+}
+
+#ifdef __unix__
+
+/* ============================================================================
+ * RPU THREAD
+ * ============================================================================ */
+
+static void rpu_apply_commands(CoreRuntime* runtime, uint64_t now_ns) {
+    RpuCommand command;
+    while (spsc_ring_pop(&runtime->commands, &command)) {
+        SensorChannel* ch = channel_registry_at(&runtime->soc->channels, command.channel);
+        if (!ch) continue;
+        if (command.type == RPU_COMMAND_SET_STATE) {
+            sensor_channel_set_state(ch, (ChannelState)command.value, now_ns);
+        } else if (!sensor_channel_set_sample_rate(ch, command.value)) {
+            // A ring is only resized empty: log what it holds first
+            sensor_channels_drain(runtime->soc);
+            if (!sensor_channel_set_sample_rate(ch, command.value)) continue;
+        }
+        runtime->commands_applied++;
+    }
+}
+
+static void* rpu_thread_main(void* arg) {
+    CoreRuntime* runtime = (CoreRuntime*)arg;
+    BlackBoxSoC* soc = runtime->soc;
+    RateScheduler* sched = &runtime->sched;
+
+    // Here, so the timer slack setting applies to this thread
+    rate_scheduler_init(sched, runtime->config.rate_hz);
+
+    uint64_t now_ns = 0;
+    uint64_t ticks = 0;
+    while (!atomic_load_explicit(&runtime->rpu_stop, memory_order_acquire)) {
+        // Measured from the deadline the tick was due at, so an overrun
+        // that skips deadlines shows up in full
+        uint64_t due = sched->next_ns;
+        uint32_t periods = rate_scheduler_wait(sched);
+        uint64_t start = monotonic_ns();
+        uint64_t delay = start > due ? start - due : 0;
+        if (delay > runtime->delay_max_ns) runtime->delay_max_ns = delay;
+        if (delay >= sched->period_ns) runtime->late_ticks++;
+
+        uint64_t period_ns = (uint64_t)periods * sched->sim_period_ns;
+        now_ns += period_ns;
+        rpu_apply_commands(runtime, now_ns);
+        if (runtime->config.sample) {
+            runtime->config.sample(soc, now_ns, period_ns, runtime->config.sample_user);
+        }
+        rpu_monitor_channels(soc, period_ns, now_ns);
+        if (++ticks % runtime->config.drain_ticks == 0) sensor_channels_drain(soc);
+
+        uint64_t work = monotonic_ns() - start;
+        runtime->work_total_ns += work;
+        if (work > runtime->work_max_ns) runtime->work_max_ns = work;
+    }
+
+    // Hand over what is left, waiting out a full queue
+    const struct timespec idle = {0, CORE_RUNTIME_APU_IDLE_NS};
+    while (true) {
+        uint64_t stalls = runtime->handoff_stalls;
+        sensor_channels_drain(soc);
+        if (runtime->handoff_stalls == stalls) break;
+        nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+/* ============================================================================
+ * APU THREAD
+ * ============================================================================ */
+
+static bool apu_log_blocks(CoreRuntime* runtime) {
+    BlackBoxSoC* soc = runtime->soc;
+    LogHandoff entry;
+    bool any = false;
+    while (spsc_ring_pop(&runtime->log_queue, &entry)) {
+        const uint8_t* data = runtime->log_arena + entry.offset;
+        if (entry.kind != HANDOFF_LOG_BLOCK) {
+            uint32_t count = entry.length / (uint32_t)sizeof(HistoryRecord);
+            if (soc->history && history_rollup_store(soc->history, entry.kind - 1, (const HistoryRecord*)data,
+                                                     count)) {
+                runtime->rollups_stored += count;
+            } else {
+                runtime->rollup_failures += count;
+            }
+        } else if (blackbox_log_block(soc, data, entry.length, entry.ts_start, entry.ts_end, NULL)) {
+            runtime->blocks_logged++;
+        } else {
+            runtime->log_failures++;
+        }
+        atomic_store_explicit(&runtime->log_read, entry.end, memory_order_release);
+        any = true;
+    }
+    return any;
+}
+
+static void apu_run_request(CoreRuntime* runtime, const ApuRequest* request) {
+    BlackBoxSoC* soc = runtime->soc;
+    if (!request->configure) {
+        request->job(soc, request->user);
+        runtime->jobs_run++;
+        return;
+    }
+    // A full command queue refuses the change like a failed validation
+    if (!apu_validate_config_request(&soc->apu, request->is_local) ||
+        !spsc_ring_push(&runtime->commands, &request->command)) {
+        runtime->commands_rejected++;
+    }
+}
+
+static void* apu_thread_main(void* arg) {
+    CoreRuntime* runtime = (CoreRuntime*)arg;
+    const struct timespec idle = {0, CORE_RUNTIME_APU_IDLE_NS};
+
+    while (true) {
+        // Sampled first: an idle pass after the stop request has seen
+        // everything queued before it
+        bool stopping = atomic_load_explicit(&runtime->apu_stop, memory_order_acquire);
+        bool busy = apu_log_blocks(runtime);
+
+        // One request per pass, so logging keeps up between long jobs
+        ApuRequest request;
+        if (spsc_ring_pop(&runtime->requests, &request)) {
+            apu_run_request(runtime, &request);
+            busy = true;
+        }
+        runtime->soc->apu.pending_queries = (uint32_t)spsc_ring_depth(&runtime->requests);
+
+        if (!busy && stopping) break;
+        if (!busy) nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+/* ============================================================================
+ * THREAD PLACEMENT
+ * ============================================================================ */
+
+#ifdef __linux__
+// The RPU gets a CPU of its own (the last allowed one by default) and the
+// APU the rest; with a single CPU they share it
+static bool choose_cpus(CoreRuntime* runtime, cpu_set_t* rpu_cpus, cpu_set_t* apu_cpus) {
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return false;
+
+    int rpu = runtime->config.rpu_cpu;
+    if (rpu < 0 || rpu >= CPU_SETSIZE || !CPU_ISSET(rpu, &allowed)) {
+        rpu = -1;
+        for (int c = 0; c < CPU_SETSIZE; c++) {
+            if (CPU_ISSET(c, &allowed)) rpu = c;
+        }
+    }
+    if (rpu < 0) return false;
+    CPU_ZERO(rpu_cpus);
+    CPU_SET(rpu, rpu_cpus);
+
+    int apu = runtime->config.apu_cpu;
+    if (apu >= 0 && apu < CPU_SETSIZE && CPU_ISSET(apu, &allowed)) {
+        CPU_ZERO(apu_cpus);
+        CPU_SET(apu, apu_cpus);
+    } else {
+        *apu_cpus = allowed;
+        if (CPU_COUNT(&allowed) > 1) CPU_CLR(rpu, apu_cpus);
+    }
+    runtime->shared_cpu = CPU_ISSET(rpu, apu_cpus);
+    return true;
+}
+#endif
+
+static int create_thread(pthread_t* thread, void* (*main_fn)(void*), void* arg,
+                         const void* cpus, int priority) {
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+#ifdef __linux__
+    if (cpus) pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), (const cpu_set_t*)cpus);
+#else
+    (void)cpus;
+#endif
+    if (priority > 0) {
+        int max = sched_get_priority_max(SCHED_FIFO);
+        struct sched_param param = {.sched_priority = priority < max ? priority : max};
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+    }
+    int rc = pthread_create(thread, &attr, main_fn, arg);
+    pthread_attr_destroy(&attr);
+    return rc;
+}
+
+// Try pinned and real-time, then drop what is not permitted (SCHED_FIFO
+// needs CAP_SYS_NICE or an RLIMIT_RTPRIO allowance)
+static bool start_thread(pthread_t* thread, void* (*main_fn)(void*), void* arg,
+                         const void* cpus, int priority, bool* realtime, bool* pinned) {
+    *realtime = priority > 0 && create_thread(thread, main_fn, arg, cpus, priority) == 0;
+    *pinned = cpus && (*realtime || create_thread(thread, main_fn, arg, cpus, 0) == 0);
+    return *realtime || *pinned || create_thread(thread, main_fn, arg, NULL, 0) == 0;
+}
+
+#endif // __unix__
+
+/* ============================================================================
+ * LIFECYCLE
+ * ============================================================================ */
+
+bool core_runtime_start(CoreRuntime* runtime, BlackBoxSoC* soc, const CoreRuntimeConfig* config) {
+    memset(runtime, 0, sizeof(CoreRuntime));
+#ifdef __unix__
+    runtime->soc = soc;
+    runtime->config = *config;
+    if (runtime->config.drain_ticks == 0) runtime->config.drain_ticks = 1;
+    atomic_init(&runtime->log_read, 0);
+    atomic_init(&runtime->rpu_stop, false);
+    atomic_init(&runtime->apu_stop, false);
+
+    runtime->log_arena = (uint8_t*)malloc(CORE_RUNTIME_LOG_ARENA);
+    bool queues = spsc_ring_init(&runtime->log_queue, sizeof(LogHandoff), CORE_RUNTIME_LOG_QUEUE, SPSC_DROP_NEWEST) &&
+                  spsc_ring_init(&runtime->commands, sizeof(RpuCommand), CORE_RUNTIME_COMMAND_QUEUE, SPSC_DROP_NEWEST) &&
+                  spsc_ring_init(&runtime->requests, sizeof(ApuRequest), CORE_RUNTIME_REQUEST_QUEUE, SPSC_DROP_NEWEST);
+    if (!runtime->log_arena || !queues) {
+        release_queues(runtime);
+        return false;
+    }
+
+    const void* rpu_cpus = NULL;
+    const void* apu_cpus = NULL;
+#ifdef __linux__
+    cpu_set_t rpu_set, apu_set;
+    if (choose_cpus(runtime, &rpu_set, &apu_set)) {
+        rpu_cpus = &rpu_set;
+        apu_cpus = &apu_set;
+    }
+#endif
+
+    // Drains hand their blocks to the APU from here on
+    soc->runtime = runtime;
+    bool apu_realtime, apu_pinned, rpu_pinned;
+    if (!start_thread(&runtime->apu_thread, apu_thread_main, runtime, apu_cpus, 0,
+                      &apu_realtime, &apu_pinned)) {
+        soc->runtime = NULL;
+        release_queues(runtime);
+        return false;
+    }
+    if (!start_thread(&runtime->rpu_thread, rpu_thread_main, runtime, rpu_cpus,
+                      runtime->config.rpu_priority, &runtime->realtime, &rpu_pinned)) {
+        atomic_store_explicit(&runtime->apu_stop, true, memory_order_release);
+        pthread_join(runtime->apu_thread, NULL);
+        soc->runtime = NULL;
+        release_queues(runtime);
+        return false;
+    }
+    runtime->pinned = apu_pinned && rpu_pinned;
+    runtime->running = true;
+    soc->rpu.running = true;
+    return true;
+#else
+    // No threads: the caller runs the cores inline
+    (void)soc;
+    (void)config;
+    return false;
+#endif
+}
+
+void core_runtime_stop(CoreRuntime* runtime) {
+    if (!runtime->running) return;
+#ifdef __unix__
+    atomic_store_explicit(&runtime->rpu_stop, true, memory_order_release);
+    pthread_join(runtime->rpu_thread, NULL);
+    atomic_store_explicit(&runtime->apu_stop, true, memory_order_release);
+    pthread_join(runtime->apu_thread, NULL);
+#endif
+    runtime->soc->rpu.running = false;
+    runtime->soc->runtime = NULL;
+    runtime->running = false;
+    release_queues(runtime);
+}
+
+bool core_runtime_submit(CoreRuntime* runtime, ApuJobFn job, void* user) {
+    if (!runtime->running || !job) return false;
+    ApuRequest request = {.configure = false, .job = job, .user = user};
+    return spsc_ring_push(&runtime->requests, &request);
+}
+
+bool core_runtime_configure(CoreRuntime* runtime, const RpuCommand* command, bool is_local) {
+    if (!runtime->running) return false;
+    ApuRequest request = {.configure = true, .is_local = is_local, .command = *command};
+    return spsc_ring_push(&runtime->requests, &request);
+}
+
+void core_runtime_get_stats(const CoreRuntime* runtime, CoreRuntimeStats* stats) {
+    memset(stats, 0, sizeof(CoreRuntimeStats));
+    RateSchedulerStats sched;
+    rate_scheduler_get_stats(&runtime->sched, &sched);
+
+    stats->ticks = sched.ticks;
+    stats->missed = sched.missed;
+    stats->late_ticks = runtime->late_ticks;
+    stats->delay_max_us = runtime->delay_max_ns / 1000.0;
+    stats->jitter_p50_us = sched.jitter_p50_us;
+    stats->jitter_p99_us = sched.jitter_p99_us;
+    stats->work_mean_us = sched.ticks ? runtime->work_total_ns / 1000.0 / sched.ticks : 0.0;
+    stats->work_max_us = runtime->work_max_ns / 1000.0;
+    stats->blocks_handed_off = runtime->blocks_handed_off;
+    stats->handoff_stalls = runtime->handoff_stalls;
+    stats->blocks_logged = runtime->blocks_logged;
+    stats->log_failures = runtime->log_failures;
+    stats->rollups_stored = runtime->rollups_stored;
+    stats->rollup_failures = runtime->rollup_failures;
+    stats->jobs_run = runtime->jobs_run;
+    stats->commands_applied = runtime->commands_applied;
+    stats->commands_rejected = runtime->commands_rejected;
+    stats->realtime = runtime->realtime;
+    stats->pinned = runtime->pinned;
+    stats->shared_cpu = runtime->shared_cpu;
+}
@@ -0,0 +1,172 @@
+/*
+ * BlackBox DPU - RPU/APU Core Threads
+ * Runs the RPU real-time path (sampling, health, DSP) on its own pinned,
+ * SCHED_FIFO (where permitted) thread at a fixed rate, and the APU path
+ * (logging pipeline, queries, cloud transfer, configuration) on another.
+ * They meet only through lock-free SPSC queues, so nothing the APU does can
+ * hold up a sampling tick.
+ *
+ * Only --bench-cores starts the runtime so far. Live streaming, replay,
+ * queries and cloud transfer/redemption still run on the main loop, and
+ * streaming records through the telemetry packer, not the channel rings.
+ */
+
+#ifndef CORE_RUNTIME_H
+#define CORE_RUNTIME_H
+
+#include "blackbox_common.h"
+#include "spsc_ring.h"
+#include "rate_scheduler.h"
+#include "history_rollup.h"
+
+#ifdef __unix__
+#include <pthread.h>
+#endif
+
+#define CORE_RUNTIME_RATE_HZ        1000
+#define CORE_RUNTIME_DRAIN_TICKS    50      // Ticks between drains of the sample rings
+#define CORE_RUNTIME_RPU_PRIORITY   80      // SCHED_FIFO priority of the RPU thread
+// Bytes of encoded blocks in flight from the RPU to the APU; holds at least
+// two blocks of BLACKBOX_LOG_BLOCK_MAX
+#define CORE_RUNTIME_LOG_ARENA      (4 * 1024 * 1024)
+#define CORE_RUNTIME_LOG_QUEUE      1024    // Blocks in flight
+#define CORE_RUNTIME_COMMAND_QUEUE  256
+#define CORE_RUNTIME_REQUEST_QUEUE  64
+#define CORE_RUNTIME_APU_IDLE_NS    200000  // APU poll interval when idle
+
+// Fill the channel rings with the samples of one tick: the period_ns of
+// simulated time ending at now_ns. Runs on the RPU thread.
+typedef void (*RpuSampleFn)(BlackBoxSoC* soc, uint64_t now_ns, uint64_t period_ns, void* user);
+
+// APU work item (a query, a cloud transfer). Runs on the APU thread.
+typedef void (*ApuJobFn)(BlackBoxSoC* soc, void* user);
+
+typedef enum {
+    RPU_COMMAND_SET_STATE,       // value = ChannelState
+    RPU_COMMAND_SET_SAMPLE_RATE  // value = Hz
+} RpuCommandType;
+
+typedef struct {
+    RpuCommandType type;
+    ChannelHandle channel;
+    uint32_t value;
+} RpuCommand;
+
+typedef struct {
+    uint32_t rate_hz;            // RPU tick rate (rate_scheduler.h limits)
+    uint32_t drain_ticks;
+    int rpu_cpu;                 // CPU to pin to, -1 = last allowed CPU
+    int apu_cpu;                 // -1 = every allowed CPU but the RPU's
+    int rpu_priority;            // SCHED_FIFO priority, 0 = normal scheduling
+    RpuSampleFn sample;
+    void* sample_user;
+} CoreRuntimeConfig;
+
+typedef struct {
+    uint64_t ticks;
+    uint64_t missed;             // Deadlines skipped by overrunning ticks
+    uint64_t late_ticks;         // Ticks that started a period or more late
+    double delay_max_us;         // Worst start past the deadline, overruns included
+    double jitter_p50_us;        // Wake-up lateness (rate_scheduler.h)
+    double jitter_p99_us;
+    double work_mean_us;         // RPU time per tick
+    double work_max_us;
+    uint64_t blocks_handed_off;
+    uint64_t handoff_stalls;     // Handoffs put off by a full queue (the samples stay in their rings)
+    uint64_t blocks_logged;
+    uint64_t log_failures;
+    uint64_t rollups_stored;
+    uint64_t rollup_failures;    // Rollup records the side files refused, dropped
+    uint64_t jobs_run;
+    uint64_t commands_applied;
+    uint64_t commands_rejected;  // Refused by apu_validate_config_request
+    bool realtime;               // RPU got SCHED_FIFO
+    bool pinned;                 // Both threads pinned
+    bool shared_cpu;             // Only one CPU: the cores take turns on it
+} CoreRuntimeStats;
+
+struct CoreRuntime {
+    BlackBoxSoC* soc;
+    CoreRuntimeConfig config;
+
+    // RPU -> APU: encoded blocks, packed back to back into the arena
+    SpscRing log_queue;
+    uint8_t* log_arena;
+    uint64_t log_write;                  // RPU-owned, free-running
+    _Alignas(SPSC_CACHE_LINE) _Atomic uint64_t log_read;    // APU-owned
+
+    SpscRing commands;           // APU -> RPU, validated configuration
+    SpscRing requests;           // Caller -> APU: jobs and configuration
+
+    _Atomic bool rpu_stop;
+    _Atomic bool apu_stop;
+    bool running;
+#ifdef __unix__
+    pthread_t rpu_thread;
+    pthread_t apu_thread;
+#endif
+
+    // RPU-owned timing
+    RateScheduler sched;
+    uint64_t late_ticks;
+    uint64_t delay_max_ns;
+    uint64_t work_total_ns;
+    uint64_t work_max_ns;
+
+    uint64_t blocks_handed_off;
+    uint64_t handoff_stalls;
+    uint64_t commands_applied;
+    uint64_t blocks_logged;      // APU-owned
+    uint64_t log_failures;
+    uint64_t rollups_stored;
+    uint64_t rollup_failures;
+    uint64_t jobs_run;
+    uint64_t commands_rejected;
+    bool realtime;
+    bool pinned;
+    bool shared_cpu;
+};
+
+/* ============================================================================
+ * CORE RUNTIME FUNCTIONS
+ * ============================================================================ */
+
+void core_runtime_config_defaults(CoreRuntimeConfig* config);
+
+// Start both cores. Channels and groups must be registered first: while the
+// cores run, the RPU owns the channels and the APU owns the rest of the SoC,
+// so the caller touches neither. Returns false (nothing started) where
+// threads are unavailable; the caller then runs the cores inline.
+bool core_runtime_start(CoreRuntime* runtime, BlackBoxSoC* soc, const CoreRuntimeConfig* config);
+
+// Stop the RPU (after a final drain), then the APU once it has logged every
+// block and run every request queued before the call
+void core_runtime_stop(CoreRuntime* runtime);
+
+// Queue work for the APU. Single producer: call from one thread only.
+// Returns false if the request queue is full.
+bool core_runtime_submit(CoreRuntime* runtime, ApuJobFn job, void* user);
+
+// Queue a configuration change; the APU validates it (local-first, see
+// apu_validate_config_request) and the RPU applies it at its next tick.
+// Same producer rule as core_runtime_submit.
+bool core_runtime_configure(CoreRuntime* runtime, const RpuCommand* command, bool is_local);
+
+// RPU side of logging: whether blocks encoded blocks of at most bytes in
+// total would all be taken now. Checked before samples leave their rings;
+// a refusal counts as a stall.
+bool core_runtime_log_room(CoreRuntime* runtime, uint32_t bytes, uint32_t blocks);
+
+// RPU side of logging: copy an encoded block into the arena for the APU.
+// Returns false (nothing queued) when the arena or queue is full.
+bool core_runtime_handoff_log(CoreRuntime* runtime, const uint8_t* block, uint32_t length,
+                              uint64_t ts_start, uint64_t ts_end);
+
+// Same for closed history rollups of one level, stored by the APU
+bool core_runtime_handoff_rollup(CoreRuntime* runtime, uint32_t level, const HistoryRecord* records,
+                                 uint32_t count);
+
+// Call once stopped
+void core_runtime_get_stats(const CoreRuntime* runtime, CoreRuntimeStats* stats);
+
+#endif // CORE_RUNTIME_H
@@ -0,0 +1,279 @@
+/*
+ * BlackBox DPU - Vectorized Fleet Drive Kernel Implementation
+ *
+ * Same model as realistic_drive_sim.c, restated so one loop body serves
+ * every vehicle: the driving mode comes from the shared clock, so it only
+ * selects constants (DriveModeParams), and per-vehicle choices become
+ * selects instead of branches. Every lane draws the same number of random
+ * values per step, which keeps a seeded run identical regardless of the
+ * mode schedule, vector width or how the fleet is sharded.
+ */
+
+#include "drive_fleet.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Targets: take the first set with probability p_first, else the second.
+// Speed uses the first draw; throttle and brake share the second.
+typedef struct {
+    float p_first;
+    float speed_base[2], speed_span[2];
+    float throttle_base[2], throttle_span[2];
+    float brake_base[2], brake_span[2];
+    float fuel_per_kph_s;        // Litres per second per km/h
+    float fuel_idle_s;           // Litres per second regardless of speed
+    float temp_base, temp_per_rpm;
+    float battery_base, battery_per_rpm;
+} DriveModeParams;
+
+static const DriveModeParams drive_modes[3] = {
+    // City: 30% stopped or slowing, otherwise accelerating or cruising
+    { 0.30f, {0, 30}, {30, 30}, {0, 20}, {0, 30}, {20, 0}, {40, 0},
+      10.0f / 100.0f / 3600.0f, 0.0f, 85.0f, 0.01f, 12.4f, 1.8f / 7000.0f },
+    // Highway: steady cruise, 10% slowdowns for traffic
+    { 0.10f, {70, 100}, {20, 20}, {10, 30}, {10, 15}, {0, 0}, {0, 0},
+      6.0f / 100.0f / 3600.0f, 0.0f, 85.0f, 0.01f, 12.4f, 1.8f / 7000.0f },
+    // Idle at a rest stop
+    { 0.0f, {0, 0}, {0, 0}, {0, 0}, {0, 0}, {100, 100}, {0, 0},
+      0.0f, 0.8f / 3600.0f, 75.0f, 0.0f, 12.2f, 0.0f },
+};
+
+// Assume 50L tank capacity
+#define DRIVE_TANK_LITRES   50.0f
+
+typedef struct {
+    uint32_t s0, s1, s2, s3;
+} Xoshiro128;
+
+// xoshiro128+ step, top 24 bits as a float in [0, 1)
+static inline float xoshiro_uniform(Xoshiro128* x) {
+    uint32_t result = x->s0 + x->s3;
+    uint32_t t = x->s1 << 9;
+    x->s2 ^= x->s0;
+    x->s3 ^= x->s1;
+    x->s1 ^= x->s2;
+    x->s0 ^= x->s3;
+    x->s2 ^= t;
+    x->s3 = (x->s3 << 11) | (x->s3 >> 21);
+    return (float)(result >> 8) * (1.0f / 16777216.0f);
+}
+
+static inline float approach(float current, float target, float rate) {
+    float diff = target - current;
+    diff = diff > rate ? rate : diff;
+    diff = diff < -rate ? -rate : diff;
+    return current + diff;
+}
+
+// splitmix64, spreads consecutive seeds into unrelated streams
+static uint64_t splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+bool drive_fleet_init(DriveFleet* fleet, uint32_t count, uint64_t seed) {
+    memset(fleet, 0, sizeof(DriveFleet));
+    if (count == 0) return false;
+
+    uint32_t stride = (count + DRIVE_FLEET_LANES - 1) / DRIVE_FLEET_LANES * DRIVE_FLEET_LANES;
+    const uint32_t arrays = 17;
+    size_t bytes = (size_t)stride * sizeof(float) * arrays;
+    uint8_t* block = (uint8_t*)aligned_alloc(DRIVE_FLEET_ALIGN, bytes);
+    if (!block) return false;
+
+    // stride is a whole number of cache lines, so every array stays aligned
+    size_t step = (size_t)stride * sizeof(float);
+    fleet->block = block;
+    fleet->speed_kph = (float*)(block + 0 * step);
+    fleet->throttle_pct = (float*)(block + 1 * step);
+    fleet->brake_pct = (float*)(block + 2 * step);
+    fleet->rpm = (float*)(block + 3 * step);
+    fleet->engine_temp_c = (float*)(block + 4 * step);
+    fleet->fuel_level_pct = (float*)(block + 5 * step);
+    fleet->battery_voltage = (float*)(block + 6 * step);
+    fleet->gear = (int32_t*)(block + 7 * step);
+    fleet->rng0 = (uint32_t*)(block + 8 * step);
+    fleet->rng1 = (uint32_t*)(block + 9 * step);
+    fleet->rng2 = (uint32_t*)(block + 10 * step);
+    fleet->rng3 = (uint32_t*)(block + 11 * step);
+    fleet->out_speed_kph = (float*)(block + 12 * step);
+    fleet->out_engine_temp_c = (float*)(block + 13 * step);
+    fleet->out_battery_voltage = (float*)(block + 14 * step);
+    fleet->out_humidity_pct = (float*)(block + 15 * step);
+    fleet->out_wheel_kph = (float*)(block + 16 * step);
+    memset(block, 0, bytes);
+
+    fleet->count = count;
+    fleet->stride = stride;
+    fleet->elapsed_hours = 0.0;
+    fleet->driving_mode = 0;            // Start in city mode
+    fleet->ambient_temp_c = 25.0f;
+
+    // Padding lanes are simulated too (keeps the loops remainder-free)
+    for (uint32_t i = 0; i < stride; i++) {
+        fleet->fuel_level_pct[i] = 100.0f;     // Full tank
+        fleet->engine_temp_c[i] = 25.0f;       // Ambient start
+        fleet->battery_voltage[i] = 12.6f;     // Fully charged
+        fleet->rpm[i] = 800.0f;                // Idle RPM
+
+        uint64_t sm = seed + i;
+        uint64_t a = splitmix64(&sm);
+        uint64_t b = splitmix64(&sm);
+        fleet->rng0[i] = (uint32_t)a;
+        fleet->rng1[i] = (uint32_t)(a >> 32);
+        fleet->rng2[i] = (uint32_t)b;
+        fleet->rng3[i] = (uint32_t)(b >> 32);
+        if ((a | b) == 0) fleet->rng0[i] = 1;
+    }
+    return true;
+}
+
+void drive_fleet_free(DriveFleet* fleet) {
+    free(fleet->block);
+    memset(fleet, 0, sizeof(DriveFleet));
+}
+
+void drive_fleet_step(DriveFleet* fleet, double delta_seconds) {
+    fleet->elapsed_hours += delta_seconds / 3600.0;
+
+    // Hours 0-2 city, 2-7 highway, 7-7.5 rest stop, 7.5-10 city back
+    double hour = fmod(fleet->elapsed_hours, 10.0);
+    fleet->driving_mode = hour < 2.0 ? 0 : hour < 7.0 ? 1 : hour < 7.5 ? 2 : 0;
+
+    // Ambient temperature - simulate day/night cycle
+    double time_of_day = fmod(fleet->elapsed_hours, 24.0);
+    fleet->ambient_temp_c = (float)(20.0 + 10.0 * sin((time_of_day / 24.0) * 2 * M_PI - M_PI / 2));
+
+    const DriveModeParams m = drive_modes[fleet->driving_mode];
+    const float dt = (float)delta_seconds;
+    const float humidity_base = 50.0f + (fleet->ambient_temp_c - 20.0f) * 1.5f;
+    const float fuel_scale = dt / DRIVE_TANK_LITRES * 100.0f;
+
+    // Second target set plus weight * (first - second)
+    const float speed_base = m.speed_base[1], speed_base_d = m.speed_base[0] - m.speed_base[1];
+    const float speed_span = m.speed_span[1], speed_span_d = m.speed_span[0] - m.speed_span[1];
+    const float throttle_base = m.throttle_base[1];
+    const float throttle_base_d = m.throttle_base[0] - m.throttle_base[1];
+    const float throttle_span = m.throttle_span[1];
+    const float throttle_span_d = m.throttle_span[0] - m.throttle_span[1];
+    const float brake_base = m.brake_base[1], brake_base_d = m.brake_base[0] - m.brake_base[1];
+    const float brake_span = m.brake_span[1], brake_span_d = m.brake_span[0] - m.brake_span[1];
+
+    float* restrict speed = __builtin_assume_aligned(fleet->speed_kph, DRIVE_FLEET_ALIGN);
+    float* restrict throttle = __builtin_assume_aligned(fleet->throttle_pct, DRIVE_FLEET_ALIGN);
+    float* restrict brake = __builtin_assume_aligned(fleet->brake_pct, DRIVE_FLEET_ALIGN);
+    float* restrict rpm = __builtin_assume_aligned(fleet->rpm, DRIVE_FLEET_ALIGN);
+    float* restrict temp = __builtin_assume_aligned(fleet->engine_temp_c, DRIVE_FLEET_ALIGN);
+    float* restrict fuel = __builtin_assume_aligned(fleet->fuel_level_pct, DRIVE_FLEET_ALIGN);
+    float* restrict battery = __builtin_assume_aligned(fleet->battery_voltage, DRIVE_FLEET_ALIGN);
+    int32_t* restrict gear = __builtin_assume_aligned(fleet->gear, DRIVE_FLEET_ALIGN);
+    uint32_t* restrict r0 = __builtin_assume_aligned(fleet->rng0, DRIVE_FLEET_ALIGN);
+    uint32_t* restrict r1 = __builtin_assume_aligned(fleet->rng1, DRIVE_FLEET_ALIGN);
+    uint32_t* restrict r2 = __builtin_assume_aligned(fleet->rng2, DRIVE_FLEET_ALIGN);
+    uint32_t* restrict r3 = __builtin_assume_aligned(fleet->rng3, DRIVE_FLEET_ALIGN);
+    float* restrict out_speed = __builtin_assume_aligned(fleet->out_speed_kph, DRIVE_FLEET_ALIGN);
+    float* restrict out_temp = __builtin_assume_aligned(fleet->out_engine_temp_c, DRIVE_FLEET_ALIGN);
+    float* restrict out_battery = __builtin_assume_aligned(fleet->out_battery_voltage, DRIVE_FLEET_ALIGN);
+    float* restrict out_humidity = __builtin_assume_aligned(fleet->out_humidity_pct, DRIVE_FLEET_ALIGN);
+    float* restrict out_wheel = __builtin_assume_aligned(fleet->out_wheel_kph, DRIVE_FLEET_ALIGN);
+    const uint32_t n = fleet->stride & ~(uint32_t)(DRIVE_FLEET_LANES - 1);
+
+    // Every array is a separate slice of one block: no lane depends on another
+#pragma GCC ivdep
+    for (uint32_t i = 0; i < n; i++) {
+        Xoshiro128 x = { r0[i], r1[i], r2[i], r3[i] };
+        float u_choice = xoshiro_uniform(&x);
+        float u_speed = xoshiro_uniform(&x);
+        float u_pedal = xoshiro_uniform(&x);
+        float u_humidity = xoshiro_uniform(&x);
+        float u_wheel = xoshiro_uniform(&x);
+        float u_speed_noise = xoshiro_uniform(&x);
+        float u_temp_noise = xoshiro_uniform(&x);
+        float u_battery_noise = xoshiro_uniform(&x);
+        r0[i] = x.s0;
+        r1[i] = x.s1;
+        r2[i] = x.s2;
+        r3[i] = x.s3;
+
+        // Mode targets. Choices are 0/1 weights: ?: between two computed
+        // values turns back into branches, and the loop stops vectorizing.
+        float w = (float)(u_choice < m.p_first);
+        float target_speed = speed_base + speed_base_d * w + (speed_span + speed_span_d * w) * u_speed;
+        float target_throttle = throttle_base + throttle_base_d * w +
+                                (throttle_span + throttle_span_d * w) * u_pedal;
+        float target_brake = brake_base + brake_base_d * w + (brake_span + brake_span_d * w) * u_pedal;
+
+        // Smooth transitions
+        float s = approach(speed[i], target_speed, dt * 2.0f);
+        float thr = approach(throttle[i], target_throttle, dt * 10.0f);
+        speed[i] = s;
+        throttle[i] = thr;
+        brake[i] = approach(brake[i], target_brake, dt * 15.0f);
+
+        // Gear from speed bands, RPM from speed and gear
+        int32_t g = (s >= 5.0f) + (s >= 20.0f) + (s >= 40.0f) + (s >= 60.0f) +
+                    (s >= 80.0f) + (s >= 100.0f);
+        float gf = (float)(g > 0 ? g : 1);
+        float in_gear = (float)(g != 0);
+        float r = 800.0f + 200.0f * in_gear + (s / gf) * (40.0f * in_gear) +
+                  thr * (20.0f - 10.0f * in_gear);
+        r = r < 600.0f ? 600.0f : r;
+        r = r > 7000.0f ? 7000.0f : r;
+        gear[i] = g;
+        rpm[i] = r;
+
+        // Engine heats above 3000 RPM, battery charges with RPM
+        float hot = r - 3000.0f;
+        hot = hot > 0.0f ? hot : 0.0f;
+        float t = approach(temp[i], m.temp_base + hot * m.temp_per_rpm, dt * 0.5f);
+        float b = approach(battery[i], m.battery_base + r * m.battery_per_rpm, dt * 0.1f);
+        temp[i] = t;
+        battery[i] = b;
+
+        float f = fuel[i] - (s * m.fuel_per_kph_s + m.fuel_idle_s) * fuel_scale;
+        fuel[i] = f < 0.0f ? 0.0f : f;
+
+        // Sensor readings with noise
+        float h = humidity_base + (u_humidity * 10.0f - 5.0f);
+        h = h < 20.0f ? 20.0f : h;
+        out_humidity[i] = h > 90.0f ? 90.0f : h;
+        out_wheel[i] = s + (u_wheel - 0.5f);
+        out_speed[i] = s + (u_speed_noise - 0.5f);
+        out_temp[i] = t + (u_temp_noise * 0.6f - 0.3f);
+        out_battery[i] = b + (u_battery_noise * 0.1f - 0.05f);
+    }
+}
+
+void drive_fleet_packet(const DriveFleet* fleet, uint32_t vehicle, MMITTelemetryPacket* packet) {
+    uint32_t i = vehicle;
+    packet->speed_kph = fleet->out_speed_kph[i];
+    packet->rpm = fleet->rpm[i];
+    packet->throttle_pct = fleet->throttle_pct[i];
+    packet->brake_pct = fleet->brake_pct[i];
+    packet->gear = fleet->gear[i];
+    packet->battery_voltage = fleet->out_battery_voltage[i];
+    packet->engine_temp_c = fleet->out_engine_temp_c[i];
+    packet->fuel_level_pct = fleet->fuel_level_pct[i];
+    packet->ambient_temp_c = fleet->ambient_temp_c;
+
+    // GPS (simulate movement)
+    packet->gps_lat = (float)(37.7749 + fleet->elapsed_hours * 0.01);
+    packet->gps_lon = (float)(-122.4194 + fleet->elapsed_hours * 0.01);
+
+    packet->humidity_pct = fleet->out_humidity_pct[i];
+    packet->wheel_fl = fleet->out_wheel_kph[i];
+    packet->wheel_fr = fleet->out_wheel_kph[i];
+    packet->wheel_rl = fleet->out_wheel_kph[i];
+    packet->wheel_rr = fleet->out_wheel_kph[i];
+
+    // System stats are the caller's
+    packet->cpu_usage_pct = 0.0f;
+    packet->ram_usage_pct = 0.0f;
+    packet->network_latency_ms = 0.0f;
+
+    packet->abs_active = false;
+    packet->traction_control = true;
+}
@@ -0,0 +1,69 @@
+/*
+ * BlackBox DPU - Vectorized Fleet Drive Kernel
+ * The realistic drive model for many vehicles at once: structure-of-arrays
+ * state, one xoshiro128+ stream per lane, branch-free update loops the
+ * compiler turns into SIMD
+ */
+
+#ifndef DRIVE_FLEET_H
+#define DRIVE_FLEET_H
+
+#include "telemetry_sender.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Arrays are padded to a whole number of vectors and cache-line aligned
+#define DRIVE_FLEET_LANES       16
+#define DRIVE_FLEET_ALIGN       64
+
+typedef struct {
+    uint32_t count;              // Vehicles
+    uint32_t stride;             // count rounded up to DRIVE_FLEET_LANES
+    double elapsed_hours;        // Shared clock: every vehicle steps together
+    int driving_mode;            // 0=city, 1=highway, 2=idle (from the clock)
+    float ambient_temp_c;        // Same sky for the whole fleet
+
+    // Model state, one element per vehicle
+    float* speed_kph;
+    float* throttle_pct;
+    float* brake_pct;
+    float* rpm;
+    float* engine_temp_c;
+    float* fuel_level_pct;
+    float* battery_voltage;
+    int32_t* gear;
+
+    // xoshiro128+ state, one 128-bit stream per vehicle
+    uint32_t* rng0;
+    uint32_t* rng1;
+    uint32_t* rng2;
+    uint32_t* rng3;
+
+    // Sensor readings of the last step (model state plus noise)
+    float* out_speed_kph;
+    float* out_engine_temp_c;
+    float* out_battery_voltage;
+    float* out_humidity_pct;
+    float* out_wheel_kph;
+
+    void* block;
+} DriveFleet;
+
+/* ============================================================================
+ * FLEET DRIVE FUNCTIONS
+ * ============================================================================ */
+
+// Start count vehicles: full tank, cold engine, city traffic. Vehicle i
+// draws from a stream seeded with seed + i, so a vehicle drives the same
+// whichever fleet or shard it is part of.
+bool drive_fleet_init(DriveFleet* fleet, uint32_t count, uint64_t seed);
+void drive_fleet_free(DriveFleet* fleet);
+
+// Advance every vehicle by delta_seconds
+void drive_fleet_step(DriveFleet* fleet, double delta_seconds);
+
+// Copy one vehicle's readings from the last step into a packet
+// (vehicle_id and timestamp_ns are left to the caller)
+void drive_fleet_packet(const DriveFleet* fleet, uint32_t vehicle, MMITTelemetryPacket* packet);
+
+#endif // DRIVE_FLEET_H
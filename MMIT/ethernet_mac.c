@@ -11,35 +11,122 @@
  * ETHERNET MAC MODEL
  * ============================================================================ */
 
-void ethernet_transmit_data(BlackBoxSoC* soc) {
+static void ethernet_backup_frame(const uint8_t* src, uint32_t length) {
+    // Also keep local backup file for redundancy
+    FILE* cloud_log = fopen("cloud_log.bin", "ab");
+    if (cloud_log) {
+        fwrite(src, 1, length, cloud_log);
+        fclose(cloud_log);
+    }
+}
+
+static void ethernet_account_tx(BlackBoxSoC* soc, uint32_t length, bool success) {
     EthernetMAC* eth = &soc->eth_mac;
     
-    uint8_t* src = memory_translate(&soc->memory, eth->tx_buf_addr);
-    if (!src) return;
-    
-    // REAL network transmission via HTTP POST to laptop
-    bool success = network_send_data(src, eth->tx_buf_len);
-    
     if (success) {
-        eth->bytes_transmitted += eth->tx_buf_len;
+        eth->bytes_transmitted += length;
         eth->packets_transmitted++;
-        soc->noc_stats.ethernet_path_bytes += eth->tx_buf_len;
+        soc->noc_stats.ethernet_path_bytes += length;
         
         if (soc->verbose) {
             printf("[%lu ns] Ethernet: ✓ Transmitted %u bytes to cloud (total: %lu bytes)\n",
-                   soc->event_queue.current_time, eth->tx_buf_len, eth->bytes_transmitted);
+                   soc->event_queue.current_time, length, eth->bytes_transmitted);
         }
     } else {
         if (soc->verbose) {
             printf("[%lu ns] Ethernet: ✗ Failed to transmit %u bytes to cloud\n",
-                   soc->event_queue.current_time, eth->tx_buf_len);
+                   soc->event_queue.current_time, length);
         }
     }
+}
+
+bool ethernet_transmit_buffer(BlackBoxSoC* soc, const uint8_t* src, uint32_t length) {
+    // REAL network transmission via HTTP POST to laptop
+    bool success = network_send_data(src, length);
+    ethernet_account_tx(soc, length, success);
+    ethernet_backup_frame(src, length);
+    return success;
+}
+
+typedef struct EthTxContext {
+    BlackBoxSoC* soc;
+    uint32_t length;
+    bool success;
+    EthTxDoneFn done;
+    void* user;
+    struct EthTxContext* next;
+} EthTxContext;
+
+// Runs on the transport's polling thread: only record the outcome. The
+// accounting and `done` wait for ethernet_reap_tx on the SoC's own loop.
+static void ethernet_tx_complete(void* context, bool success, long http_status) {
+    EthTxContext* ctx = (EthTxContext*)context;
+    (void)http_status;
+    ctx->success = success;
+    EthernetMAC* eth = &ctx->soc->eth_mac;
+    EthTxContext* head = atomic_load_explicit(&eth->tx_done, memory_order_relaxed);
+    do {
+        ctx->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&eth->tx_done, &head, ctx,
+                                                    memory_order_release, memory_order_relaxed));
+}
+
+uint32_t ethernet_reap_tx(BlackBoxSoC* soc) {
+    EthTxContext* list = atomic_exchange_explicit(&soc->eth_mac.tx_done, NULL, memory_order_acquire);
+
+    // Pushed newest first: reverse into completion order
+    EthTxContext* ordered = NULL;
+    while (list) {
+        EthTxContext* next = list->next;
+        list->next = ordered;
+        ordered = list;
+        list = next;
+    }
+
+    uint32_t reaped = 0;
+    while (ordered) {
+        EthTxContext* ctx = ordered;
+        ordered = ctx->next;
+        ethernet_account_tx(soc, ctx->length, ctx->success);
+        ctx->done(soc, ctx->user, ctx->success);
+        free(ctx);
+        reaped++;
+    }
+    return reaped;
+}
+
+bool ethernet_transmit_buffer_async(BlackBoxSoC* soc, const uint8_t* src, uint32_t length,
+                                    EthTxDoneFn done, void* user) {
+    EthTxContext* ctx = (EthTxContext*)malloc(sizeof(EthTxContext));
+    if (!ctx) return false;
+    ctx->soc = soc;
+    ctx->length = length;
+    ctx->done = done;
+    ctx->user = user;
     
-    // Also keep local backup file for redundancy
-    FILE* cloud_log = fopen("cloud_log.bin", "ab");
-    if (cloud_log) {
-        fwrite(src, 1, eth->tx_buf_len, cloud_log);
-        fclose(cloud_log);
+    ethernet_backup_frame(src, length);
+    if (!network_send_data_async(src, length, ethernet_tx_complete, ctx)) {
+        free(ctx);
+        return false;
     }
+    return true;
+}
+
+void ethernet_transmit_data(BlackBoxSoC* soc) {
+    EthernetMAC* eth = &soc->eth_mac;
+    
+    uint8_t* src = memory_translate(&soc->memory, eth->tx_buf_addr);
+    if (!src) return;
+    
+    // Never read past the end of the memory region holding the TX buffer
+    uint32_t remaining = memory_get_region_remaining(&soc->memory, eth->tx_buf_addr);
+    if (eth->tx_buf_len > remaining) {
+        if (soc->verbose) {
+            printf("[%lu ns] Ethernet: TX length %u exceeds buffer (%u bytes), dropped\n",
+                   soc->event_queue.current_time, eth->tx_buf_len, remaining);
+        }
+        return;
+    }
+    
+    ethernet_transmit_buffer(soc, src, eth->tx_buf_len);
 }
@@ -13,6 +13,24 @@
  * ETHERNET MAC FUNCTIONS
  * ============================================================================ */
 
+// Largest single frame the MAC will hand to the transport (one SBM slot)
+#define ETH_TX_MAX_CHUNK        SBM_SLOT_SIZE
+
 void ethernet_transmit_data(BlackBoxSoC* soc);
 
+// Transmit directly from a caller-owned buffer (scatter-gather descriptor).
+// Used by the zero-copy cloud path to send straight out of mapped storage.
+bool ethernet_transmit_buffer(BlackBoxSoC* soc, const uint8_t* src, uint32_t length);
+
+// Asynchronous variant: `src` must stay valid until `done` runs. That is
+// from ethernet_reap_tx, never on the transport's polling thread. Returns
+// false if the frame could not be queued.
+typedef void (*EthTxDoneFn)(BlackBoxSoC* soc, void* user, bool success);
+bool ethernet_transmit_buffer_async(BlackBoxSoC* soc, const uint8_t* src, uint32_t length,
+                                    EthTxDoneFn done, void* user);
+
+// Account finished async frames and run their `done` callbacks, in
+// completion order, on the calling thread. Returns frames reaped.
+uint32_t ethernet_reap_tx(BlackBoxSoC* soc);
+
 #endif // ETHERNET_MAC_H
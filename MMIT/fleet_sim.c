@@ -0,0 +1,364 @@
+/*
+ * BlackBox DPU - Fleet Load Generator Implementation
+ */
+
+#include "fleet_sim.h"
+#include "drive_fleet.h"
+#include "rate_scheduler.h"
+#include "http_transport.h"
+#include "telemetry_json.h"
+#include "telemetry_wire.h"
+#include "network_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __unix__
+#include <pthread.h>
+#endif
+
+typedef struct {
+    char vehicle_id[32];
+    uint32_t pending;            // Packets waiting for a full batch
+} FleetVehicle;
+
+// One worker owns a contiguous shard of vehicles; nothing is shared between
+// workers except the (thread-safe) HTTP transport
+typedef struct {
+    const FleetConfig* config;
+    FleetVehicle* vehicles;
+    uint32_t first;                  // Fleet index of vehicles[0]
+    uint32_t count;
+    DriveFleet drive;                // The shard's vehicles, stepped together
+    MMITTelemetryPacket* packets;    // count * batch, one run per vehicle
+    char* body;
+    size_t body_cap;
+
+    uint64_t* latency_ns;
+    uint32_t latency_count;
+    uint32_t latency_next;
+
+    uint64_t packets_sent;
+    uint64_t packets_failed;
+    uint64_t requests;
+    uint64_t requests_failed;
+    uint64_t bytes;
+    uint64_t missed;
+    uint64_t sim_start_ns;
+
+#ifdef __unix__
+    pthread_t thread;
+#endif
+} FleetWorker;
+
+void fleet_config_defaults(FleetConfig* config) {
+    memset(config, 0, sizeof(FleetConfig));
+    config->vehicles = 1000;
+    config->threads = 4;
+    config->rate_hz = 1;
+    config->duration_s = 10;
+    config->warp = 1.0;
+    config->batch = 1;
+    config->format = TELEMETRY_FORMAT_JSON;
+    config->sink = FLEET_SINK_BACKEND;
+    config->seed = 1;
+}
+
+/* ============================================================================
+ * DELIVERY
+ * ============================================================================ */
+
+// Single packets go to .../update, runs to .../batch (JSON envelope or
+// back-to-back binary records, as telemetry_sender sends them)
+static size_t fleet_encode(FleetWorker* w, const MMITTelemetryPacket* packets, uint32_t count) {
+    bool json = w->config->format == TELEMETRY_FORMAT_JSON;
+    char* buf = w->body;
+    size_t cap = w->body_cap;
+
+    if (count == 1 && w->config->batch == 1) {
+        return json ? telemetry_json_write(buf, cap, &packets[0])
+                    : telemetry_wire_encode((uint8_t*)buf, cap, &packets[0]);
+    }
+
+    size_t len = 0;
+    if (json) {
+        len = (size_t)snprintf(buf, cap, "{\"vehicle_id\":\"%s\",\"packets\":[", packets[0].vehicle_id);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (json && i > 0) buf[len++] = ',';
+        size_t n = json ? telemetry_json_write(buf + len, cap - len - 2, &packets[i])
+                        : telemetry_wire_encode((uint8_t*)buf + len, cap - len - 2, &packets[i]);
+        if (n == 0) return 0;
+        len += n;
+    }
+    if (json) {
+        buf[len++] = ']';
+        buf[len++] = '}';
+    }
+    return len;
+}
+
+static void fleet_record_latency(FleetWorker* w, uint64_t ns) {
+    w->latency_ns[w->latency_next] = ns;
+    w->latency_next = (w->latency_next + 1) % FLEET_LATENCY_SAMPLES;
+    if (w->latency_count < FLEET_LATENCY_SAMPLES) w->latency_count++;
+}
+
+// Send a vehicle's pending run. Latency covers encoding plus the request,
+// so the local sink measures what the generator alone costs.
+static void fleet_deliver(FleetWorker* w, FleetVehicle* v, const MMITTelemetryPacket* packets) {
+    uint32_t count = v->pending;
+    if (count == 0) return;
+    v->pending = 0;
+
+    uint64_t start_ns = monotonic_ns();
+    size_t len = fleet_encode(w, packets, count);
+    if (len == 0) {
+        w->packets_failed += count;
+        return;
+    }
+    w->bytes += len;
+
+    bool ok = true;
+    if (w->config->sink == FLEET_SINK_BACKEND) {
+        char url[256];
+        snprintf(url, sizeof(url), "http://%s:%d/api/v1/telemetry/%s/%s", BACKEND_API_HOST,
+                 BACKEND_API_PORT, v->vehicle_id, w->config->batch == 1 ? "update" : "batch");
+        HttpRequest req = {
+            .url = url,
+            .content_type = w->config->format == TELEMETRY_FORMAT_BINARY ? TELEMETRY_WIRE_CONTENT_TYPE
+                                                                         : "application/json",
+            .body = w->body,
+            .body_len = len,
+            .timeout_sec = 5L,
+            .compress = true,
+        };
+        ok = http_transport_post(&req, NULL);
+        w->requests++;
+        if (!ok) w->requests_failed++;
+    }
+    fleet_record_latency(w, monotonic_ns() - start_ns);
+
+    if (ok) {
+        w->packets_sent += count;
+    } else {
+        w->packets_failed += count;
+    }
+}
+
+/* ============================================================================
+ * WORKERS
+ * ============================================================================ */
+
+static void* fleet_worker_main(void* arg) {
+    FleetWorker* w = (FleetWorker*)arg;
+    const FleetConfig* config = w->config;
+    uint32_t batch = config->batch;
+
+    RateScheduler* sched = (RateScheduler*)malloc(sizeof(RateScheduler));
+    if (!sched) return NULL;
+    rate_scheduler_init(sched, config->rate_hz);
+    if (config->warp != 1.0) rate_scheduler_set_warp(sched, config->warp);
+    double period_s = (double)sched->sim_period_ns / 1e9;
+
+    uint64_t ticks = (uint64_t)config->duration_s * sched->rate_hz;
+    uint64_t sim_ns = 0;
+    for (uint64_t t = 0; t < ticks; t++) {
+        // Every vehicle in the shard samples once per tick
+        uint32_t periods = rate_scheduler_wait(sched);
+        sim_ns += periods * sched->sim_period_ns;
+        drive_fleet_step(&w->drive, periods * period_s);
+
+        for (uint32_t i = 0; i < w->count; i++) {
+            FleetVehicle* v = &w->vehicles[i];
+            MMITTelemetryPacket* run = &w->packets[(size_t)i * batch];
+            MMITTelemetryPacket* packet = &run[v->pending++];
+
+            drive_fleet_packet(&w->drive, i, packet);
+            memcpy(packet->vehicle_id, v->vehicle_id, sizeof(packet->vehicle_id));
+            packet->timestamp_ns = w->sim_start_ns + sim_ns;
+
+            if (v->pending >= batch) fleet_deliver(w, v, run);
+        }
+    }
+
+    // Partial runs left at the end of the drive
+    for (uint32_t i = 0; i < w->count; i++) {
+        fleet_deliver(w, &w->vehicles[i], &w->packets[(size_t)i * batch]);
+    }
+
+    RateSchedulerStats sched_stats;
+    rate_scheduler_get_stats(sched, &sched_stats);
+    w->missed = sched_stats.missed;
+    free(sched);
+    return NULL;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Merge the workers' counters and latency samples
+static void fleet_collect(FleetWorker* workers, uint32_t threads, double wall_s, FleetStats* stats) {
+    memset(stats, 0, sizeof(FleetStats));
+    uint32_t samples = 0;
+    for (uint32_t t = 0; t < threads; t++) {
+        FleetWorker* w = &workers[t];
+        stats->packets += w->packets_sent;
+        stats->packets_failed += w->packets_failed;
+        stats->requests += w->requests;
+        stats->requests_failed += w->requests_failed;
+        stats->bytes += w->bytes;
+        stats->missed_ticks += w->missed;
+        samples += w->latency_count;
+    }
+    stats->wall_s = wall_s;
+    if (wall_s > 0) {
+        stats->packets_per_sec = stats->packets / wall_s;
+        stats->requests_per_sec = stats->requests / wall_s;
+    }
+
+    if (samples == 0) return;
+    uint64_t* sorted = (uint64_t*)malloc(samples * sizeof(uint64_t));
+    if (!sorted) return;
+    uint32_t n = 0;
+    for (uint32_t t = 0; t < threads; t++) {
+        memcpy(sorted + n, workers[t].latency_ns, workers[t].latency_count * sizeof(uint64_t));
+        n += workers[t].latency_count;
+    }
+    qsort(sorted, n, sizeof(uint64_t), compare_u64);
+    stats->p50_us = sorted[(uint32_t)(0.50 * (n - 1) + 0.5)] / 1000.0;
+    stats->p90_us = sorted[(uint32_t)(0.90 * (n - 1) + 0.5)] / 1000.0;
+    stats->p99_us = sorted[(uint32_t)(0.99 * (n - 1) + 0.5)] / 1000.0;
+    stats->p999_us = sorted[(uint32_t)(0.999 * (n - 1) + 0.5)] / 1000.0;
+    stats->max_us = sorted[n - 1] / 1000.0;
+    free(sorted);
+}
+
+static void fleet_free_workers(FleetWorker* workers, uint32_t threads) {
+    for (uint32_t t = 0; t < threads; t++) {
+        free(workers[t].packets);
+        free(workers[t].body);
+        free(workers[t].latency_ns);
+        drive_fleet_free(&workers[t].drive);
+    }
+    free(workers);
+}
+
+bool fleet_run(const FleetConfig* config, FleetStats* stats) {
+    memset(stats, 0, sizeof(FleetStats));
+    if (config->vehicles == 0 || config->vehicles > FLEET_MAX_VEHICLES ||
+        config->batch == 0 || config->batch > FLEET_MAX_BATCH) {
+        return false;
+    }
+
+    uint32_t threads = config->threads;
+    if (threads == 0) threads = 1;
+    if (threads > FLEET_MAX_THREADS) threads = FLEET_MAX_THREADS;
+    if (threads > config->vehicles) threads = config->vehicles;
+#ifndef __unix__
+    threads = 1;
+#endif
+
+    FleetVehicle* vehicles = (FleetVehicle*)calloc(config->vehicles, sizeof(FleetVehicle));
+    FleetWorker* workers = (FleetWorker*)calloc(threads, sizeof(FleetWorker));
+    if (!vehicles || !workers) {
+        free(vehicles);
+        free(workers);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < config->vehicles; i++) {
+        snprintf(vehicles[i].vehicle_id, sizeof(vehicles[i].vehicle_id), "FLEET_%05u", i);
+    }
+
+    // Contiguous shards; the first (vehicles % threads) workers take one extra
+    uint64_t sim_start_ns = telemetry_now_ns();
+    uint32_t next = 0;
+    bool ok = true;
+    for (uint32_t t = 0; t < threads; t++) {
+        FleetWorker* w = &workers[t];
+        w->config = config;
+        w->count = config->vehicles / threads + (t < config->vehicles % threads ? 1 : 0);
+        w->vehicles = &vehicles[next];
+        w->first = next;
+        next += w->count;
+        w->sim_start_ns = sim_start_ns;
+        w->body_cap = (size_t)config->batch * TELEMETRY_JSON_MAX + 128;
+        w->body = (char*)malloc(w->body_cap);
+        w->packets = (MMITTelemetryPacket*)malloc((size_t)w->count * config->batch *
+                                                  sizeof(MMITTelemetryPacket));
+        w->latency_ns = (uint64_t*)malloc(FLEET_LATENCY_SAMPLES * sizeof(uint64_t));
+        if (!w->body || !w->packets || !w->latency_ns ||
+            !drive_fleet_init(&w->drive, w->count, config->seed + w->first)) {
+            ok = false;
+        }
+    }
+    if (!ok) {
+        fleet_free_workers(workers, threads);
+        free(vehicles);
+        return false;
+    }
+
+    if (config->sink == FLEET_SINK_BACKEND && !http_transport_init()) {
+        fleet_free_workers(workers, threads);
+        free(vehicles);
+        return false;
+    }
+
+    uint64_t start_ns = monotonic_ns();
+    uint32_t allocated = threads;
+#ifdef __unix__
+    uint32_t started = 0;
+    for (; started < threads; started++) {
+        if (pthread_create(&workers[started].thread, NULL, fleet_worker_main, &workers[started]) != 0) {
+            fprintf(stderr, "Fleet: Failed to start worker %u\n", started);
+            break;
+        }
+    }
+    for (uint32_t t = 0; t < started; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+    threads = started;
+#else
+    fleet_worker_main(&workers[0]);
+#endif
+    double wall_s = (monotonic_ns() - start_ns) / 1e9;
+
+    fleet_collect(workers, threads, wall_s, stats);
+    if (config->sink == FLEET_SINK_BACKEND) http_transport_cleanup();
+    stats->threads = threads;
+    fleet_free_workers(workers, allocated);
+    free(vehicles);
+    return threads > 0;
+}
+
+void fleet_print_stats(const FleetConfig* config, const FleetStats* stats) {
+    uint64_t expected = (uint64_t)config->vehicles * config->duration_s * config->rate_hz;
+    printf("\n");
+    printf("════════════════════════════════════════════════════════════════════\n");
+    printf("  Fleet Complete!\n");
+    printf("  Vehicles:      %u on %u threads, %u Hz, %u s simulated\n", config->vehicles,
+           stats->threads, config->rate_hz, config->duration_s);
+    printf("  Packets:       %lu of %lu delivered, %lu failed\n", stats->packets, expected,
+           stats->packets_failed);
+    if (config->sink == FLEET_SINK_BACKEND) {
+        printf("  Requests:      %lu (%lu failed), %.0f req/s\n", stats->requests,
+               stats->requests_failed, stats->requests_per_sec);
+    }
+    printf("  Throughput:    %.0f packets/s over %.2f s", stats->packets_per_sec, stats->wall_s);
+    if (config->warp > 0.0) {
+        printf(" (%.0f packets/s offered)\n", (double)config->vehicles * config->rate_hz * config->warp);
+    } else {
+        printf(" (unpaced)\n");
+    }
+    printf("  Body bytes:    %lu (%.1f per packet)\n", stats->bytes,
+           stats->packets > 0 ? (double)stats->bytes / stats->packets : 0.0);
+    printf("  Latency:       p50 %.1f us, p90 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+           stats->p50_us, stats->p90_us, stats->p99_us, stats->p999_us, stats->max_us);
+    printf("  Missed ticks:  %lu\n", stats->missed_ticks);
+    printf("════════════════════════════════════════════════════════════════════\n");
+    printf("\n");
+}
@@ -0,0 +1,66 @@
+/*
+ * BlackBox DPU - Fleet Load Generator
+ * Thousands of simulated vehicles sharded across worker threads, each
+ * streaming to the backend or a local sink, for ingest capacity planning
+ */
+
+#ifndef FLEET_SIM_H
+#define FLEET_SIM_H
+
+#include "telemetry_sender.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FLEET_MAX_VEHICLES          100000
+#define FLEET_MAX_THREADS           64
+#define FLEET_MAX_BATCH             100
+// Delivery latency samples kept per worker for percentile reporting
+#define FLEET_LATENCY_SAMPLES       16384
+
+typedef enum {
+    FLEET_SINK_BACKEND,          // POST to /api/v1/telemetry/{id}/...
+    FLEET_SINK_LOCAL             // Encode and discard: generator-side ceiling
+} FleetSink;
+
+typedef struct {
+    uint32_t vehicles;
+    uint32_t threads;            // Vehicles are split evenly across workers
+    uint32_t rate_hz;            // Samples per vehicle per simulated second
+    uint32_t duration_s;         // Simulated seconds per vehicle
+    double warp;                 // Simulated / wall time; 0 = as fast as possible
+    uint32_t batch;              // Packets per request and vehicle (1 = single)
+    TelemetryFormat format;
+    FleetSink sink;
+    uint64_t seed;               // Vehicle n drives with seed + n
+} FleetConfig;
+
+typedef struct {
+    uint32_t threads;            // Workers that actually ran
+    uint64_t packets;            // Delivered (or encoded, for the local sink)
+    uint64_t packets_failed;
+    uint64_t requests;
+    uint64_t requests_failed;
+    uint64_t bytes;              // Request bodies before transport compression
+    uint64_t missed_ticks;       // Worker ticks that overran their deadline
+    double wall_s;
+    double packets_per_sec;
+    double requests_per_sec;
+    double p50_us;               // Per-request delivery latency
+    double p90_us;
+    double p99_us;
+    double p999_us;
+    double max_us;
+} FleetStats;
+
+/* ============================================================================
+ * FLEET FUNCTIONS
+ * ============================================================================ */
+
+void fleet_config_defaults(FleetConfig* config);
+
+// Run the fleet to completion (blocking). Returns false if it could not start.
+bool fleet_run(const FleetConfig* config, FleetStats* stats);
+
+void fleet_print_stats(const FleetConfig* config, const FleetStats* stats);
+
+#endif // FLEET_SIM_H
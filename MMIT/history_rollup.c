@@ -0,0 +1,368 @@
+/*
+ * BlackBox DPU - History Rollups Implementation
+ *
+ * Raw samples only feed the 1 s level: each run of samples inside one
+ * bucket is reduced in a lane loop the compiler vectorizes. A closed bucket
+ * then folds into the level above (min of mins, max of maxes, summed sums),
+ * so the coarser levels cost one update per closed bucket below them.
+ */
+
+#include "history_rollup.h"
+
+#ifdef __unix__
+#include <unistd.h>
+#endif
+
+static const char* const level_suffix[HISTORY_LEVELS] = {".h1s", ".h1m", ".h1h"};
+
+uint64_t history_rollup_resolution(uint32_t level) {
+    static const uint64_t resolution[HISTORY_LEVELS] = {
+        HISTORY_RESOLUTION_1S, HISTORY_RESOLUTION_1M, HISTORY_RESOLUTION_1H
+    };
+    return resolution[level < HISTORY_LEVELS ? level : HISTORY_LEVELS - 1];
+}
+
+uint32_t history_rollup_level_for(uint64_t resolution_ns) {
+    uint32_t level = 0;
+    while (level + 1 < HISTORY_LEVELS && history_rollup_resolution(level + 1) <= resolution_ns) level++;
+    return level;
+}
+
+/* ============================================================================
+ * INGEST SIDE
+ * ============================================================================ */
+
+static bool ensure_open(HistoryRollup* history, uint32_t channel_id) {
+    if (channel_id < history->open_channels) return true;
+    uint32_t channels = history->open_channels ? history->open_channels : 64;
+    while (channels <= channel_id) channels *= 2;
+    for (uint32_t level = 0; level < HISTORY_LEVELS; level++) {
+        HistoryBucket* grown = (HistoryBucket*)realloc(history->open[level], channels * sizeof(HistoryBucket));
+        if (!grown) return false;
+        memset(grown + history->open_channels, 0, (channels - history->open_channels) * sizeof(HistoryBucket));
+        history->open[level] = grown;
+    }
+    history->open_channels = channels;
+    return true;
+}
+
+static void push_pending(HistoryRollup* history, uint32_t level, const HistoryRecord* record) {
+    if (history->pending_count[level] == history->pending_capacity[level]) {
+        uint32_t capacity = history->pending_capacity[level] ? history->pending_capacity[level] * 2 : 256;
+        HistoryRecord* grown = (HistoryRecord*)realloc(history->pending[level], capacity * sizeof(HistoryRecord));
+        if (!grown) return;
+        history->pending[level] = grown;
+        history->pending_capacity[level] = capacity;
+    }
+    history->pending[level][history->pending_count[level]++] = *record;
+}
+
+// Emit the bucket as a record and fold it into the level above
+static void close_bucket(HistoryRollup* history, uint32_t level, uint32_t channel_id, HistoryBucket* bucket) {
+    HistoryRecord record = {
+        .start_ns = bucket->start_ns,
+        .channel_id = channel_id,
+        .count = bucket->count,
+        .min = bucket->min,
+        .max = bucket->max,
+        .mean = (float)(bucket->sum / bucket->count),
+        .last = bucket->last,
+    };
+    push_pending(history, level, &record);
+
+    if (level + 1 < HISTORY_LEVELS) {
+        HistoryBucket* up = &history->open[level + 1][channel_id];
+        uint64_t resolution = history_rollup_resolution(level + 1);
+        uint64_t start = bucket->start_ns - bucket->start_ns % resolution;
+        if (up->count > 0 && up->start_ns != start) close_bucket(history, level + 1, channel_id, up);
+        if (up->count == 0) {
+            up->start_ns = start;
+            up->sum = 0.0;
+            up->min = bucket->min;
+            up->max = bucket->max;
+        }
+        up->min = bucket->min < up->min ? bucket->min : up->min;
+        up->max = bucket->max > up->max ? bucket->max : up->max;
+        up->sum += bucket->sum;
+        up->count += bucket->count;
+        up->last = bucket->last;
+    }
+    bucket->count = 0;
+}
+
+// Fold count values into the bucket's min, max and sum
+static void reduce_run(HistoryBucket* bucket, const float* x, uint32_t count) {
+    enum { L = HISTORY_LANES };
+    float lo[L], hi[L], sum[L];
+    for (uint32_t l = 0; l < L; l++) {
+        lo[l] = bucket->min;
+        hi[l] = bucket->max;
+        sum[l] = 0.0f;
+    }
+    uint32_t full = count / L * L;
+    // One lane loop per accumulator: fused, they are not vectorized
+    for (uint32_t i = 0; i < full; i += L) {
+        const float* v = x + i;
+        for (uint32_t l = 0; l < L; l++) lo[l] = v[l] < lo[l] ? v[l] : lo[l];
+        for (uint32_t l = 0; l < L; l++) hi[l] = v[l] > hi[l] ? v[l] : hi[l];
+        for (uint32_t l = 0; l < L; l++) sum[l] += v[l];
+    }
+    double total = 0.0;
+    for (uint32_t l = 0; l < L; l++) {
+        bucket->min = lo[l] < bucket->min ? lo[l] : bucket->min;
+        bucket->max = hi[l] > bucket->max ? hi[l] : bucket->max;
+        total += sum[l];
+    }
+    for (uint32_t i = full; i < count; i++) {
+        bucket->min = x[i] < bucket->min ? x[i] : bucket->min;
+        bucket->max = x[i] > bucket->max ? x[i] : bucket->max;
+        total += x[i];
+    }
+    bucket->sum += total;
+}
+
+void history_rollup_ingest(HistoryRollup* history, uint32_t channel_id, const uint64_t* timestamps,
+                           const float* values, uint32_t count) {
+    if (count == 0 || !ensure_open(history, channel_id)) return;
+    HistoryBucket* bucket = &history->open[0][channel_id];
+    const uint64_t resolution = HISTORY_RESOLUTION_1S;
+
+    uint32_t i = 0;
+    while (i < count) {
+        if (timestamps[i] < bucket->next_ns) {
+            history->samples_late++;
+            i++;
+            continue;
+        }
+        if (bucket->count > 0 && timestamps[i] - bucket->start_ns >= resolution) {
+            close_bucket(history, 0, channel_id, bucket);
+        }
+        if (bucket->count == 0) {
+            bucket->start_ns = timestamps[i] - timestamps[i] % resolution;
+            bucket->sum = 0.0;
+            bucket->min = values[i];
+            bucket->max = values[i];
+        }
+
+        // The run of samples inside this bucket ends at the first one past it
+        uint64_t end = bucket->start_ns + resolution;
+        uint32_t j = i + 1, hi = count;
+        while (j < hi) {
+            uint32_t mid = j + (hi - j) / 2;
+            if (timestamps[mid] < end) j = mid + 1;
+            else hi = mid;
+        }
+
+        reduce_run(bucket, values + i, j - i);
+        bucket->count += j - i;
+        bucket->last = values[j - 1];
+        bucket->next_ns = timestamps[j - 1] + 1;
+        history->samples_ingested += j - i;
+        i = j;
+    }
+}
+
+void history_rollup_flush(HistoryRollup* history) {
+    for (uint32_t level = 0; level < HISTORY_LEVELS; level++) {
+        for (uint32_t c = 0; c < history->open_channels; c++) {
+            HistoryBucket* bucket = &history->open[level][c];
+            if (bucket->count > 0) close_bucket(history, level, c, bucket);
+        }
+    }
+}
+
+/* ============================================================================
+ * STORE SIDE
+ * ============================================================================ */
+
+// Newest stored point of the record's channel, NULL if it has none
+static HistoryPointRef* track_last(HistoryRollup* history, uint32_t level, uint32_t channel_id) {
+    if (channel_id >= history->track_channels) return NULL;
+    HistoryTrack* track = &history->tracks[level][channel_id];
+    return track->count > 0 ? &track->points[track->count - 1] : NULL;
+}
+
+static uint32_t record_bucket(uint32_t level, const HistoryRecord* record) {
+    return (uint32_t)(record->start_ns / history_rollup_resolution(level));
+}
+
+// Index the level's next record. The record number advances even when the
+// index cannot grow (or the record is out of order and left unindexed), so
+// later points still find their own records.
+static bool track_append(HistoryRollup* history, uint32_t level, const HistoryRecord* record) {
+    uint32_t number = history->records[level]++;
+    uint32_t channel_id = record->channel_id;
+    const HistoryPointRef* newest = track_last(history, level, channel_id);
+    if (newest && newest->bucket >= record_bucket(level, record)) return false;
+    if (channel_id >= history->track_channels) {
+        uint32_t channels = history->track_channels ? history->track_channels : 64;
+        while (channels <= channel_id) channels *= 2;
+        for (uint32_t l = 0; l < HISTORY_LEVELS; l++) {
+            HistoryTrack* grown = (HistoryTrack*)realloc(history->tracks[l], channels * sizeof(HistoryTrack));
+            if (!grown) return false;
+            memset(grown + history->track_channels, 0, (channels - history->track_channels) * sizeof(HistoryTrack));
+            history->tracks[l] = grown;
+        }
+        history->track_channels = channels;
+    }
+
+    HistoryTrack* track = &history->tracks[level][channel_id];
+    if (track->count == track->capacity) {
+        uint32_t capacity = track->capacity ? track->capacity * 2 : 64;
+        HistoryPointRef* grown = (HistoryPointRef*)realloc(track->points, capacity * sizeof(HistoryPointRef));
+        if (!grown) return false;
+        track->points = grown;
+        track->capacity = capacity;
+    }
+    HistoryPointRef* point = &track->points[track->count++];
+    point->bucket = record_bucket(level, record);
+    point->record = number;
+    return true;
+}
+
+// Fold a record into the stored one for the same bucket, in place
+static bool merge_record(HistoryRollup* history, uint32_t level, const HistoryPointRef* point,
+                         const HistoryRecord* record) {
+    FILE* file = history->files[level];
+    long offset = (long)point->record * (long)sizeof(HistoryRecord);
+    HistoryRecord stored;
+    if (fseek(file, offset, SEEK_SET) != 0 || fread(&stored, sizeof(stored), 1, file) != 1) return false;
+
+    uint32_t count = stored.count + record->count;
+    stored.mean = (float)(((double)stored.mean * stored.count + (double)record->mean * record->count) / count);
+    stored.min = record->min < stored.min ? record->min : stored.min;
+    stored.max = record->max > stored.max ? record->max : stored.max;
+    stored.last = record->last;
+    stored.count = count;
+    if (fseek(file, offset, SEEK_SET) != 0 || fwrite(&stored, sizeof(stored), 1, file) != 1) return false;
+    history->records_merged++;
+    return true;
+}
+
+// Rebuild a level's tracks from its file, dropping a torn trailing record
+static void reindex_level(HistoryRollup* history, uint32_t level) {
+    FILE* file = history->files[level];
+    HistoryRecord window[HISTORY_READ_WINDOW];
+    size_t n;
+    fseek(file, 0, SEEK_SET);
+    while ((n = fread(window, sizeof(HistoryRecord), HISTORY_READ_WINDOW, file)) > 0) {
+        for (size_t r = 0; r < n; r++) track_append(history, level, &window[r]);
+    }
+#ifdef __unix__
+    if (ftruncate(fileno(file), (off_t)history->records[level] * sizeof(HistoryRecord)) != 0) {
+        perror("History: truncate");
+    }
+#endif
+}
+
+bool history_rollup_open(HistoryRollup* history, const char* base_path, bool resume) {
+    memset(history, 0, sizeof(HistoryRollup));
+    char path[256];
+    for (uint32_t level = 0; level < HISTORY_LEVELS; level++) {
+        snprintf(path, sizeof(path), "%s%s", base_path, level_suffix[level]);
+        history->files[level] = resume ? fopen(path, "r+b") : NULL;
+        if (history->files[level]) {
+            reindex_level(history, level);
+        } else {
+            history->files[level] = fopen(path, "w+b");
+        }
+        if (!history->files[level]) {
+            history_rollup_close(history);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool history_rollup_store(HistoryRollup* history, uint32_t level, const HistoryRecord* records,
+                          uint32_t count) {
+    FILE* file = level < HISTORY_LEVELS ? history->files[level] : NULL;
+    if (!file) return false;
+    if (count == 0) return true;
+
+    uint32_t r = 0;
+    while (r < count) {
+        // Records past their channel's newest point append in one write
+        // (queries move the file position)
+        uint32_t end = r;
+        while (end < count) {
+            const HistoryPointRef* newest = track_last(history, level, records[end].channel_id);
+            if (newest && newest->bucket >= record_bucket(level, &records[end])) break;
+            end++;
+        }
+        if (end > r) {
+            fseek(file, 0, SEEK_END);
+            if (fwrite(records + r, sizeof(HistoryRecord), end - r, file) != end - r) return false;
+            for (; r < end; r++) track_append(history, level, &records[r]);
+            continue;
+        }
+
+        const HistoryPointRef* newest = track_last(history, level, records[r].channel_id);
+        if (newest->bucket == record_bucket(level, &records[r])) {
+            if (!merge_record(history, level, newest, &records[r])) return false;
+        } else {
+            history->records_skipped++;
+        }
+        r++;
+    }
+    fflush(file);
+    return true;
+}
+
+void history_rollup_close(HistoryRollup* history) {
+    history_rollup_flush(history);
+    for (uint32_t level = 0; level < HISTORY_LEVELS; level++) {
+        if (history->files[level]) {
+            history_rollup_store(history, level, history->pending[level], history->pending_count[level]);
+            fclose(history->files[level]);
+        }
+        for (uint32_t c = 0; c < history->track_channels; c++) free(history->tracks[level][c].points);
+        free(history->tracks[level]);
+        free(history->open[level]);
+        free(history->pending[level]);
+    }
+    memset(history, 0, sizeof(HistoryRollup));
+}
+
+/* ============================================================================
+ * QUERIES
+ * ============================================================================ */
+
+uint32_t history_rollup_query(HistoryRollup* history, uint32_t channel_id, uint64_t from_ns,
+                              uint64_t to_ns, uint64_t resolution_ns, HistoryRecord* out,
+                              uint32_t max) {
+    uint32_t level = history_rollup_level_for(resolution_ns);
+    FILE* file = history->files[level];
+    if (!file || channel_id >= history->track_channels || to_ns <= from_ns) return 0;
+
+    const HistoryTrack* track = &history->tracks[level][channel_id];
+    uint64_t resolution = history_rollup_resolution(level);
+    uint64_t first = from_ns / resolution;
+    uint64_t last = (to_ns - 1) / resolution;
+
+    // First point at or after the first overlapping bucket
+    uint32_t lo = 0, hi = track->count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (track->points[mid].bucket < first) lo = mid + 1;
+        else hi = mid;
+    }
+
+    // Read a window of the file per seek: consecutive points of a channel
+    // sit a few records apart
+    HistoryRecord window[HISTORY_READ_WINDOW];
+    uint32_t got = 0;
+    uint32_t p = lo;
+    while (p < track->count && track->points[p].bucket <= last && got < max) {
+        uint32_t base = track->points[p].record;
+        fseek(file, (long)base * (long)sizeof(HistoryRecord), SEEK_SET);
+        size_t n = fread(window, sizeof(HistoryRecord), HISTORY_READ_WINDOW, file);
+        if (n == 0) break;
+        while (p < track->count && track->points[p].bucket <= last && got < max &&
+               track->points[p].record - base < n) {
+            out[got++] = window[track->points[p].record - base];
+            p++;
+        }
+    }
+    return got;
+}
@@ -0,0 +1,125 @@
+/*
+ * BlackBox DPU - History Rollups
+ * Per-channel min/max/mean/last over 1 s, 1 min and 1 h buckets, built
+ * while the channels are drained (each level from the one below) and kept
+ * in side files next to the NVMe log. A history query reads the coarsest
+ * level that still meets the requested resolution, so its cost follows the
+ * points it returns, not the time range or the raw samples behind it.
+ */
+
+#ifndef HISTORY_ROLLUP_H
+#define HISTORY_ROLLUP_H
+
+#include "blackbox_common.h"
+
+#define HISTORY_LEVELS              3
+#define HISTORY_RESOLUTION_1S       1000000000ULL
+#define HISTORY_RESOLUTION_1M       (60 * HISTORY_RESOLUTION_1S)
+#define HISTORY_RESOLUTION_1H       (60 * HISTORY_RESOLUTION_1M)
+#define HISTORY_LANES               16
+// Records handed to the store in one piece (keeps a handoff well under
+// BLACKBOX_LOG_BLOCK_MAX)
+#define HISTORY_STORE_BATCH         4096
+#define HISTORY_READ_WINDOW         2048    // Records read per query seek
+
+/*
+ * Side file per level (<base>.h1s, .h1m, .h1h): HistoryRecord after
+ * HistoryRecord in the order buckets close, host byte order. Records of
+ * one channel are in time order; channels interleave.
+ */
+typedef struct {
+    uint64_t start_ns;           // Bucket start, a multiple of the level's resolution
+    uint32_t channel_id;
+    uint32_t count;              // Samples behind the record
+    float min;
+    float max;
+    float mean;
+    float last;
+} HistoryRecord;
+
+// Open bucket of one channel at one level
+typedef struct {
+    uint64_t start_ns;
+    double sum;
+    float min;
+    float max;
+    float last;
+    uint32_t count;              // 0 = no bucket open
+    uint64_t next_ns;            // 1 s level: past the newest sample, earlier ones are late
+} HistoryBucket;
+
+// Where a channel's points sit in a level's side file
+typedef struct {
+    uint32_t bucket;             // start_ns / resolution
+    uint32_t record;             // Record number in the file
+} HistoryPointRef;
+
+typedef struct {
+    HistoryPointRef* points;     // Ascending bucket
+    uint32_t count;
+    uint32_t capacity;
+} HistoryTrack;
+
+// The ingest side (open buckets, pending records) belongs to whoever drains
+// the channels and the store side (files, tracks) to whoever logs; with the
+// cores threaded these are the RPU and the APU (core_runtime.h).
+struct HistoryRollup {
+    // Ingest side
+    HistoryBucket* open[HISTORY_LEVELS];        // Per channel
+    uint32_t open_channels;
+    HistoryRecord* pending[HISTORY_LEVELS];     // Closed, not yet stored
+    uint32_t pending_count[HISTORY_LEVELS];
+    uint32_t pending_capacity[HISTORY_LEVELS];
+    uint64_t samples_ingested;
+    uint64_t samples_late;       // Not newer than their channel's newest, dropped
+
+    // Store side
+    FILE* files[HISTORY_LEVELS];
+    uint32_t records[HISTORY_LEVELS];           // Records in each file
+    HistoryTrack* tracks[HISTORY_LEVELS];       // Per channel
+    uint32_t track_channels;
+    uint64_t records_merged;     // Into a stored point for the same bucket
+    uint64_t records_skipped;    // Older than the channel's newest stored point
+};
+
+/* ============================================================================
+ * HISTORY ROLLUP FUNCTIONS
+ * ============================================================================ */
+
+uint64_t history_rollup_resolution(uint32_t level);
+
+// Coarsest level whose resolution is at most resolution_ns (the 1 s level
+// when even that is too coarse)
+uint32_t history_rollup_level_for(uint64_t resolution_ns);
+
+// Open (or with resume, reopen and re-index) the side files at
+// base_path.h1s/.h1m/.h1h
+bool history_rollup_open(HistoryRollup* history, const char* base_path, bool resume);
+
+// Close every open bucket, store what is pending and close the files
+void history_rollup_close(HistoryRollup* history);
+
+// Ingest side: fold a channel's samples (ascending timestamps) into its open
+// buckets. A sample past a bucket closes it into the pending records; one
+// not newer than the channel's newest sample so far is late and dropped.
+void history_rollup_ingest(HistoryRollup* history, uint32_t channel_id, const uint64_t* timestamps,
+                           const float* values, uint32_t count);
+
+// Ingest side: close every open bucket, partial ones included
+void history_rollup_flush(HistoryRollup* history);
+
+// Store side: append records to a level's file and index them. A record
+// for the bucket of the channel's newest stored point (a partial bucket
+// flushed at close, continued after a resume) is merged into it; an older
+// one is skipped, so every channel's points stay in time order.
+bool history_rollup_store(HistoryRollup* history, uint32_t level, const HistoryRecord* records,
+                          uint32_t count);
+
+// Store side: a channel's stored points whose buckets overlap [from_ns,
+// to_ns), at the level history_rollup_level_for(resolution_ns), oldest
+// first. Returns the points written to out (at most max).
+uint32_t history_rollup_query(HistoryRollup* history, uint32_t channel_id, uint64_t from_ns,
+                              uint64_t to_ns, uint64_t resolution_ns, HistoryRecord* out,
+                              uint32_t max);
+
+#endif // HISTORY_ROLLUP_H
@@ -0,0 +1,557 @@
+/*
+ * BlackBox DPU - HTTP Transport Implementation
+ * All HTTP traffic goes through one curl multi handle so connections are
+ * kept alive and shared between the cloud uploader and telemetry sender.
+ */
+
+#include "http_transport.h"
+#include "blackbox_common.h"
+#include "payload_codec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __unix__
+#include <curl/curl.h>
+#include <pthread.h>
+#include <time.h>
+#endif
+
+/* ============================================================================
+ * STATISTICS
+ * ============================================================================ */
+
+static int g_refcount = 0;
+static uint64_t g_completed = 0;
+static uint64_t g_failed = 0;
+static uint64_t g_conn_opened = 0;
+static uint64_t g_conn_reused = 0;
+static uint64_t g_bytes_raw = 0;
+static uint64_t g_bytes_wire = 0;
+static uint64_t g_compressed = 0;
+static bool g_compression = HTTP_COMPRESSION_DEFAULT;
+static uint32_t g_latency_us[HTTP_LATENCY_SAMPLES];
+static uint32_t g_latency_count = 0;
+static uint32_t g_latency_next = 0;
+
+static void record_latency(uint64_t elapsed_ns) {
+    uint64_t us = elapsed_ns / 1000;
+    g_latency_us[g_latency_next] = us > UINT32_MAX ? UINT32_MAX : (uint32_t)us;
+    g_latency_next = (g_latency_next + 1) % HTTP_LATENCY_SAMPLES;
+    if (g_latency_count < HTTP_LATENCY_SAMPLES) g_latency_count++;
+}
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+#ifdef __unix__
+
+/* ============================================================================
+ * CONNECTION POOL
+ * ============================================================================ */
+
+typedef struct {
+    CURL* easy;
+    struct curl_slist* headers;
+    bool busy;
+    bool done;               // Completion seen (sync waiters poll this)
+    bool success;
+    long http_status;
+    uint64_t start_ns;
+    HttpCompletionFn on_complete;
+    void* user;
+    uint8_t* zbuf;           // Compressed body, owned until the slot is reused
+    size_t zcap;
+} HttpSlot;
+
+static CURLM* g_multi = NULL;
+static HttpSlot g_slots[HTTP_POOL_SIZE];
+static uint32_t g_in_flight = 0;
+
+// The multi handle is not thread-safe. Public entry points take this lock,
+// never recursively: completion callbacks are queued in g_finished and run
+// after it is released. The one thread sleeping in curl_multi_poll drops
+// the lock but keeps the multi handle: requests started meanwhile wait in
+// g_pending and wake it, and other pollers wait on g_polled for its round
+// instead of spinning.
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_polled = PTHREAD_COND_INITIALIZER;
+static bool g_polling = false;
+static uint32_t g_waiters = 0;
+static bool g_wake_all = false;     // A blocking post finished this round
+static HttpSlot* g_pending[HTTP_POOL_SIZE];
+static uint32_t g_pending_count = 0;
+// Async requests done but not yet called back (their slots stay busy)
+static HttpSlot* g_finished[HTTP_POOL_SIZE];
+static uint32_t g_finished_count = 0;
+
+typedef struct {
+    HttpCompletionFn fn;
+    void* user;
+    bool success;
+    long http_status;
+} HttpCallback;
+
+static void transport_lock(void) {
+    pthread_mutex_lock(&g_lock);
+}
+
+static void transport_unlock(void) {
+    pthread_mutex_unlock(&g_lock);
+}
+
+static size_t discard_response(char* ptr, size_t size, size_t nmemb, void* userdata) {
+    (void)ptr;
+    (void)userdata;
+    return size * nmemb;
+}
+
+bool http_transport_init(void) {
+    transport_lock();
+    if (g_refcount++ > 0) {
+        transport_unlock();
+        return true;
+    }
+
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+        fprintf(stderr, "HTTP Transport: Failed to initialize libcurl\n");
+        g_refcount = 0;
+        transport_unlock();
+        return false;
+    }
+    g_multi = curl_multi_init();
+    if (!g_multi) {
+        curl_global_cleanup();
+        g_refcount = 0;
+        transport_unlock();
+        return false;
+    }
+    curl_multi_setopt(g_multi, CURLMOPT_MAXCONNECTS, (long)HTTP_POOL_SIZE);
+
+    memset(g_slots, 0, sizeof(g_slots));
+    for (int i = 0; i < HTTP_POOL_SIZE; i++) {
+        g_slots[i].easy = curl_easy_init();
+    }
+    transport_unlock();
+    return true;
+}
+
+void http_transport_cleanup(void) {
+    transport_lock();
+    if (g_refcount == 0 || --g_refcount > 0) {
+        transport_unlock();
+        return;
+    }
+    if (g_polling) curl_multi_wakeup(g_multi);
+    while (g_polling) {
+        g_waiters++;
+        pthread_cond_wait(&g_polled, &g_lock);
+        g_waiters--;
+    }
+
+    for (int i = 0; i < HTTP_POOL_SIZE; i++) {
+        if (g_slots[i].busy) {
+            curl_multi_remove_handle(g_multi, g_slots[i].easy);
+        }
+        curl_slist_free_all(g_slots[i].headers);
+        curl_easy_cleanup(g_slots[i].easy);
+        free(g_slots[i].zbuf);
+    }
+    memset(g_slots, 0, sizeof(g_slots));
+    g_in_flight = 0;
+    g_finished_count = 0;
+
+    curl_multi_cleanup(g_multi);
+    g_multi = NULL;
+    curl_global_cleanup();
+    transport_unlock();
+}
+
+// Record a finished request; async ones queue for their callback
+static void complete_slot(HttpSlot* slot, bool success, long status) {
+    g_in_flight--;
+    slot->http_status = status;
+    slot->success = success;
+    slot->done = true;
+    if (slot->on_complete) g_finished[g_finished_count++] = slot;
+    else g_wake_all = true;
+
+    record_latency(monotonic_ns() - slot->start_ns);
+    if (slot->success) g_completed++;
+    else g_failed++;
+}
+
+// Release finished async slots and call them back, lock not held: a
+// callback may submit (and wait for a slot) like any other caller
+static void run_callbacks(void) {
+    HttpCallback calls[HTTP_POOL_SIZE];
+    transport_lock();
+    uint32_t count = g_finished_count;
+    for (uint32_t i = 0; i < count; i++) {
+        HttpSlot* slot = g_finished[i];
+        calls[i] = (HttpCallback){slot->on_complete, slot->user, slot->success, slot->http_status};
+        slot->busy = false;
+    }
+    g_finished_count = 0;
+    transport_unlock();
+
+    for (uint32_t i = 0; i < count; i++) {
+        calls[i].fn(calls[i].user, calls[i].success, calls[i].http_status);
+    }
+}
+
+// Hand requests started during curl_multi_poll to the multi handle
+static void add_pending(void) {
+    uint32_t count = g_pending_count;
+    g_pending_count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        HttpSlot* slot = g_pending[i];
+        if (curl_multi_add_handle(g_multi, slot->easy) != CURLM_OK) {
+            complete_slot(slot, false, 0);
+        }
+    }
+}
+
+static void process_completions(void) {
+    CURLMsg* msg;
+    int remaining;
+    while ((msg = curl_multi_info_read(g_multi, &remaining)) != NULL) {
+        if (msg->msg != CURLMSG_DONE) continue;
+
+        HttpSlot* slot = NULL;
+        curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&slot);
+        if (!slot) continue;
+
+        long status = 0;
+        long new_conns = 0;
+        curl_easy_getinfo(slot->easy, CURLINFO_RESPONSE_CODE, &status);
+        curl_easy_getinfo(slot->easy, CURLINFO_NUM_CONNECTS, &new_conns);
+        curl_multi_remove_handle(g_multi, slot->easy);
+
+        if (msg->data.result == CURLE_OK) {
+            // NUM_CONNECTS counts connections this transfer had to open
+            if (new_conns > 0) g_conn_opened += (uint64_t)new_conns;
+            else g_conn_reused++;
+        }
+        complete_slot(slot, msg->data.result == CURLE_OK && status >= 200 && status < 300, status);
+    }
+}
+
+// One round of the event loop, lock held. The lock is dropped while this
+// thread sleeps in curl_multi_poll; if another thread is already sleeping
+// there, wait up to timeout_ms for its round to finish instead.
+static void poll_locked(int timeout_ms) {
+    if (g_polling) {
+        if (timeout_ms <= 0) return;
+        struct timespec until;
+        clock_gettime(CLOCK_REALTIME, &until);
+        uint64_t nsec = (uint64_t)until.tv_nsec + (uint64_t)timeout_ms * 1000000ULL;
+        until.tv_sec += (time_t)(nsec / 1000000000ULL);
+        until.tv_nsec = (long)(nsec % 1000000000ULL);
+        g_waiters++;
+        pthread_cond_timedwait(&g_polled, &g_lock, &until);
+        g_waiters--;
+        // Nobody took the poller's place yet: hand the wake-up on
+        if (!g_polling && g_waiters > 0) pthread_cond_signal(&g_polled);
+        return;
+    }
+
+    int running = 0;
+    uint64_t finished = g_completed + g_failed;
+    curl_multi_perform(g_multi, &running);
+    process_completions();
+    // Anything that finished returns at once: a caller waiting on it should
+    // not sleep on behalf of the requests still in flight
+    if (g_in_flight > 0 && timeout_ms > 0 && g_completed + g_failed == finished) {
+        g_polling = true;
+        transport_unlock();
+        curl_multi_poll(g_multi, NULL, 0, timeout_ms, NULL);
+        transport_lock();
+        g_polling = false;
+        add_pending();
+        curl_multi_perform(g_multi, &running);
+        process_completions();
+        // Blocking posts that finished need their waiters; otherwise one
+        // waiter is enough to take over polling
+        if (g_waiters > 0 && g_wake_all) pthread_cond_broadcast(&g_polled);
+        else if (g_waiters > 0) pthread_cond_signal(&g_polled);
+        g_wake_all = false;
+    }
+}
+
+uint32_t http_transport_poll(int timeout_ms) {
+    transport_lock();
+    if (!g_multi) {
+        transport_unlock();
+        return 0;
+    }
+    poll_locked(timeout_ms);
+    uint32_t in_flight = g_in_flight;
+    transport_unlock();
+    run_callbacks();
+    return in_flight;
+}
+
+void http_transport_drain(void) {
+    while (http_transport_poll(100) > 0) {
+    }
+}
+
+static HttpSlot* acquire_slot(void) {
+    while (true) {
+        for (int i = 0; i < HTTP_POOL_SIZE; i++) {
+            if (!g_slots[i].busy && g_slots[i].easy) {
+                g_slots[i].busy = true;
+                return &g_slots[i];
+            }
+        }
+        // Pool exhausted: slots waiting on their callbacks free up once
+        // those run; otherwise make progress (or wait for the poller's
+        // round) until a handle frees up
+        if (g_finished_count > 0) {
+            transport_unlock();
+            run_callbacks();
+            transport_lock();
+        } else {
+            poll_locked(10);
+        }
+    }
+}
+
+// gzip the body into the slot's buffer. Returns the compressed size, or 0
+// to send it as is (disabled, too small, or no smaller once compressed).
+static size_t compress_body(HttpSlot* slot, const HttpRequest* req) {
+    int level = payload_codec_level(req->body_len);
+    if (!req->compress || !g_compression || level == 0) return 0;
+
+    if (slot->zcap < req->body_len) {
+        uint8_t* buf = (uint8_t*)realloc(slot->zbuf, req->body_len);
+        if (!buf) return 0;
+        slot->zbuf = buf;
+        slot->zcap = req->body_len;
+    }
+    return payload_codec_gzip(req->body, req->body_len, slot->zbuf, req->body_len, level);
+}
+
+static bool start_request(HttpSlot* slot, const HttpRequest* req, bool copy_body) {
+    CURL* curl = slot->easy;
+    char content_type[128];
+    size_t zlen = compress_body(slot, req);
+
+    curl_easy_reset(curl);
+    curl_slist_free_all(slot->headers);
+    snprintf(content_type, sizeof(content_type), "Content-Type: %s", req->content_type);
+    slot->headers = curl_slist_append(NULL, content_type);
+    if (zlen > 0) {
+        slot->headers = curl_slist_append(slot->headers, "Content-Encoding: " PAYLOAD_CODEC_ENCODING);
+    }
+
+    curl_easy_setopt(curl, CURLOPT_URL, req->url);
+    curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    if (zlen > 0) {
+        // The slot owns the compressed copy, so the caller's body is free already
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, (curl_off_t)zlen);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, slot->zbuf);
+    } else if (copy_body) {
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, (curl_off_t)req->body_len);
+        curl_easy_setopt(curl, CURLOPT_COPYPOSTFIELDS, req->body);
+    } else {
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, (curl_off_t)req->body_len);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req->body);
+    }
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, slot->headers);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, req->timeout_sec);
+    curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, discard_response);
+    curl_easy_setopt(curl, CURLOPT_PRIVATE, (char*)slot);
+
+    slot->done = false;
+    slot->success = false;
+    slot->http_status = 0;
+    slot->start_ns = monotonic_ns();
+
+    if (g_polling) {
+        // The poller holds the multi handle until it wakes
+        if (g_pending_count == 0) curl_multi_wakeup(g_multi);
+        g_pending[g_pending_count++] = slot;
+    } else if (curl_multi_add_handle(g_multi, curl) != CURLM_OK) {
+        slot->busy = false;
+        return false;
+    }
+    g_in_flight++;
+    g_bytes_raw += req->body_len;
+    g_bytes_wire += zlen > 0 ? zlen : req->body_len;
+    if (zlen > 0) g_compressed++;
+    return true;
+}
+
+bool http_transport_post(const HttpRequest* req, long* http_status) {
+    transport_lock();
+    if (!g_multi) {
+        transport_unlock();
+        return false;
+    }
+
+    HttpSlot* slot = acquire_slot();
+    slot->on_complete = NULL;
+    slot->user = NULL;
+    bool started = start_request(slot, req, false);
+    transport_unlock();
+    if (!started) return false;
+
+    // Drop the lock between polls so other threads can submit meanwhile
+    while (true) {
+        transport_lock();
+        bool done = slot->done;
+        transport_unlock();
+        if (done) break;
+        http_transport_poll(100);
+    }
+
+    transport_lock();
+    bool success = slot->success;
+    if (http_status) *http_status = slot->http_status;
+    slot->busy = false;
+    transport_unlock();
+    return success;
+}
+
+bool http_transport_post_async(const HttpRequest* req, HttpCompletionFn on_complete, void* user) {
+    transport_lock();
+    if (!g_multi) {
+        transport_unlock();
+        return false;
+    }
+
+    HttpSlot* slot = acquire_slot();
+    slot->on_complete = on_complete;
+    slot->user = user;
+    bool started = start_request(slot, req, req->copy_body);
+    if (started && !g_polling) {
+        // Kick the transfer off without waiting
+        int running = 0;
+        curl_multi_perform(g_multi, &running);
+    }
+    transport_unlock();
+    run_callbacks();
+    return started;
+}
+
+#else
+
+/* ============================================================================
+ * WINDOWS STUB (libcurl not available)
+ * ============================================================================ */
+
+static const uint32_t g_in_flight = 0;
+
+static void transport_lock(void) {
+}
+
+static void transport_unlock(void) {
+}
+
+bool http_transport_init(void) {
+    g_refcount++;
+    return true;
+}
+
+void http_transport_cleanup(void) {
+    if (g_refcount > 0) g_refcount--;
+}
+
+bool http_transport_post(const HttpRequest* req, long* http_status) {
+    printf("HTTP Transport: [STUB] Would POST %zu bytes to %s\n", req->body_len, req->url);
+    record_latency(0);
+    g_bytes_raw += req->body_len;
+    g_bytes_wire += req->body_len;
+    g_completed++;
+    g_conn_reused++;
+    if (http_status) *http_status = 200;
+    return true;
+}
+
+bool http_transport_post_async(const HttpRequest* req, HttpCompletionFn on_complete, void* user) {
+    long status = 0;
+    bool ok = http_transport_post(req, &status);
+    on_complete(user, ok, status);
+    return true;
+}
+
+uint32_t http_transport_poll(int timeout_ms) {
+    (void)timeout_ms;
+    return 0;
+}
+
+void http_transport_drain(void) {
+}
+
+#endif
+
+/* ============================================================================
+ * REPORTING
+ * ============================================================================ */
+
+void http_transport_set_compression(bool enabled) {
+    transport_lock();
+    g_compression = enabled;
+    transport_unlock();
+}
+
+bool http_transport_get_compression(void) {
+    return g_compression;
+}
+
+static double percentile(const uint32_t* sorted, uint32_t count, double pct) {
+    if (count == 0) return 0.0;
+    uint32_t idx = (uint32_t)(pct / 100.0 * (count - 1) + 0.5);
+    return (double)sorted[idx];
+}
+
+void http_transport_get_stats(HttpTransportStats* stats) {
+    memset(stats, 0, sizeof(HttpTransportStats));
+    transport_lock();
+    stats->requests_completed = g_completed;
+    stats->requests_failed = g_failed;
+    stats->connections_opened = g_conn_opened;
+    stats->connections_reused = g_conn_reused;
+    stats->in_flight = g_in_flight;
+    stats->body_bytes_raw = g_bytes_raw;
+    stats->body_bytes_wire = g_bytes_wire;
+    stats->requests_compressed = g_compressed;
+
+    uint32_t count = g_latency_count;
+    uint32_t* sorted = count ? (uint32_t*)malloc(count * sizeof(uint32_t)) : NULL;
+    if (sorted) memcpy(sorted, g_latency_us, count * sizeof(uint32_t));
+    transport_unlock();
+    if (!sorted) return;
+
+    qsort(sorted, count, sizeof(uint32_t), compare_u32);
+    stats->p50_us = percentile(sorted, count, 50.0);
+    stats->p90_us = percentile(sorted, count, 90.0);
+    stats->p99_us = percentile(sorted, count, 99.0);
+    stats->max_us = sorted[count - 1];
+    free(sorted);
+}
+
+void http_transport_print_stats(void) {
+    HttpTransportStats st;
+    http_transport_get_stats(&st);
+    printf("\nHTTP Transport:\n");
+    printf("  Requests ok/failed:   %lu / %lu\n", st.requests_completed, st.requests_failed);
+    printf("  Connections opened:   %lu\n", st.connections_opened);
+    printf("  Connections reused:   %lu\n", st.connections_reused);
+    if (st.body_bytes_raw > 0) {
+        printf("  Body bytes raw/wire:  %lu / %lu (%.1f%% saved, %lu gzip requests)\n",
+               st.body_bytes_raw, st.body_bytes_wire,
+               100.0 * (1.0 - (double)st.body_bytes_wire / st.body_bytes_raw),
+               st.requests_compressed);
+    }
+    printf("  Latency p50/p90/p99:  %.0f / %.0f / %.0f us (max %.0f us)\n",
+           st.p50_us, st.p90_us, st.p99_us, st.max_us);
+}
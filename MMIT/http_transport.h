@@ -0,0 +1,78 @@
+/*
+ * BlackBox DPU - HTTP Transport
+ * Shared libcurl transport: one multi handle, pooled kept-alive connections
+ */
+
+#ifndef HTTP_TRANSPORT_H
+#define HTTP_TRANSPORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Concurrent requests (and pooled easy handles) per process
+#define HTTP_POOL_SIZE          16
+// Latency samples kept for percentile reporting
+#define HTTP_LATENCY_SAMPLES    4096
+// Request-body compression switch at startup (see http_transport_set_compression)
+#define HTTP_COMPRESSION_DEFAULT    true
+
+// Called once an async request finishes (see the threading note below).
+// success = transfer completed with a 2xx status.
+typedef void (*HttpCompletionFn)(void* user, bool success, long http_status);
+
+typedef struct {
+    const char* url;
+    const char* content_type;
+    const void* body;
+    size_t body_len;
+    long timeout_sec;
+    bool copy_body;          // Async only: copy body so caller may free it
+    bool compress;           // gzip the body when large enough and it helps
+} HttpRequest;
+
+typedef struct {
+    uint64_t requests_completed;
+    uint64_t requests_failed;
+    uint64_t connections_opened;
+    uint64_t connections_reused;
+    uint32_t in_flight;
+    uint64_t body_bytes_raw;       // Request bodies before compression
+    uint64_t body_bytes_wire;      // Request bodies as sent
+    uint64_t requests_compressed;
+    double p50_us;
+    double p90_us;
+    double p99_us;
+    double max_us;
+} HttpTransportStats;
+
+// Reference-counted: every module calls init/cleanup in pairs.
+// All functions may be called from any thread; completion callbacks run on
+// whichever thread is polling or submitting, outside the transport lock and
+// possibly on several threads at once.
+bool http_transport_init(void);
+void http_transport_cleanup(void);
+
+// Blocking POST on a pooled handle. Other in-flight requests keep progressing
+// while this waits. http_status may be NULL.
+bool http_transport_post(const HttpRequest* req, long* http_status);
+
+// Non-blocking POST. Waits only if every pooled handle is busy. Unless
+// copy_body is set, req->body must stay valid until on_complete runs.
+bool http_transport_post_async(const HttpRequest* req, HttpCompletionFn on_complete, void* user);
+
+// Drive the event loop for up to timeout_ms, or wait that long on the thread
+// already driving it; returns requests still in flight
+uint32_t http_transport_poll(int timeout_ms);
+
+// Poll until nothing is in flight (bounded by the request timeouts)
+void http_transport_drain(void);
+
+// Enable or disable gzip for requests that set compress (process-wide)
+void http_transport_set_compression(bool enabled);
+bool http_transport_get_compression(void);
+
+void http_transport_get_stats(HttpTransportStats* stats);
+void http_transport_print_stats(void);
+
+#endif // HTTP_TRANSPORT_H
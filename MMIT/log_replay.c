@@ -0,0 +1,179 @@
+/*
+ * BlackBox DPU - Log Replay Implementation
+ */
+
+#include "log_replay.h"
+#include "nvme_controller.h"
+#include "zstd_accelerator.h"
+#include "telemetry_wire.h"
+#include "rate_scheduler.h"
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+/* ============================================================================
+ * LOG READER
+ * ============================================================================ */
+
+bool log_reader_open(LogReader* reader, BlackBoxSoC* soc) {
+    memset(reader, 0, sizeof(LogReader));
+    reader->soc = soc;
+
+    uint32_t count = 0;
+    uint32_t raw_max = 0;
+    for (LogIndex* e = soc->log_index; e; e = e->next) {
+        count++;
+        if (e->uncompressed_size > raw_max) raw_max = e->uncompressed_size;
+    }
+    if (count == 0) return false;
+
+    // The live list is newest-first
+    reader->blocks = (LogIndex**)malloc(count * sizeof(LogIndex*));
+    reader->raw = (uint8_t*)malloc(raw_max > 0 ? raw_max : 1);
+    if (!reader->blocks || !reader->raw) {
+        log_reader_close(reader);
+        return false;
+    }
+    uint32_t i = count;
+    for (LogIndex* e = soc->log_index; e; e = e->next) {
+        reader->blocks[--i] = e;
+    }
+    reader->block_count = count;
+    reader->raw_cap = raw_max;
+    return true;
+}
+
+void log_reader_close(LogReader* reader) {
+    free(reader->blocks);
+    free(reader->raw);
+    reader->blocks = NULL;
+    reader->raw = NULL;
+    reader->block_count = 0;
+}
+
+// Decompress the next block into raw. Returns false at the end of the log.
+static bool log_reader_load_block(LogReader* reader) {
+    while (reader->next_block < reader->block_count) {
+        const LogIndex* e = reader->blocks[reader->next_block++];
+        reader->raw_len = 0;
+        reader->raw_pos = 0;
+
+        NVMeRegion region;
+        if (!nvme_map_region(reader->soc, e->file_offset, e->compressed_size, &region)) {
+            reader->blocks_skipped++;
+            continue;
+        }
+        uint32_t n = simple_decompress(region.data, region.length, reader->raw, reader->raw_cap);
+        nvme_unmap_region(&region);
+
+        // A length that disagrees with the index means a damaged block
+        MMITTelemetryPacket probe;
+        if (n == 0 || n != e->uncompressed_size ||
+            telemetry_wire_decode(reader->raw, n, &probe) == 0) {
+            reader->blocks_skipped++;
+            continue;
+        }
+        reader->raw_len = n;
+        reader->blocks_read++;
+        reader->bytes_compressed += e->compressed_size;
+        reader->bytes_raw += n;
+        return true;
+    }
+    return false;
+}
+
+bool log_reader_next(LogReader* reader, MMITTelemetryPacket* packet) {
+    for (;;) {
+        if (reader->raw_pos < reader->raw_len) {
+            size_t n = telemetry_wire_decode(reader->raw + reader->raw_pos,
+                                             reader->raw_len - reader->raw_pos, packet);
+            if (n > 0) {
+                reader->raw_pos += (uint32_t)n;
+                reader->records++;
+                return true;
+            }
+            // Records carry their own length, so nothing after a bad one can
+            // be trusted: drop the rest of the block
+            reader->records_truncated++;
+            reader->raw_pos = reader->raw_len;
+        }
+        if (!log_reader_load_block(reader)) return false;
+    }
+}
+
+/* ============================================================================
+ * REPLAY CLOCK
+ * ============================================================================ */
+
+void replay_clock_init(ReplayClock* clock, double speed) {
+    memset(clock, 0, sizeof(ReplayClock));
+    clock->speed = speed;
+#ifdef __linux__
+    // Same tight timer slack as the fixed-rate scheduler
+    prctl(PR_SET_TIMERSLACK, 1UL);
+#endif
+}
+
+void replay_clock_wait(ReplayClock* clock, uint64_t timestamp_ns) {
+    uint64_t now = monotonic_ns();
+    if (!clock->started) {
+        clock->started = true;
+        clock->first_ts_ns = timestamp_ns;
+        clock->last_ts_ns = timestamp_ns;
+        clock->wall_start_ns = now;
+        clock->last_due_ns = now;
+    }
+    clock->samples++;
+
+    // Never schedule backwards: an out-of-order sample goes out right away
+    if (timestamp_ns < clock->last_ts_ns) {
+        clock->out_of_order++;
+    } else {
+        clock->last_ts_ns = timestamp_ns;
+    }
+    if (clock->speed <= 0.0) {
+        clock->last_due_ns = now;
+        return;
+    }
+
+    uint64_t offset = (uint64_t)((clock->last_ts_ns - clock->first_ts_ns) / clock->speed);
+    uint64_t due = clock->wall_start_ns + offset;
+    if (due < clock->last_due_ns) due = clock->last_due_ns;
+    clock->last_due_ns = due;
+
+    rate_scheduler_sleep_until(due);
+    uint64_t woke = monotonic_ns();
+    uint64_t late = woke > due ? woke - due : 0;
+    clock->late_ns[clock->late_next] = late > UINT32_MAX ? UINT32_MAX : (uint32_t)late;
+    clock->late_next = (clock->late_next + 1) % REPLAY_LATENESS_SAMPLES;
+    if (clock->late_count < REPLAY_LATENESS_SAMPLES) clock->late_count++;
+}
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+void replay_clock_get_stats(const ReplayClock* clock, ReplayClockStats* stats) {
+    memset(stats, 0, sizeof(ReplayClockStats));
+    stats->samples = clock->samples;
+    stats->out_of_order = clock->out_of_order;
+    if (!clock->started) return;
+
+    stats->recorded_s = (clock->last_ts_ns - clock->first_ts_ns) / 1e9;
+    stats->wall_s = (monotonic_ns() - clock->wall_start_ns) / 1e9;
+    if (stats->wall_s > 0) stats->achieved_speed = stats->recorded_s / stats->wall_s;
+
+    uint32_t count = clock->late_count;
+    if (count == 0) return;
+    uint32_t* sorted = (uint32_t*)malloc(count * sizeof(uint32_t));
+    if (!sorted) return;
+    memcpy(sorted, clock->late_ns, count * sizeof(uint32_t));
+    qsort(sorted, count, sizeof(uint32_t), compare_u32);
+    stats->late_p50_us = sorted[(uint32_t)(0.50 * (count - 1) + 0.5)] / 1000.0;
+    stats->late_p99_us = sorted[(uint32_t)(0.99 * (count - 1) + 0.5)] / 1000.0;
+    stats->late_max_us = sorted[count - 1] / 1000.0;
+    free(sorted);
+}
@@ -0,0 +1,88 @@
+/*
+ * BlackBox DPU - Log Replay
+ * Reads telemetry back out of the NVMe log through its index and paces it
+ * on the recorded timeline, scaled by a speed factor
+ */
+
+#ifndef LOG_REPLAY_H
+#define LOG_REPLAY_H
+
+#include "blackbox_common.h"
+#include "telemetry_sender.h"
+
+// Emit lateness samples kept for percentile reporting
+#define REPLAY_LATENESS_SAMPLES     4096
+
+// Walks indexed blocks oldest first, decompresses each and yields the
+// telemetry wire records inside (telemetry_wire.h). Blocks that do not start
+// with a wire record (e.g. test-suite data) are skipped whole.
+typedef struct {
+    BlackBoxSoC* soc;
+    LogIndex** blocks;           // File order
+    uint32_t block_count;
+    uint32_t next_block;
+
+    uint8_t* raw;                // Current decompressed block
+    uint32_t raw_cap;
+    uint32_t raw_len;
+    uint32_t raw_pos;
+
+    uint64_t blocks_read;
+    uint64_t blocks_skipped;     // Not telemetry, unreadable or corrupt
+    uint64_t bytes_compressed;
+    uint64_t bytes_raw;
+    uint64_t records;
+    uint64_t records_truncated;  // Blocks cut short by an undecodable record
+} LogReader;
+
+// Maps recorded timestamps onto the wall clock: a sample recorded t after
+// the first is due t / speed after replay started. speed <= 0 = unpaced.
+typedef struct {
+    double speed;
+    bool started;
+    uint64_t first_ts_ns;
+    uint64_t last_ts_ns;
+    uint64_t wall_start_ns;
+    uint64_t last_due_ns;
+    uint64_t samples;
+    uint64_t out_of_order;       // Timestamps earlier than their predecessor
+    uint32_t late_ns[REPLAY_LATENESS_SAMPLES];
+    uint32_t late_count;
+    uint32_t late_next;
+} ReplayClock;
+
+typedef struct {
+    uint64_t samples;
+    uint64_t out_of_order;
+    double recorded_s;           // First to last timestamp
+    double wall_s;               // Replay start to the last emit
+    double achieved_speed;       // recorded_s / wall_s
+    double late_p50_us;          // Emit time past the scaled deadline
+    double late_p99_us;
+    double late_max_us;
+} ReplayClockStats;
+
+/* ============================================================================
+ * LOG READER FUNCTIONS
+ * ============================================================================ */
+
+// Snapshot soc->log_index (load it with blackbox_soc_init(..., resume_log =
+// true)). Returns false if the log has no indexed blocks.
+bool log_reader_open(LogReader* reader, BlackBoxSoC* soc);
+void log_reader_close(LogReader* reader);
+
+// Next telemetry packet in log order; false once the log is exhausted
+bool log_reader_next(LogReader* reader, MMITTelemetryPacket* packet);
+
+/* ============================================================================
+ * REPLAY CLOCK FUNCTIONS
+ * ============================================================================ */
+
+void replay_clock_init(ReplayClock* clock, double speed);
+
+// Sleep until the sample recorded at timestamp_ns is due
+void replay_clock_wait(ReplayClock* clock, uint64_t timestamp_ns);
+
+void replay_clock_get_stats(const ReplayClock* clock, ReplayClockStats* stats);
+
+#endif // LOG_REPLAY_H
@@ -6,8 +6,17 @@
 #include <unistd.h>
 #include "soc_core.h"
 #include "telemetry_sender.h"
+#include "telemetry_wire.h"
+#include "telemetry_spool.h"
 #include "network_config.h"
 #include "realistic_drive_sim.h"
+#include "backlog_redemption.h"
+#include "http_transport.h"
+#include "rate_scheduler.h"
+#include "fleet_sim.h"
+#include "log_replay.h"
+#include "telemetry_packer.h"
+#include "bench.h"
 
 /* ============================================================================
  * TEST DATA GENERATION
@@ -167,31 +176,179 @@ void display_live_telemetry(const MMITTelemetryPacket* packet, int update_count)
     fflush(stdout);
 }
 
-void run_live_telemetry_streaming(BlackBoxSoC* soc, int num_updates) {
+// Options for the live streaming mode (set from the command line)
+typedef struct {
+    int num_updates;
+    uint32_t batch_packets;      // <= 1: one POST per packet
+    uint32_t batch_latency_ms;
+    TelemetryFormat format;
+    bool async_send;             // Sender thread + SPSC queue
+    uint32_t queue_capacity;
+    SpscOverflowPolicy queue_policy;
+    bool spool;                  // Park undelivered packets on disk
+    TelemetryTransport transport;
+    uint32_t rate_hz;            // Sample rate (fixed-rate scheduler)
+    double warp;                 // Simulated / wall time; 0 = as fast as possible
+    bool display;                // Live terminal line
+    bool network;                // Send to the backend
+    bool record;                 // Log to NVMe through the blackbox pipeline
+} StreamOptions;
+
+void stream_options_defaults(StreamOptions* opts) {
+    opts->num_updates = 60;
+    opts->batch_packets = 0;
+    opts->batch_latency_ms = TELEMETRY_BATCH_MAX_LATENCY_MS;
+    opts->format = TELEMETRY_FORMAT_JSON;
+    opts->async_send = true;
+    opts->queue_capacity = TELEMETRY_QUEUE_CAPACITY;
+    opts->queue_policy = TELEMETRY_QUEUE_POLICY;
+    opts->spool = true;
+    opts->transport = TELEMETRY_DEFAULT_TRANSPORT;
+    opts->rate_hz = 1;
+    opts->warp = 1.0;
+    opts->display = true;
+    opts->network = true;
+    opts->record = true;
+}
+
+// Connect the telemetry sender with the streaming options
+static void stream_start_sender(const StreamOptions* opts) {
+    telemetry_sender_init(BACKEND_API_HOST, BACKEND_API_PORT);
+    telemetry_sender_set_format(opts->format);
+    telemetry_sender_set_transport(opts->transport);
+    if (opts->transport == TELEMETRY_TRANSPORT_WEBSOCKET) {
+        printf("Transport: WebSocket ws://%s:%d/ws/telemetry/{vehicle_id}\n",
+               BACKEND_API_HOST, BACKEND_API_PORT);
+    }
+    if (opts->format == TELEMETRY_FORMAT_BINARY) {
+        printf("Payload format: %s\n", TELEMETRY_WIRE_CONTENT_TYPE);
+    }
+    if (opts->batch_packets > 1) {
+        telemetry_sender_set_batching(opts->batch_packets, opts->batch_latency_ms);
+        printf("Batching: up to %u packets / %u ms per request\n",
+               opts->batch_packets, opts->batch_latency_ms);
+    }
+    if (opts->spool && telemetry_sender_enable_spool(TELEMETRY_SPOOL_DIR)) {
+        printf("Offline spool: %s/ (max %d MiB)\n", TELEMETRY_SPOOL_DIR,
+               (int)((uint64_t)TELEMETRY_SPOOL_SEGMENT_BYTES * TELEMETRY_SPOOL_MAX_SEGMENTS >> 20));
+    }
+    // Time warp outpaces any queue: send inline so the network paces the run
+    // instead of the queue dropping samples
+    if (opts->async_send && opts->warp == 1.0 &&
+        telemetry_sender_start_async(opts->queue_capacity, opts->queue_policy)) {
+        printf("Sender thread: queue %u packets, on overflow drop %s\n", opts->queue_capacity,
+               opts->queue_policy == SPSC_DROP_OLDEST ? "oldest" : "newest");
+    }
+}
+
+typedef struct {
+    TelemetrySenderStats stats;
+    SpscRingStats queue;
+    WsClientStats ws;
+} StreamSenderSummary;
+
+// Drain and disconnect the sender, keeping its final counters
+static void stream_stop_sender(StreamSenderSummary* sent) {
+    memset(sent, 0, sizeof(StreamSenderSummary));
+    telemetry_sender_stop_async();
+    telemetry_sender_flush();
+    telemetry_sender_get_stats(&sent->stats);
+    telemetry_sender_get_queue_stats(&sent->queue);
+    telemetry_sender_get_ws_stats(&sent->ws);
+    telemetry_sender_cleanup();
+}
+
+static void stream_print_sender_summary(const StreamOptions* opts, const StreamSenderSummary* sent) {
+    printf("  Successful:    %lu\n", sent->stats.packets_sent);
+    printf("  Failed:        %lu\n", sent->stats.packets_failed);
+    printf("  HTTP requests: %lu\n", sent->stats.requests);
+    if (sent->queue.capacity > 0) {
+        printf("  Queue:         peak %lu / %lu, dropped %lu\n",
+               sent->queue.high_water, sent->queue.capacity, sent->queue.dropped);
+    }
+    if (sent->stats.packets_spooled > 0 || sent->stats.spool_pending > 0) {
+        printf("  Spool:         %lu spooled, %lu replayed, %lu pending, %lu dropped\n",
+               sent->stats.packets_spooled, sent->stats.packets_replayed,
+               sent->stats.spool_pending, sent->stats.spool_dropped);
+    }
+    if (sent->stats.fields_offered > 0) {
+        printf("  Deadband:      %lu / %lu fields sent (%.1f%%), %lu packets suppressed\n",
+               sent->stats.fields_sent, sent->stats.fields_offered,
+               100.0 * sent->stats.fields_sent / sent->stats.fields_offered,
+               sent->stats.packets_suppressed);
+    }
+    if (opts->transport == TELEMETRY_TRANSPORT_WEBSOCKET) {
+        printf("  WebSocket:     %lu frames, %lu connects, %lu failed connects, %lu drops\n",
+               sent->ws.frames_sent, sent->ws.connects, sent->ws.connect_failures,
+               sent->ws.disconnects);
+    }
+    http_transport_print_stats();
+}
+
+void run_live_telemetry_streaming(BlackBoxSoC* soc, const StreamOptions* opts) {
+    int num_updates = opts->num_updates;
     printf("\nMMIT BLACKBOX - Live Telemetry Streaming (Realistic 10-Hour Drive)\n");
-    printf("Backend: http://%s:%d\n", BACKEND_API_HOST, BACKEND_API_PORT);
+    if (opts->network) {
+        printf("Backend: http://%s:%d\n", BACKEND_API_HOST, BACKEND_API_PORT);
+    } else {
+        printf("Backend: disabled (--no-network)\n");
+    }
     
     // Initialize realistic driving simulation
     init_realistic_drive_simulation();
     
     // Initialize telemetry sender
-    telemetry_sender_init(BACKEND_API_HOST, BACKEND_API_PORT);
+    if (opts->network) stream_start_sender(opts);
+    
+    // Record locally whatever happens to the network
+    TelemetryPacker packer;
+    bool recording = opts->record && telemetry_packer_init(&packer, soc, 0);
+    if (recording) {
+        printf("Recording: NVMe log, %u KiB blocks\n", packer.cap / 1024);
+    }
     
+    // Try the link: whatever the log holds past the cloud watermark goes
+    // up in the idle time of each tick once a block is acknowledged
+    uint64_t redeemed_before = soc->redemption.blocks_redeemed;
+    uint64_t retry_ns = 0;
+    if (opts->network) cloud_sync_probe(soc);
+
     printf("Starting realistic drive simulation...\n");
     printf("Full tank: 100%% fuel | Starting from cold engine\n\n");
-    
-    int successful_sends = 0;
-    
+
+    // Deadlines are absolute, so send time does not stretch the period
+    RateScheduler* sched = (RateScheduler*)malloc(sizeof(RateScheduler));
+    rate_scheduler_init(sched, opts->rate_hz);
+    if (opts->warp != 1.0) rate_scheduler_set_warp(sched, opts->warp);
+    double period_s = (double)sched->sim_period_ns / 1e9;
+    printf("Sample rate: %u Hz", sched->rate_hz);
+    if (opts->warp <= 0.0) printf(", time warp: max\n");
+    else if (opts->warp != 1.0) printf(", time warp: %gx\n", opts->warp);
+    else printf("\n");
+
+    // Packets carry simulated time, so a warped run still spans the full drive
+    uint64_t sim_start_ns = telemetry_now_ns();
+    uint64_t sim_ns = 0;
+    uint64_t progress_every_ns = (opts->warp == 1.0 ? 60ULL : 3600ULL) * 1000000000ULL;
+    uint64_t next_progress_ns = progress_every_ns;
+    uint64_t last_display_ns = 0;
+    uint64_t wall_start_ns = monotonic_ns();
+
     for (int i = 0; i < num_updates; i++) {
+        // Skipped deadlines still advance simulated time
+        uint32_t periods = rate_scheduler_wait(sched);
+        sim_ns += periods * sched->sim_period_ns;
+
         // Create telemetry packet structure
         MMITTelemetryPacket packet;
         
         // Initialize vehicle ID
         strncpy(packet.vehicle_id, "BENYON_001", sizeof(packet.vehicle_id) - 1);
         packet.vehicle_id[sizeof(packet.vehicle_id) - 1] = '\0';
+        packet.timestamp_ns = sim_start_ns + sim_ns;
         
         // Use realistic driving simulation to fill the packet directly
-        update_realistic_drive_simulation(&packet, 1.0); // 1 second delta
+        update_realistic_drive_simulation(&packet, periods * period_s);
         
         // Add system stats (simulated)
         packet.cpu_usage_pct = 45.0 + (i % 10) * 2.0;
@@ -201,37 +358,179 @@ void run_live_telemetry_streaming(BlackBoxSoC* soc, int num_updates) {
         packet.abs_active = false;
         packet.traction_control = true;
         
-        // Display live telemetry in terminal
-        display_live_telemetry(&packet, i + 1);
-        
-        // Send to backend (non-verbose to keep display clean)
-        if (telemetry_send_to_backend(&packet)) {
-            successful_sends++;
+        // Display live telemetry in terminal (at most ~10 refreshes a second)
+        uint64_t now_ns = monotonic_ns();
+        if (opts->display && now_ns - last_display_ns >= 100000000ULL) {
+            display_live_telemetry(&packet, i + 1);
+            last_display_ns = now_ns;
         }
         
-        // Wait 1 second between updates
-        sleep(1);
+        // Hand off to the sender thread (never blocks on the network)
+        if (opts->network) telemetry_sender_submit(&packet);
+        if (recording) telemetry_packer_append(&packer, &packet);
         
         // Advance simulation time
-        soc->event_queue.current_time += 1000000000ULL; // 1 second in nanoseconds
+        soc->event_queue.current_time += periods * sched->sim_period_ns;
         
-        // Print simulation progress every 60 updates
-        if ((i + 1) % 60 == 0) {
+        // Print simulation progress every simulated minute (hour when warped)
+        if (sim_ns >= next_progress_ns) {
             double hours = get_simulation_elapsed_hours();
             double fuel = get_simulation_fuel_level();
             printf("\n[Simulation] Elapsed: %.2f hours | Fuel: %.1f%%\n\n", hours, fuel);
+            next_progress_ns += progress_every_ns;
+        }
+
+        // Idle until the next deadline: keep the cloud in step with the log,
+        // quietly retrying a link that stalled it every REDEMPTION_RETRY_MS
+        if (opts->network) {
+            redemption_pump(soc, REDEMPTION_WINDOW);
+            if (!soc->cloud_sync.connected) {
+                if (now_ns >= retry_ns) cloud_sync_probe(soc);
+            } else {
+                retry_ns = now_ns + REDEMPTION_RETRY_MS * 1000000ULL;
+                if (!soc->cloud_sync.redemption_in_progress && !redemption_is_drained(soc)) {
+                    redemption_start(soc);
+                }
+            }
         }
     }
+    double wall_s = (monotonic_ns() - wall_start_ns) / 1e9;
+
+    // Let the uploads in flight land so the watermark covers them
+    while (opts->network && soc->cloud_sync.redemption_in_progress &&
+           soc->redemption.window_count > 0) {
+        redemption_pump(soc, 0);
+        usleep(10000);
+    }
     
-    telemetry_sender_cleanup();
+    RateSchedulerStats sched_stats;
+    rate_scheduler_get_stats(sched, &sched_stats);
+    free(sched);
+    if (recording) telemetry_packer_close(&packer);
+
+    StreamSenderSummary sent;
+    if (opts->network) stream_stop_sender(&sent);
     
     // Final summary
     printf("\n");
     printf("════════════════════════════════════════════════════════════════════\n");
     printf("  Streaming Complete!\n");
     printf("  Total Updates: %d\n", num_updates);
-    printf("  Successful:    %d\n", successful_sends);
-    printf("  Failed:        %d\n", num_updates - successful_sends);
+    printf("  Simulated:     %.2f h in %.2f s wall (%.1fx real time)\n",
+           sim_ns / 3.6e12, wall_s, sched_stats.warp);
+    if (opts->warp == 1.0) {
+        printf("  Schedule:      %u Hz target, %.2f Hz achieved, %lu missed deadlines\n",
+               sched_stats.rate_hz, sched_stats.achieved_hz, sched_stats.missed);
+        printf("  Wake jitter:   p50 %.1f us, p99 %.1f us, max %.1f us\n",
+               sched_stats.jitter_p50_us, sched_stats.jitter_p99_us, sched_stats.jitter_max_us);
+    } else {
+        printf("  Schedule:      %.0f samples/s wall, %lu missed deadlines\n",
+               sched_stats.achieved_hz, sched_stats.missed);
+    }
+    if (recording) {
+        printf("  Recorded:      %lu packets in %lu blocks, %lu -> %lu bytes (%.1f%%), %lu dropped\n",
+               packer.packets, packer.blocks, packer.bytes_raw, packer.bytes_compressed,
+               packer.bytes_raw > 0 ? 100.0 * packer.bytes_compressed / packer.bytes_raw : 0.0,
+               packer.packets_dropped);
+        printf("  Record cost:   %.0f ns/packet\n",
+               packer.packets > 0 ? (double)packer.busy_ns / packer.packets : 0.0);
+        // The index is keyed on capture time: look up the middle of the drive
+        LogIndex* mid = query_log_by_timestamp(soc, sim_start_ns + sim_ns / 2);
+        if (mid) {
+            printf("  Index lookup:  mid-drive sample in block @%lu (%u bytes)\n",
+                   mid->file_offset, mid->compressed_size);
+        }
+    }
+    if (!opts->network) {
+        printf("════════════════════════════════════════════════════════════════════\n");
+        printf("\n");
+        return;
+    }
+    printf("  Backlog:       %lu blocks redeemed, %lu bytes behind the log (%s)\n",
+           soc->redemption.blocks_redeemed - redeemed_before, soc->cloud_sync.backlog_bytes,
+           !soc->cloud_sync.connected ? "link down" :
+           soc->cloud_sync.probing ? "link unconfirmed" : "link up");
+    stream_print_sender_summary(opts, &sent);
+    printf("════════════════════════════════════════════════════════════════════\n");
+    printf("\n");
+}
+
+// Re-emit the telemetry recorded in the NVMe log on its original timeline,
+// speed times faster (speed <= 0: as fast as the sinks accept it)
+void run_log_replay(BlackBoxSoC* soc, const StreamOptions* opts, double speed) {
+    printf("\nMMIT BLACKBOX - Log Replay (%s)\n", NVME_STORAGE_PATH);
+
+    LogReader reader;
+    if (!log_reader_open(&reader, soc)) {
+        printf("No indexed blocks in %s / %s\n", NVME_STORAGE_PATH, NVME_INDEX_PATH);
+        return;
+    }
+    printf("Log: %u indexed blocks, %lu bytes\n", reader.block_count, soc->nvme.bytes_written);
+    if (speed <= 0.0) printf("Speed: max\n");
+    else printf("Speed: %gx recorded time\n", speed);
+
+    // Warped replays send inline, exactly like warped streaming
+    StreamOptions send_opts = *opts;
+    send_opts.warp = speed;
+    if (opts->network) {
+        printf("Backend: http://%s:%d\n", BACKEND_API_HOST, BACKEND_API_PORT);
+        stream_start_sender(&send_opts);
+    }
+    printf("\n");
+
+    ReplayClock* clock = (ReplayClock*)malloc(sizeof(ReplayClock));
+    if (!clock) {
+        log_reader_close(&reader);
+        return;
+    }
+    replay_clock_init(clock, speed);
+
+    MMITTelemetryPacket packet;
+    uint64_t last_display_ns = 0;
+    uint64_t emitted = 0;
+    while (log_reader_next(&reader, &packet)) {
+        replay_clock_wait(clock, packet.timestamp_ns);
+        emitted++;
+
+        uint64_t now_ns = monotonic_ns();
+        if (opts->display && now_ns - last_display_ns >= 100000000ULL) {
+            display_live_telemetry(&packet, (int)emitted);
+            last_display_ns = now_ns;
+        }
+        if (opts->network) telemetry_sender_submit(&packet);
+    }
+
+    ReplayClockStats timing;
+    replay_clock_get_stats(clock, &timing);
+    free(clock);
+
+    StreamSenderSummary sent;
+    if (opts->network) stream_stop_sender(&sent);
+
+    printf("\n");
+    printf("════════════════════════════════════════════════════════════════════\n");
+    printf("  Replay Complete!\n");
+    printf("  Packets:       %lu from %lu blocks (%lu skipped, %lu cut short)\n", emitted,
+           reader.blocks_read, reader.blocks_skipped, reader.records_truncated);
+    printf("  Log bytes:     %lu compressed, %lu decoded\n", reader.bytes_compressed,
+           reader.bytes_raw);
+    printf("  Recorded:      %.2f s replayed in %.2f s wall (%.1fx)\n", timing.recorded_s,
+           timing.wall_s, timing.achieved_speed);
+    printf("  Throughput:    %.0f packets/s, %.2f MB/s decoded\n",
+           timing.wall_s > 0 ? emitted / timing.wall_s : 0.0,
+           timing.wall_s > 0 ? reader.bytes_raw / timing.wall_s / 1e6 : 0.0);
+    if (speed > 0.0) {
+        double target_s = timing.recorded_s / speed;
+        printf("  Timing:        %.3f%% off the scaled timeline, emit lateness p50 %.1f us, "
+               "p99 %.1f us, max %.1f us\n",
+               target_s > 0 ? 100.0 * (timing.wall_s - target_s) / target_s : 0.0,
+               timing.late_p50_us, timing.late_p99_us, timing.late_max_us);
+    }
+    if (timing.out_of_order > 0) {
+        printf("  Out of order:  %lu samples sent without waiting\n", timing.out_of_order);
+    }
+    log_reader_close(&reader);
+    if (opts->network) stream_print_sender_summary(opts, &sent);
     printf("════════════════════════════════════════════════════════════════════\n");
     printf("\n");
 }
@@ -265,6 +564,137 @@ void run_cloud_transfer_test(BlackBoxSoC* soc) {
     handle_cloud_transfer_request(soc, target_timestamp, "SECRET_KEY_123");
 }
 
+/* ============================================================================
+ * TEST 7: BACKLOG REDEMPTION
+ * ============================================================================ */
+
+void run_backlog_redemption_test(BlackBoxSoC* soc) {
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*         Test 7: Backlog Redemption Engine               *\n");
+    printf("************************************************************\n");
+
+    // Log a few blocks while the cloud link is down
+    cloud_sync_handle_disconnect(soc);
+    const uint32_t BLOCK_SIZE = 8 * 1024;
+    uint8_t* test_data = (uint8_t*)malloc(BLOCK_SIZE);
+    bool old_verbose = soc->verbose;
+    soc->verbose = false;
+    for (uint32_t block = 0; block < 4; block++) {
+        generate_test_data(test_data, BLOCK_SIZE);
+        test_data[0] = (uint8_t)block;
+        blackbox_process_data_block(soc, test_data, BLOCK_SIZE);
+    }
+    soc->verbose = old_verbose;
+    free(test_data);
+
+    printf("Backlog before reconnect: %lu bytes (watermark offset %lu)\n",
+           soc->cloud_sync.backlog_bytes, soc->cloud_sync.last_sync_offset);
+
+    // Reconnect and drain within the rate limit, keeping the window full
+    cloud_sync_handle_reconnect(soc);
+    uint32_t ticks = 0;
+    while (soc->cloud_sync.redemption_in_progress && ticks < 100) {
+        redemption_pump(soc, REDEMPTION_WINDOW);
+        usleep(10000);
+        ticks++;
+    }
+
+    printf("Backlog after %u ticks:   %lu bytes (%s)\n", ticks,
+           soc->cloud_sync.backlog_bytes,
+           redemption_is_drained(soc) ? "drained" : "stalled - will resume from watermark");
+}
+
+/* ============================================================================
+ * TEST: OFFLINE SPOOL (OUTAGE + REPLAY)
+ * ============================================================================ */
+
+void run_spool_test(int count, TelemetryFormat format) {
+    const char* dir = TELEMETRY_SPOOL_DIR "_test";
+    printf("\n");
+    printf("************************************************************\n");
+    printf("*        Test: Offline Spool (Outage and Replay)           *\n");
+    printf("************************************************************\n");
+    printf("Simulating %d s of driving (%.1f h at 1 Hz) with the backend down\n",
+           count, count / 3600.0);
+
+    // Outage: nothing listens on port 1, so every send fails fast
+    telemetry_sender_init(BACKEND_API_HOST, 1);
+    telemetry_sender_set_format(format);
+    telemetry_sender_enable_spool(dir);
+    init_realistic_drive_simulation();
+
+    uint64_t ts = telemetry_now_ns();
+    uint64_t start = monotonic_ns();
+    for (int i = 0; i < count; i++) {
+        MMITTelemetryPacket packet;
+        memset(&packet, 0, sizeof(packet));
+        snprintf(packet.vehicle_id, sizeof(packet.vehicle_id), "BENYON_001");
+        packet.timestamp_ns = ts + (uint64_t)i * 1000000000ULL;
+        update_realistic_drive_simulation(&packet, 1.0);
+        telemetry_sender_enqueue(&packet);
+    }
+    double spool_s = (monotonic_ns() - start) / 1e9;
+
+    TelemetrySenderStats stats;
+    telemetry_sender_get_stats(&stats);
+    printf("  Spooled:  %lu packets in %.2f s (pending %lu, dropped %lu)\n",
+           stats.packets_spooled, spool_s, stats.spool_pending, stats.spool_dropped);
+    telemetry_sender_cleanup();
+
+    // Recovery: a fresh sender resumes the spool from disk and drains it
+    printf("Backend back at %s:%d, replaying...\n", BACKEND_API_HOST, BACKEND_API_PORT);
+    telemetry_sender_init(BACKEND_API_HOST, BACKEND_API_PORT);
+    telemetry_sender_set_format(format);
+    telemetry_sender_enable_spool(dir);
+
+    start = monotonic_ns();
+    uint64_t deadline = start + 120ULL * 1000000000ULL;
+    do {
+        telemetry_sender_poll();
+        telemetry_sender_get_stats(&stats);
+    } while (stats.spool_pending > 0 && monotonic_ns() < deadline);
+    double drain_s = (monotonic_ns() - start) / 1e9;
+    telemetry_sender_cleanup();
+
+    double rate = drain_s > 0 ? stats.packets_replayed / drain_s : 0.0;
+    printf("  Replayed: %lu packets in %.2f s in %lu requests (%.0f packets/s, %.0fx real time)\n",
+           stats.packets_replayed, drain_s, stats.requests, rate, rate);
+    printf("  Pending:  %lu\n", stats.spool_pending);
+    printf("  Result:   %s\n", stats.spool_pending == 0 ? "PASS" : "FAIL (backend unreachable?)");
+}
+
+/* ============================================================================
+ * FLEET LOAD GENERATOR
+ * ============================================================================ */
+
+// Fleet load generator: many vehicles, many threads, one aggregate report
+void run_fleet_load(const FleetConfig* config) {
+    printf("\nMMIT BLACKBOX - Fleet Load Generator\n");
+    if (config->sink == FLEET_SINK_BACKEND) {
+        printf("Sink: http://%s:%d (%s, %u packets per request)\n", BACKEND_API_HOST,
+               BACKEND_API_PORT, config->format == TELEMETRY_FORMAT_BINARY ? "binary" : "JSON",
+               config->batch);
+    } else {
+        printf("Sink: local (encode only, %s)\n",
+               config->format == TELEMETRY_FORMAT_BINARY ? "binary" : "JSON");
+    }
+    printf("Vehicles: %u across %u threads | %u Hz | %u s simulated", config->vehicles,
+           config->threads, config->rate_hz, config->duration_s);
+    if (config->warp <= 0.0) printf(" | time warp: max\n");
+    else if (config->warp != 1.0) printf(" | time warp: %gx\n", config->warp);
+    else printf("\n");
+
+    FleetStats stats;
+    if (!fleet_run(config, &stats)) {
+        fprintf(stderr, "Fleet: Could not start (vehicles 1-%d, batch 1-%d)\n",
+                FLEET_MAX_VEHICLES, FLEET_MAX_BATCH);
+        return;
+    }
+    fleet_print_stats(config, &stats);
+}
+
+
 /* ============================================================================
  * UTILITY FUNCTIONS
  * ============================================================================ */
@@ -366,48 +796,207 @@ int main(int argc, char** argv) {
     bool run_all_tests = true;
     bool interactive_mode = false;
     bool streaming_mode = false;
-    int stream_count = 60; // Default: 60 updates (1 minute)
+    bool resume_log = false;
+    const BenchEntry* bench = NULL;
+    int bench_count = 0;
+    int spool_test_count = 0;
+    double stream_hours = 0.0;
+    FleetConfig fleet;
+    fleet_config_defaults(&fleet);
+    bool fleet_mode = false;
+    bool replay_mode = false;
+    double replay_speed = 1.0;
+    StreamOptions stream_opts;
+    stream_options_defaults(&stream_opts);
     
-    if (argc > 1) {
-        if (strcmp(argv[1], "-q") == 0 || strcmp(argv[1], "--quiet") == 0) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quiet") == 0) {
             verbose = false;
-        } else if (strcmp(argv[1], "-i") == 0 || strcmp(argv[1], "--interactive") == 0) {
+        } else if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--interactive") == 0) {
             interactive_mode = true;
             run_all_tests = false;
-        } else if (strcmp(argv[1], "-s") == 0 || strcmp(argv[1], "--stream") == 0) {
+        } else if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--stream") == 0) {
             streaming_mode = true;
             run_all_tests = false;
             interactive_mode = false;
             // Optional: number of updates
-            if (argc > 2) {
-                stream_count = atoi(argv[2]);
-                if (stream_count <= 0) stream_count = 60;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                stream_opts.num_updates = atoi(argv[++i]);
+                if (stream_opts.num_updates <= 0) stream_opts.num_updates = 60;
             }
-        } else if (strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0) {
+        } else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            int rate = atoi(argv[++i]);
+            if (rate < RATE_SCHEDULER_MIN_HZ || rate > RATE_SCHEDULER_MAX_HZ) {
+                fprintf(stderr, "--rate must be %d-%d Hz\n", RATE_SCHEDULER_MIN_HZ,
+                        RATE_SCHEDULER_MAX_HZ);
+                return 1;
+            }
+            stream_opts.rate_hz = (uint32_t)rate;
+        } else if (strcmp(argv[i], "--warp") == 0 && i + 1 < argc) {
+            i++;
+            stream_opts.warp = strcmp(argv[i], "max") == 0 ? 0.0 : atof(argv[i]);
+            if (stream_opts.warp < 0.0) stream_opts.warp = 1.0;
+        } else if (strcmp(argv[i], "--hours") == 0 && i + 1 < argc) {
+            stream_hours = atof(argv[++i]);
+            streaming_mode = true;
+            run_all_tests = false;
+            interactive_mode = false;
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            stream_opts.display = false;
+        } else if (strcmp(argv[i], "--no-network") == 0) {
+            stream_opts.network = false;
+        } else if (strcmp(argv[i], "-b") == 0 || strcmp(argv[i], "--batch") == 0) {
+            stream_opts.batch_packets = TELEMETRY_BATCH_MAX_PACKETS;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                stream_opts.batch_packets = (uint32_t)atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--batch-ms") == 0 && i + 1 < argc) {
+            stream_opts.batch_latency_ms = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sync") == 0) {
+            stream_opts.async_send = false;
+        } else if (strcmp(argv[i], "--queue") == 0 && i + 1 < argc) {
+            stream_opts.queue_capacity = (uint32_t)atoi(argv[++i]);
+            if (stream_opts.queue_capacity == 0) stream_opts.queue_capacity = TELEMETRY_QUEUE_CAPACITY;
+        } else if (strcmp(argv[i], "--drop") == 0 && i + 1 < argc) {
+            i++;
+            stream_opts.queue_policy = strcmp(argv[i], "newest") == 0 ? SPSC_DROP_NEWEST
+                                                                       : SPSC_DROP_OLDEST;
+        } else if (strcmp(argv[i], "--binary") == 0) {
+            stream_opts.format = TELEMETRY_FORMAT_BINARY;
+        } else if (strcmp(argv[i], "--no-deadband") == 0) {
+            telemetry_sender_set_deadband(false);
+        } else if (strcmp(argv[i], "--no-compress") == 0) {
+            http_transport_set_compression(false);
+        } else if (strcmp(argv[i], "--ws") == 0) {
+            stream_opts.transport = TELEMETRY_TRANSPORT_WEBSOCKET;
+        } else if (strcmp(argv[i], "--http") == 0) {
+            stream_opts.transport = TELEMETRY_TRANSPORT_HTTP;
+        } else if (strcmp(argv[i], "--replay") == 0) {
+            // Reads the existing log, so it must not be truncated at startup
+            replay_mode = true;
+            resume_log = true;
+            run_all_tests = false;
+            interactive_mode = false;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                i++;
+                replay_speed = strcmp(argv[i], "max") == 0 ? 0.0 : atof(argv[i]);
+                if (replay_speed < 0.0) replay_speed = 1.0;
+            }
+        } else if (strcmp(argv[i], "--fleet") == 0) {
+            fleet_mode = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                fleet.vehicles = (uint32_t)atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            fleet.threads = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+            fleet.duration_s = (uint32_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--local") == 0) {
+            fleet.sink = FLEET_SINK_LOCAL;
+        } else if (strcmp(argv[i], "--no-record") == 0) {
+            stream_opts.record = false;
+        } else if (strcmp(argv[i], "--no-spool") == 0) {
+            stream_opts.spool = false;
+        } else if (strcmp(argv[i], "--spool-test") == 0) {
+            spool_test_count = 36000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                spool_test_count = atoi(argv[++i]);
+            }
+        } else if (bench_find(argv[i]) != NULL) {
+            bench = bench_find(argv[i]);
+            bench_count = bench->default_count;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                bench_count = atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "--resume") == 0) {
+            resume_log = true;
+        } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
             printf("Usage: %s [options]\n", argv[0]);
             printf("Options:\n");
             printf("  -i, --interactive       Run interactive dashboard mode\n");
             printf("  -s, --stream [count]    Run live telemetry streaming mode\n");
             printf("                          (default count: 60 updates)\n");
+            printf("      --rate <hz>         Sample rate, %d-%d Hz (default 1)\n",
+                   RATE_SCHEDULER_MIN_HZ, RATE_SCHEDULER_MAX_HZ);
+            printf("      --warp <n>|max      Run n times faster than real time, or unpaced\n");
+            printf("      --hours <h>         Stream h simulated hours (sets the count)\n");
+            printf("      --headless          No live terminal display\n");
+            printf("      --no-network        Simulate without sending to the backend\n");
+            printf("      --no-record         Do not log streamed packets to NVMe\n");
+            printf("  -b, --batch [n]         Batch n packets per request (default %d)\n",
+                   TELEMETRY_BATCH_MAX_PACKETS);
+            printf("      --batch-ms <ms>     Flush a partial batch after ms (default %d)\n",
+                   TELEMETRY_BATCH_MAX_LATENCY_MS);
+            printf("      --sync              Send inline instead of on the sender thread\n");
+            printf("      --queue <n>         Sender queue capacity (default %d)\n",
+                   TELEMETRY_QUEUE_CAPACITY);
+            printf("      --drop oldest|newest  Queue overflow policy (default oldest)\n");
+            printf("      --binary            Send %s instead of JSON\n",
+                   TELEMETRY_WIRE_CONTENT_TYPE);
+            printf("      --no-deadband       Send every field of every packet\n");
+            printf("      --no-compress       Send request bodies without gzip\n");
+            bench_print_usage();
+            printf("      --no-spool          Drop (do not spool) packets the backend missed\n");
+            printf("      --spool-test [n]    Spool n packets offline, then time the replay\n");
+            printf("      --ws / --http       Stream over a WebSocket or HTTP POSTs\n");
+            printf("      --replay [n|max]    Re-send the telemetry in the NVMe log at n x\n");
+            printf("                          recorded speed (default 1)\n");
+            printf("      --fleet [n]         Simulate n vehicles at once (default %u)\n",
+                   fleet.vehicles);
+            printf("      --threads <n>       Fleet worker threads (default %u)\n", fleet.threads);
+            printf("      --duration <s>      Simulated seconds per fleet vehicle (default %u)\n",
+                   fleet.duration_s);
+            printf("      --local             Fleet encodes locally instead of sending\n");
+            printf("  -r, --resume            Keep the existing NVMe log and resume\n");
+            printf("                          cloud sync from the saved watermark\n");
             printf("  -q, --quiet             Run tests in quiet mode\n");
             printf("  -h, --help              Show this help message\n");
             printf("\nExamples:\n");
             printf("  %s                      Run full test suite\n", argv[0]);
             printf("  %s --stream             Stream 60 telemetry updates\n", argv[0]);
             printf("  %s --stream 120         Stream 120 telemetry updates\n", argv[0]);
+            printf("  %s --stream --batch 20  Stream, 20 packets per request\n", argv[0]);
+            printf("  %s -s 6000 --rate 100 -b  100 Hz for a minute, batched\n", argv[0]);
+            printf("  %s --hours 10 --warp max --headless --no-network\n", argv[0]);
+            printf("                          Whole 10-hour drive as fast as possible\n");
+            printf("  %s --fleet 5000 --threads 8 -b 10\n", argv[0]);
+            printf("                          5000 vehicles at 1 Hz, 10 packets per request\n");
             printf("  %s --interactive        Interactive sensor dashboard\n", argv[0]);
             return 0;
         }
     }
     
+    // --hours counts in samples once the rate is known
+    if (stream_hours > 0.0) {
+        stream_opts.num_updates = (int)(stream_hours * 3600.0 * stream_opts.rate_hz);
+        if (stream_opts.num_updates <= 0) stream_opts.num_updates = 1;
+    }
+    
+    // The fleet shares the streaming rate, warp, batch and format options
+    if (fleet_mode) {
+        fleet.rate_hz = stream_opts.rate_hz;
+        fleet.warp = stream_opts.warp;
+        fleet.format = stream_opts.format;
+        fleet.batch = stream_opts.batch_packets > 1 ? stream_opts.batch_packets : 1;
+        if (!stream_opts.network) fleet.sink = FLEET_SINK_LOCAL;
+    }
+    
     // Initialize the SoC
     BlackBoxSoC soc;
-    blackbox_soc_init(&soc, verbose, interactive_mode);
+    blackbox_soc_init(&soc, verbose, interactive_mode, resume_log);
     
-    // Choose mode: streaming, interactive, or test suite
-    if (streaming_mode) {
+    // Choose mode: benchmark, streaming, interactive, or test suite
+    if (replay_mode) {
+        run_log_replay(&soc, &stream_opts, replay_speed);
+    } else if (fleet_mode) {
+        run_fleet_load(&fleet);
+    } else if (bench && bench_count > 0) {
+        bench->run(&soc, bench_count, stream_opts.format);
+    } else if (spool_test_count > 0) {
+        run_spool_test(spool_test_count, stream_opts.format);
+    } else if (streaming_mode) {
         // Run live telemetry streaming mode
-        run_live_telemetry_streaming(&soc, stream_count);
+        run_live_telemetry_streaming(&soc, &stream_opts);
     } else if (interactive_mode) {
         run_interactive_mode(&soc);
     } else {
@@ -430,10 +1019,16 @@ int main(int argc, char** argv) {
             run_architecture_validation(&soc);
             
             // Test 5: Live telemetry streaming (30 updates = 30 seconds)
-            run_live_telemetry_streaming(&soc, 30);
+            StreamOptions suite_stream;
+            stream_options_defaults(&suite_stream);
+            suite_stream.num_updates = 30;
+            run_live_telemetry_streaming(&soc, &suite_stream);
             
             // Test 6: Cloud transfer validation
             run_cloud_transfer_test(&soc);
+            
+            // Test 7: Backlog redemption after a link outage
+            run_backlog_redemption_test(&soc);
         }
         
         // Print final statistics
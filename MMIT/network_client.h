@@ -8,6 +8,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "http_transport.h"
 
 // Initialize network client (call once at startup)
 bool network_client_init(void);
@@ -19,6 +20,14 @@ void network_client_cleanup(void);
 // Returns true on success, false on failure
 bool network_send_data(const uint8_t* data, uint32_t length);
 
+// Queue an upload without blocking; `data` must stay valid until on_complete
+// is called from network_client_poll()
+bool network_send_data_async(const uint8_t* data, uint32_t length,
+                             HttpCompletionFn on_complete, void* user);
+
+// Drive in-flight uploads; returns the number still outstanding
+uint32_t network_client_poll(int timeout_ms);
+
 // Send status update (JSON) to cloud server
 bool network_send_status(const char* json_status);
 
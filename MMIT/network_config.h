@@ -28,4 +28,40 @@
 #define MAX_RETRIES         3
 #define RETRY_DELAY_MS      1000
 
+// Telemetry transport: TELEMETRY_TRANSPORT_HTTP (POST per packet/batch) or
+// TELEMETRY_TRANSPORT_WEBSOCKET (long-lived /ws/telemetry/{id} connection).
+// Override at runtime with --ws / --http.
+#define TELEMETRY_DEFAULT_TRANSPORT     TELEMETRY_TRANSPORT_HTTP
+
+// Telemetry batching (--batch): flush on size or age, whichever comes first
+#define TELEMETRY_BATCH_MAX_PACKETS     50
+#define TELEMETRY_BATCH_MAX_LATENCY_MS  1000
+
+// Async sender queue (packets); on overflow drop the oldest queued sample
+// (SPSC_DROP_OLDEST) or reject the new one (SPSC_DROP_NEWEST)
+#define TELEMETRY_QUEUE_CAPACITY        256
+#define TELEMETRY_QUEUE_POLICY          SPSC_DROP_OLDEST
+
+// Offline telemetry spool: 1 MiB segments (~10k packets each), at most
+// 64 MiB on disk (~7 days at 1 Hz). Replay runs in batches of up to
+// REPLAY_BATCH packets, REPLAY_BURST batches per sender poll, and retries
+// an unreachable backend every RETRY_MS.
+#define TELEMETRY_SPOOL_SEGMENT_BYTES   (1024 * 1024)
+#define TELEMETRY_SPOOL_MAX_SEGMENTS    64
+#define TELEMETRY_SPOOL_REPLAY_BATCH    500
+#define TELEMETRY_SPOOL_REPLAY_BURST    4
+#define TELEMETRY_SPOOL_RETRY_MS        2000
+
+// Deadband / send-on-change (--no-deadband): unchanged fields are left out
+// of packets, and each field is resent at least every KEEPALIVE_MS. Per-field
+// thresholds are in telemetry_deadband.c.
+#define TELEMETRY_DEADBAND_DEFAULT      true
+#define TELEMETRY_DEADBAND_KEEPALIVE_MS 5000
+
+// Backlog redemption throttle (live telemetry keeps priority)
+#define REDEMPTION_RATE_BYTES_PER_SEC   (256 * 1024)
+#define REDEMPTION_BURST_BYTES          (64 * 1024)
+// Wall time before the live loop retries a link that stalled redemption
+#define REDEMPTION_RETRY_MS             10000
+
 #endif // NETWORK_CONFIG_H
@@ -5,6 +5,10 @@
 
 #include "nvme_controller.h"
 
+#ifdef __unix__
+#include <sys/mman.h>
+#endif
+
 /* ============================================================================
  * NVME CONTROLLER MODEL
  * ============================================================================ */
@@ -28,3 +32,166 @@ void nvme_write_data(BlackBoxSoC* soc) {
                soc->event_queue.current_time, nvme->write_buf_len, nvme->bytes_written);
     }
 }
+
+/* ============================================================================
+ * STORAGE LIFECYCLE & PERSISTENT INDEX
+ * ============================================================================ */
+
+// Reload index records, dropping any that point past the end of storage
+// (the index entry is written before its data block lands).
+static uint64_t nvme_load_index(BlackBoxSoC* soc, long storage_size) {
+    LogIndexRecord rec;
+    uint64_t valid_end = 0;
+    uint32_t loaded = 0;
+
+    fseek(soc->nvme.index_file, 0, SEEK_SET);
+    while (fread(&rec, sizeof(rec), 1, soc->nvme.index_file) == 1) {
+        uint64_t end = rec.file_offset + rec.compressed_size;
+        if (end > (uint64_t)storage_size || rec.file_offset < valid_end) break;
+
+        LogIndex* entry = (LogIndex*)malloc(sizeof(LogIndex));
+        entry->timestamp_start = rec.timestamp_start;
+        entry->timestamp_end = rec.timestamp_end;
+        entry->file_offset = rec.file_offset;
+        entry->compressed_size = rec.compressed_size;
+        entry->uncompressed_size = rec.uncompressed_size;
+        entry->next = soc->log_index;
+        soc->log_index = entry;
+
+        valid_end = end;
+        loaded++;
+    }
+
+    // Drop torn index records so new appends stay aligned
+#ifdef __unix__
+    if (ftruncate(fileno(soc->nvme.index_file), (off_t)(loaded * sizeof(rec))) != 0) {
+        perror("NVMe: index truncate");
+    }
+#endif
+    fseek(soc->nvme.index_file, (long)(loaded * sizeof(rec)), SEEK_SET);
+
+    if (soc->verbose) {
+        printf("NVMe: Resumed %u indexed blocks (%lu bytes)\n", loaded, valid_end);
+    }
+    return valid_end;
+}
+
+bool nvme_open_storage(BlackBoxSoC* soc, bool resume) {
+    NVMeController* nvme = &soc->nvme;
+
+    if (resume) {
+        nvme->storage_file = fopen(NVME_STORAGE_PATH, "r+b");
+        nvme->index_file = fopen(NVME_INDEX_PATH, "r+b");
+        if (!nvme->storage_file || !nvme->index_file) {
+            if (nvme->storage_file) fclose(nvme->storage_file);
+            if (nvme->index_file) fclose(nvme->index_file);
+            resume = false;
+        }
+    }
+    if (!resume) {
+        nvme->storage_file = fopen(NVME_STORAGE_PATH, "w+b");
+        nvme->index_file = fopen(NVME_INDEX_PATH, "w+b");
+    }
+    if (!nvme->storage_file || !nvme->index_file) return false;
+
+    if (resume) {
+        fseek(nvme->storage_file, 0, SEEK_END);
+        long size = ftell(nvme->storage_file);
+        nvme->bytes_written = nvme_load_index(soc, size);
+#ifdef __unix__
+        // Discard data past the last indexed block
+        if (ftruncate(fileno(nvme->storage_file), (off_t)nvme->bytes_written) != 0) {
+            perror("NVMe: storage truncate");
+        }
+#endif
+        fseek(nvme->storage_file, (long)nvme->bytes_written, SEEK_SET);
+    }
+    return true;
+}
+
+void nvme_close_storage(BlackBoxSoC* soc) {
+    if (soc->nvme.storage_file) {
+        fclose(soc->nvme.storage_file);
+        soc->nvme.storage_file = NULL;
+    }
+    if (soc->nvme.index_file) {
+        fclose(soc->nvme.index_file);
+        soc->nvme.index_file = NULL;
+    }
+}
+
+void nvme_persist_index_entry(BlackBoxSoC* soc, const LogIndex* entry) {
+    if (!soc->nvme.index_file) return;
+
+    LogIndexRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.timestamp_start = entry->timestamp_start;
+    rec.timestamp_end = entry->timestamp_end;
+    rec.file_offset = entry->file_offset;
+    rec.compressed_size = entry->compressed_size;
+    rec.uncompressed_size = entry->uncompressed_size;
+
+    fwrite(&rec, sizeof(rec), 1, soc->nvme.index_file);
+    fflush(soc->nvme.index_file);
+}
+
+/* ============================================================================
+ * ZERO-COPY REGION MAPPING
+ * ============================================================================ */
+
+bool nvme_map_region(BlackBoxSoC* soc, uint64_t offset, uint32_t length, NVMeRegion* region) {
+    memset(region, 0, sizeof(NVMeRegion));
+    if (!soc->nvme.storage_file || length == 0) return false;
+    if (offset + length > soc->nvme.bytes_written) return false;
+
+#ifdef __unix__
+    // mmap offsets must be page aligned; map from the enclosing page
+    long page_size = sysconf(_SC_PAGESIZE);
+    uint64_t aligned = offset & ~((uint64_t)page_size - 1);
+    size_t slack = (size_t)(offset - aligned);
+    size_t map_len = slack + length;
+
+    void* base = mmap(NULL, map_len, PROT_READ, MAP_SHARED,
+                      fileno(soc->nvme.storage_file), (off_t)aligned);
+    if (base == MAP_FAILED) return false;
+
+    region->base = base;
+    region->base_length = map_len;
+    region->data = (const uint8_t*)base + slack;
+    region->length = length;
+    region->mapped = true;
+    return true;
+#else
+    // No mmap: read into a private buffer (costs one copy)
+    uint8_t* buf = (uint8_t*)malloc(length);
+    if (!buf) return false;
+    long saved = ftell(soc->nvme.storage_file);
+    fseek(soc->nvme.storage_file, (long)offset, SEEK_SET);
+    size_t got = fread(buf, 1, length, soc->nvme.storage_file);
+    fseek(soc->nvme.storage_file, saved, SEEK_SET);
+    if (got != length) {
+        free(buf);
+        return false;
+    }
+    region->base = buf;
+    region->base_length = length;
+    region->data = buf;
+    region->length = length;
+    region->mapped = false;
+    return true;
+#endif
+}
+
+void nvme_unmap_region(NVMeRegion* region) {
+    if (!region->base) return;
+#ifdef __unix__
+    if (region->mapped) {
+        munmap(region->base, region->base_length);
+    } else {
+        free(region->base);
+    }
+#else
+    free(region->base);
+#endif
+    memset(region, 0, sizeof(NVMeRegion));
+}
@@ -9,10 +9,25 @@
 #include "blackbox_common.h"
 #include "memory.h"
 
+// Backing files for the simulated NVMe namespace
+#define NVME_STORAGE_PATH       "nvme_storage.bin"
+#define NVME_INDEX_PATH         "nvme_storage.idx"
+#define NVME_HISTORY_BASE       "nvme_storage"      // Rollup side files (history_rollup.h)
+
 /* ============================================================================
  * NVME CONTROLLER FUNCTIONS
  * ============================================================================ */
 
 void nvme_write_data(BlackBoxSoC* soc);
 
+// Open storage + index sidecar. With resume=true an existing log is kept and
+// its index reloaded into soc->log_index; otherwise both files are truncated.
+bool nvme_open_storage(BlackBoxSoC* soc, bool resume);
+void nvme_close_storage(BlackBoxSoC* soc);
+void nvme_persist_index_entry(BlackBoxSoC* soc, const LogIndex* entry);
+
+// Map [offset, offset + length) of the storage file. Returns false on error.
+bool nvme_map_region(BlackBoxSoC* soc, uint64_t offset, uint32_t length, NVMeRegion* region);
+void nvme_unmap_region(NVMeRegion* region);
+
 #endif // NVME_CONTROLLER_H
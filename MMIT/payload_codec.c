@@ -0,0 +1,32 @@
+/*
+ * BlackBox DPU - Payload Codec Implementation
+ */
+
+#include "payload_codec.h"
+#include <string.h>
+#include <zlib.h>
+
+int payload_codec_level(size_t raw_len) {
+    if (raw_len < PAYLOAD_COMPRESS_MIN_BYTES) return 0;
+    if (raw_len <= PAYLOAD_COMPRESS_SMALL_MAX) return PAYLOAD_LEVEL_SMALL;
+    if (raw_len <= PAYLOAD_COMPRESS_MEDIUM_MAX) return PAYLOAD_LEVEL_MEDIUM;
+    return PAYLOAD_LEVEL_LARGE;
+}
+
+size_t payload_codec_gzip(const void* in, size_t len, uint8_t* out, size_t cap, int level) {
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    // windowBits 15 + 16 selects the gzip wrapper; memLevel 8 is zlib's default
+    if (deflateInit2(&zs, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return 0;
+    }
+    zs.next_in = (Bytef*)in;
+    zs.avail_in = (uInt)len;
+    zs.next_out = out;
+    zs.avail_out = (uInt)cap;
+
+    int rc = deflate(&zs, Z_FINISH);
+    size_t written = zs.total_out;
+    deflateEnd(&zs);
+    return rc == Z_STREAM_END ? written : 0;
+}
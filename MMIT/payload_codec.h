@@ -0,0 +1,36 @@
+/*
+ * BlackBox DPU - Payload Codec
+ * gzip request-body compression (Content-Encoding: gzip) with the level
+ * picked from the payload size
+ */
+
+#ifndef PAYLOAD_CODEC_H
+#define PAYLOAD_CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PAYLOAD_CODEC_ENCODING      "gzip"
+
+// Below this a gzip header and trailer cost more than they save
+#define PAYLOAD_COMPRESS_MIN_BYTES  512
+// Small bodies compress in microseconds even at the best level; large ones
+// (log blocks, spool replays) step down to keep the upload path cheap
+#define PAYLOAD_COMPRESS_SMALL_MAX  (32 * 1024)
+#define PAYLOAD_COMPRESS_MEDIUM_MAX (256 * 1024)
+#define PAYLOAD_LEVEL_SMALL         9
+#define PAYLOAD_LEVEL_MEDIUM        6
+#define PAYLOAD_LEVEL_LARGE         1
+
+/* ============================================================================
+ * CODEC FUNCTIONS
+ * ============================================================================ */
+
+// zlib level for a body of raw_len bytes; 0 = send it uncompressed
+int payload_codec_level(size_t raw_len);
+
+// Compress into out as a gzip member. Returns the compressed size, or 0 if
+// it failed or would not fit in cap (pass cap = raw_len to require a gain).
+size_t payload_codec_gzip(const void* in, size_t len, uint8_t* out, size_t cap, int level);
+
+#endif // PAYLOAD_CODEC_H
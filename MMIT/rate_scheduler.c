@@ -0,0 +1,132 @@
+/*
+ * BlackBox DPU - Fixed-Rate Scheduler Implementation
+ */
+
+#include "rate_scheduler.h"
+#include "blackbox_common.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+void rate_scheduler_sleep_until(uint64_t deadline_ns) {
+#ifdef __unix__
+    struct timespec ts = {
+        .tv_sec = (time_t)(deadline_ns / 1000000000ULL),
+        .tv_nsec = (long)(deadline_ns % 1000000000ULL),
+    };
+    // Absolute deadline: an interrupted sleep resumes toward the same instant
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+#else
+    uint64_t now = monotonic_ns();
+    if (deadline_ns > now) {
+        uint64_t wait_ns = deadline_ns - now;
+        struct timespec ts = {(time_t)(wait_ns / 1000000000ULL), (long)(wait_ns % 1000000000ULL)};
+        nanosleep(&ts, NULL);
+    }
+#endif
+}
+
+static void record_jitter(RateScheduler* sched, uint64_t late_ns) {
+    sched->jitter_ns[sched->jitter_next] = late_ns > UINT32_MAX ? UINT32_MAX : (uint32_t)late_ns;
+    sched->jitter_next = (sched->jitter_next + 1) % RATE_JITTER_SAMPLES;
+    if (sched->jitter_count < RATE_JITTER_SAMPLES) sched->jitter_count++;
+}
+
+void rate_scheduler_init(RateScheduler* sched, uint32_t rate_hz) {
+    memset(sched, 0, sizeof(RateScheduler));
+    if (rate_hz < RATE_SCHEDULER_MIN_HZ) rate_hz = RATE_SCHEDULER_MIN_HZ;
+    if (rate_hz > RATE_SCHEDULER_MAX_HZ) rate_hz = RATE_SCHEDULER_MAX_HZ;
+    sched->rate_hz = rate_hz;
+    sched->sim_period_ns = 1000000000ULL / rate_hz;
+    sched->period_ns = sched->sim_period_ns;
+#ifdef __linux__
+    // The default 50 us timer slack is a large slice of a 1 ms period
+    // (applies to the calling thread)
+    prctl(PR_SET_TIMERSLACK, 1UL);
+#endif
+    sched->start_ns = monotonic_ns();
+    sched->next_ns = sched->start_ns;
+}
+
+void rate_scheduler_set_warp(RateScheduler* sched, double warp) {
+    sched->unpaced = warp <= 0.0;
+    if (!sched->unpaced) {
+        double period = (double)sched->sim_period_ns / warp;
+        sched->period_ns = period < 1.0 ? 1 : (uint64_t)period;
+    }
+    sched->start_ns = monotonic_ns();
+    sched->next_ns = sched->start_ns;
+}
+
+uint32_t rate_scheduler_wait(RateScheduler* sched) {
+    uint32_t periods = 1;
+    uint64_t now = monotonic_ns();
+
+    if (sched->unpaced) {
+        sched->next_ns = now;
+        if (sched->ticks++ == 0) sched->first_wake_ns = now;
+        sched->last_wake_ns = now;
+        return 1;
+    }
+
+    // Overran one or more whole periods: skip those deadlines
+    if (sched->ticks > 0 && now >= sched->next_ns + sched->period_ns) {
+        uint64_t behind = (now - sched->next_ns) / sched->period_ns;
+        sched->missed += behind;
+        sched->next_ns += behind * sched->period_ns;
+        periods += (uint32_t)behind;
+    }
+
+    rate_scheduler_sleep_until(sched->next_ns);
+    uint64_t woke = monotonic_ns();
+    record_jitter(sched, woke > sched->next_ns ? woke - sched->next_ns : 0);
+    if (sched->ticks == 0) sched->first_wake_ns = woke;
+    sched->last_wake_ns = woke;
+
+    sched->next_ns += sched->period_ns;
+    sched->ticks++;
+    return periods;
+}
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+void rate_scheduler_get_stats(const RateScheduler* sched, RateSchedulerStats* stats) {
+    memset(stats, 0, sizeof(RateSchedulerStats));
+    stats->rate_hz = sched->rate_hz;
+    stats->ticks = sched->ticks;
+    stats->missed = sched->missed;
+
+    // Simulated time covered (ticks plus skipped deadlines) over wall time
+    uint64_t wall_ns = monotonic_ns() - sched->start_ns;
+    if (wall_ns > 0) {
+        stats->warp = (double)(sched->ticks + sched->missed) * sched->sim_period_ns / wall_ns;
+    }
+
+    // Measured between actual wake-ups, not deadlines: the deadline grid
+    // reads the target rate whenever nothing was missed
+    if (sched->ticks > 1 && sched->last_wake_ns > sched->first_wake_ns) {
+        stats->achieved_hz = (double)(sched->ticks - 1) * 1e9 /
+                             (double)(sched->last_wake_ns - sched->first_wake_ns);
+    }
+
+    uint32_t count = sched->jitter_count;
+    if (count == 0) return;
+    uint32_t* sorted = (uint32_t*)malloc(count * sizeof(uint32_t));
+    if (!sorted) return;
+    memcpy(sorted, sched->jitter_ns, count * sizeof(uint32_t));
+    qsort(sorted, count, sizeof(uint32_t), compare_u32);
+    stats->jitter_p50_us = sorted[(uint32_t)(0.50 * (count - 1) + 0.5)] / 1000.0;
+    stats->jitter_p99_us = sorted[(uint32_t)(0.99 * (count - 1) + 0.5)] / 1000.0;
+    stats->jitter_max_us = sorted[count - 1] / 1000.0;
+    free(sorted);
+}
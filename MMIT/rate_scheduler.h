@@ -0,0 +1,70 @@
+/*
+ * BlackBox DPU - Fixed-Rate Scheduler
+ * Absolute-deadline periodic wakeups (1 Hz - 1 kHz) that do not drift with
+ * the work done each tick, with missed-deadline and jitter accounting
+ */
+
+#ifndef RATE_SCHEDULER_H
+#define RATE_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RATE_SCHEDULER_MIN_HZ       1
+#define RATE_SCHEDULER_MAX_HZ       1000
+// Wake-up lateness samples kept for percentile reporting
+#define RATE_JITTER_SAMPLES         4096
+
+typedef struct {
+    uint32_t rate_hz;
+    uint64_t sim_period_ns;      // Simulated time per tick (1 / rate_hz)
+    uint64_t period_ns;          // Wall time per tick: sim_period_ns / warp
+    bool unpaced;                // Warp "max": never sleep
+    uint64_t start_ns;
+    uint64_t next_ns;            // Absolute deadline of the next tick (CLOCK_MONOTONIC)
+    uint64_t first_wake_ns;      // When the first and the latest tick actually woke
+    uint64_t last_wake_ns;
+    uint64_t ticks;
+    uint64_t missed;             // Deadlines skipped because a tick overran them
+    uint32_t jitter_ns[RATE_JITTER_SAMPLES];
+    uint32_t jitter_count;
+    uint32_t jitter_next;
+} RateScheduler;
+
+typedef struct {
+    uint32_t rate_hz;
+    double warp;                 // Simulated / wall time over the run
+    uint64_t ticks;
+    uint64_t missed;
+    double achieved_hz;          // Ticks per second of wall time, first wake-up to last
+    double jitter_p50_us;        // Wake-up lateness past the deadline
+    double jitter_p99_us;
+    double jitter_max_us;
+} RateSchedulerStats;
+
+/* ============================================================================
+ * SCHEDULER FUNCTIONS
+ * ============================================================================ */
+
+// rate_hz is clamped to RATE_SCHEDULER_MIN_HZ..MAX_HZ. The first tick is due
+// immediately.
+void rate_scheduler_init(RateScheduler* sched, uint32_t rate_hz);
+
+// Sleep until the next deadline. Returns the periods since the previous tick:
+// 1 on schedule, more when deadlines were missed (they are skipped rather
+// than run back to back, and the grid stays anchored to the start time).
+uint32_t rate_scheduler_wait(RateScheduler* sched);
+
+// Time warp: run warp times faster than real time (sim_period_ns is
+// unchanged, so callers keep advancing simulated time by it). warp <= 0
+// removes pacing altogether: ticks run as fast as the caller loops.
+// Call right after init.
+void rate_scheduler_set_warp(RateScheduler* sched, double warp);
+
+void rate_scheduler_get_stats(const RateScheduler* sched, RateSchedulerStats* stats);
+
+// Sleep until an absolute CLOCK_MONOTONIC deadline (also for callers pacing
+// an irregular timeline); returns at once if it has passed
+void rate_scheduler_sleep_until(uint64_t deadline_ns);
+
+#endif // RATE_SCHEDULER_H
@@ -4,26 +4,28 @@
 #include <stdlib.h>
 #include <time.h>
 
-// Driving simulation state
-typedef struct {
-    double elapsed_hours;           // Total elapsed time in hours
-    double speed_kph;               // Current speed
-    double fuel_level_pct;          // Fuel level (starts at 100%)
-    double engine_temp_c;           // Engine temperature
-    double battery_voltage;         // Battery voltage
-    double throttle_pct;            // Throttle position
-    double brake_pct;               // Brake position
-    int gear;                       // Current gear
-    double rpm;                     // Engine RPM
-    double ambient_temp_c;          // Outside temperature
-    int driving_mode;               // 0=city, 1=highway, 2=idle
-} DriveState;
-
+// Default vehicle behind the single-vehicle API
 static DriveState state = {0};
 
+// Helper: splitmix64, spreads nearby seeds into unrelated streams
+static uint64_t mix_seed(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Helper: xorshift64* step of the vehicle's random stream
+static uint64_t next_random(DriveState* s) {
+    s->rng ^= s->rng >> 12;
+    s->rng ^= s->rng << 25;
+    s->rng ^= s->rng >> 27;
+    return s->rng * 0x2545F4914F6CDD1DULL;
+}
+
 // Helper: Random float between min and max
-static double random_range(double min, double max) {
-    return min + ((double)rand() / RAND_MAX) * (max - min);
+static double random_range(DriveState* s, double min, double max) {
+    return min + (double)(next_random(s) >> 11) * (1.0 / 9007199254740992.0) * (max - min);
 }
 
 // Helper: Smooth transition towards target
@@ -33,41 +35,49 @@ static double smooth_approach(double current, double target, double rate) {
     return current + (diff > 0 ? rate : -rate);
 }
 
-void init_realistic_drive_simulation(void) {
-    srand(time(NULL));
-    
+void drive_sim_init(DriveState* s, uint64_t seed) {
     // Initialize starting state
-    state.elapsed_hours = 0.0;
-    state.speed_kph = 0.0;
-    state.fuel_level_pct = 100.0;       // Full tank
-    state.engine_temp_c = 25.0;         // Ambient start
-    state.battery_voltage = 12.6;       // Fully charged
-    state.throttle_pct = 0.0;
-    state.brake_pct = 0.0;
-    state.gear = 0;                     // Neutral
-    state.rpm = 800;                    // Idle RPM
-    state.ambient_temp_c = 25.0;
-    state.driving_mode = 0;             // Start in city mode
+    s->elapsed_hours = 0.0;
+    s->speed_kph = 0.0;
+    s->fuel_level_pct = 100.0;          // Full tank
+    s->engine_temp_c = 25.0;            // Ambient start
+    s->battery_voltage = 12.6;          // Fully charged
+    s->throttle_pct = 0.0;
+    s->brake_pct = 0.0;
+    s->gear = 0;                        // Neutral
+    s->rpm = 800;                       // Idle RPM
+    s->ambient_temp_c = 25.0;
+    s->driving_mode = 0;                // Start in city mode
+    s->rng = mix_seed(seed);
+    if (s->rng == 0) s->rng = 1;
+}
+
+void init_realistic_drive_simulation(void) {
+    drive_sim_init(&state, (uint64_t)time(NULL));
 }
 
 void update_realistic_drive_simulation(MMITTelemetryPacket* telemetry, double delta_seconds) {
-    state.elapsed_hours += delta_seconds / 3600.0;
+    drive_sim_update(&state, telemetry, delta_seconds);
+}
+
+void drive_sim_update(DriveState* s, MMITTelemetryPacket* telemetry, double delta_seconds) {
+    s->elapsed_hours += delta_seconds / 3600.0;
     
     // Determine driving mode based on time (simulate realistic 10-hour drive)
-    double hour = fmod(state.elapsed_hours, 10.0);
+    double hour = fmod(s->elapsed_hours, 10.0);
     
     if (hour < 2.0) {
         // Hours 0-2: City driving (stop and go)
-        state.driving_mode = 0;
+        s->driving_mode = 0;
     } else if (hour < 7.0) {
         // Hours 2-7: Highway driving (steady speed)
-        state.driving_mode = 1;
+        s->driving_mode = 1;
     } else if (hour < 7.5) {
         // Hours 7-7.5: Rest stop (idle)
-        state.driving_mode = 2;
+        s->driving_mode = 2;
     } else {
         // Hours 7.5-10: City driving back
-        state.driving_mode = 0;
+        s->driving_mode = 0;
     }
     
     // Update based on driving mode
@@ -75,32 +85,32 @@ void update_realistic_drive_simulation(MMITTelemetryPacket* telemetry, double de
     double target_throttle = 0.0;
     double target_brake = 0.0;
     
-    switch (state.driving_mode) {
+    switch (s->driving_mode) {
         case 0: // City driving
             // Simulate stop-and-go traffic
-            if (rand() % 100 < 30) {
+            if (next_random(s) % 100 < 30) {
                 // 30% chance to be stopped/slowing
-                target_speed = random_range(0, 30);
+                target_speed = random_range(s, 0, 30);
                 target_throttle = 0;
-                target_brake = random_range(20, 60);
+                target_brake = random_range(s, 20, 60);
             } else {
                 // Accelerating or cruising
-                target_speed = random_range(30, 60);
-                target_throttle = random_range(20, 50);
+                target_speed = random_range(s, 30, 60);
+                target_throttle = random_range(s, 20, 50);
                 target_brake = 0;
             }
             break;
             
         case 1: // Highway driving
             // Steady cruise with occasional speed changes
-            target_speed = random_range(100, 120);
-            target_throttle = random_range(30, 45);
+            target_speed = random_range(s, 100, 120);
+            target_throttle = random_range(s, 30, 45);
             target_brake = 0;
             
             // Occasional slowdowns for traffic
-            if (rand() % 100 < 10) {
-                target_speed = random_range(70, 90);
-                target_throttle = random_range(10, 20);
+            if (next_random(s) % 100 < 10) {
+                target_speed = random_range(s, 70, 90);
+                target_throttle = random_range(s, 10, 20);
             }
             break;
             
@@ -112,58 +122,58 @@ void update_realistic_drive_simulation(MMITTelemetryPacket* telemetry, double de
     }
     
     // Smooth transitions
-    state.speed_kph = smooth_approach(state.speed_kph, target_speed, delta_seconds * 2.0);
-    state.throttle_pct = smooth_approach(state.throttle_pct, target_throttle, delta_seconds * 10.0);
-    state.brake_pct = smooth_approach(state.brake_pct, target_brake, delta_seconds * 15.0);
+    s->speed_kph = smooth_approach(s->speed_kph, target_speed, delta_seconds * 2.0);
+    s->throttle_pct = smooth_approach(s->throttle_pct, target_throttle, delta_seconds * 10.0);
+    s->brake_pct = smooth_approach(s->brake_pct, target_brake, delta_seconds * 15.0);
     
     // Calculate gear based on speed
-    if (state.speed_kph < 5) {
-        state.gear = 0;
-    } else if (state.speed_kph < 20) {
-        state.gear = 1;
-    } else if (state.speed_kph < 40) {
-        state.gear = 2;
-    } else if (state.speed_kph < 60) {
-        state.gear = 3;
-    } else if (state.speed_kph < 80) {
-        state.gear = 4;
-    } else if (state.speed_kph < 100) {
-        state.gear = 5;
+    if (s->speed_kph < 5) {
+        s->gear = 0;
+    } else if (s->speed_kph < 20) {
+        s->gear = 1;
+    } else if (s->speed_kph < 40) {
+        s->gear = 2;
+    } else if (s->speed_kph < 60) {
+        s->gear = 3;
+    } else if (s->speed_kph < 80) {
+        s->gear = 4;
+    } else if (s->speed_kph < 100) {
+        s->gear = 5;
     } else {
-        state.gear = 6;
+        s->gear = 6;
     }
     
     // Calculate RPM based on speed and gear
-    if (state.gear == 0) {
-        state.rpm = 800 + state.throttle_pct * 20; // Idle to 2800 RPM
+    if (s->gear == 0) {
+        s->rpm = 800 + s->throttle_pct * 20; // Idle to 2800 RPM
     } else {
-        state.rpm = 1000 + (state.speed_kph / state.gear) * 40;
-        state.rpm += state.throttle_pct * 10; // Throttle adds RPM
+        s->rpm = 1000 + (s->speed_kph / s->gear) * 40;
+        s->rpm += s->throttle_pct * 10; // Throttle adds RPM
     }
     
     // Clamp RPM
-    if (state.rpm < 600) state.rpm = 600;
-    if (state.rpm > 7000) state.rpm = 7000;
+    if (s->rpm < 600) s->rpm = 600;
+    if (s->rpm > 7000) s->rpm = 7000;
     
     // Engine temperature - increases with RPM and throttle
     double target_temp = 85.0; // Normal operating temp
-    if (state.rpm > 3000) {
-        target_temp = 85.0 + (state.rpm - 3000) * 0.01;
+    if (s->rpm > 3000) {
+        target_temp = 85.0 + (s->rpm - 3000) * 0.01;
     }
-    if (state.driving_mode == 2) {
+    if (s->driving_mode == 2) {
         target_temp = 75.0; // Cools down at idle
     }
-    state.engine_temp_c = smooth_approach(state.engine_temp_c, target_temp, delta_seconds * 0.5);
+    s->engine_temp_c = smooth_approach(s->engine_temp_c, target_temp, delta_seconds * 0.5);
     
     // Fuel consumption (realistic)
     // City: ~10L/100km, Highway: ~6L/100km, Idle: ~0.8L/hour
     double fuel_consumption_rate = 0.0;
-    if (state.driving_mode == 0) {
+    if (s->driving_mode == 0) {
         // City driving
-        fuel_consumption_rate = (state.speed_kph * 10.0 / 100.0) / 3600.0; // L/second
-    } else if (state.driving_mode == 1) {
+        fuel_consumption_rate = (s->speed_kph * 10.0 / 100.0) / 3600.0; // L/second
+    } else if (s->driving_mode == 1) {
         // Highway driving
-        fuel_consumption_rate = (state.speed_kph * 6.0 / 100.0) / 3600.0;
+        fuel_consumption_rate = (s->speed_kph * 6.0 / 100.0) / 3600.0;
     } else {
         // Idle
         fuel_consumption_rate = 0.8 / 3600.0;
@@ -172,46 +182,46 @@ void update_realistic_drive_simulation(MMITTelemetryPacket* telemetry, double de
     // Assume 50L tank capacity
     double tank_capacity_liters = 50.0;
     double fuel_used = fuel_consumption_rate * delta_seconds;
-    state.fuel_level_pct -= (fuel_used / tank_capacity_liters) * 100.0;
-    if (state.fuel_level_pct < 0) state.fuel_level_pct = 0;
+    s->fuel_level_pct -= (fuel_used / tank_capacity_liters) * 100.0;
+    if (s->fuel_level_pct < 0) s->fuel_level_pct = 0;
     
     // Battery voltage - slight fluctuations
-    double target_battery = 12.4 + (state.rpm / 7000.0) * 1.8; // 12.4V to 14.2V
-    if (state.driving_mode == 2) {
+    double target_battery = 12.4 + (s->rpm / 7000.0) * 1.8; // 12.4V to 14.2V
+    if (s->driving_mode == 2) {
         target_battery = 12.2; // Drains slowly at idle
     }
-    state.battery_voltage = smooth_approach(state.battery_voltage, target_battery, delta_seconds * 0.1);
+    s->battery_voltage = smooth_approach(s->battery_voltage, target_battery, delta_seconds * 0.1);
     
     // Ambient temperature - simulate day/night cycle
-    double time_of_day = fmod(state.elapsed_hours, 24.0);
-    state.ambient_temp_c = 20.0 + 10.0 * sin((time_of_day / 24.0) * 2 * M_PI - M_PI / 2);
+    double time_of_day = fmod(s->elapsed_hours, 24.0);
+    s->ambient_temp_c = 20.0 + 10.0 * sin((time_of_day / 24.0) * 2 * M_PI - M_PI / 2);
     
     // Fill telemetry structure (matching MMITTelemetryPacket fields)
-    telemetry->speed_kph = state.speed_kph;
-    telemetry->rpm = state.rpm;
-    telemetry->throttle_pct = state.throttle_pct;
-    telemetry->brake_pct = state.brake_pct;
-    telemetry->gear = state.gear;
-    telemetry->battery_voltage = state.battery_voltage;
-    telemetry->engine_temp_c = state.engine_temp_c;
-    telemetry->fuel_level_pct = state.fuel_level_pct;
-    telemetry->ambient_temp_c = state.ambient_temp_c;
+    telemetry->speed_kph = s->speed_kph;
+    telemetry->rpm = s->rpm;
+    telemetry->throttle_pct = s->throttle_pct;
+    telemetry->brake_pct = s->brake_pct;
+    telemetry->gear = s->gear;
+    telemetry->battery_voltage = s->battery_voltage;
+    telemetry->engine_temp_c = s->engine_temp_c;
+    telemetry->fuel_level_pct = s->fuel_level_pct;
+    telemetry->ambient_temp_c = s->ambient_temp_c;
     
     // GPS (simulate movement)
-    telemetry->gps_lat = 37.7749 + (state.elapsed_hours * 0.01);
-    telemetry->gps_lon = -122.4194 + (state.elapsed_hours * 0.01);
+    telemetry->gps_lat = 37.7749 + (s->elapsed_hours * 0.01);
+    telemetry->gps_lon = -122.4194 + (s->elapsed_hours * 0.01);
     
     // Environmental - humidity varies with temperature
-    telemetry->humidity_pct = 50.0 + (state.ambient_temp_c - 20.0) * 1.5 + random_range(-5, 5);
+    telemetry->humidity_pct = 50.0 + (s->ambient_temp_c - 20.0) * 1.5 + random_range(s, -5, 5);
     if (telemetry->humidity_pct < 20.0) telemetry->humidity_pct = 20.0;
     if (telemetry->humidity_pct > 90.0) telemetry->humidity_pct = 90.0;
     
     // Wheel speeds (matching field names: wheel_fl, wheel_fr, wheel_rl, wheel_rr)
-    double wheel_variation = random_range(-0.5, 0.5);
-    telemetry->wheel_fl = state.speed_kph + wheel_variation;
-    telemetry->wheel_fr = state.speed_kph + wheel_variation;
-    telemetry->wheel_rl = state.speed_kph + wheel_variation;
-    telemetry->wheel_rr = state.speed_kph + wheel_variation;
+    double wheel_variation = random_range(s, -0.5, 0.5);
+    telemetry->wheel_fl = s->speed_kph + wheel_variation;
+    telemetry->wheel_fr = s->speed_kph + wheel_variation;
+    telemetry->wheel_rl = s->speed_kph + wheel_variation;
+    telemetry->wheel_rr = s->speed_kph + wheel_variation;
     
     // System stats (set by caller, but initialize here)
     telemetry->cpu_usage_pct = 0.0;
@@ -223,9 +233,9 @@ void update_realistic_drive_simulation(MMITTelemetryPacket* telemetry, double de
     telemetry->traction_control = true;
     
     // Add some realistic noise
-    telemetry->speed_kph += random_range(-0.5, 0.5);
-    telemetry->engine_temp_c += random_range(-0.3, 0.3);
-    telemetry->battery_voltage += random_range(-0.05, 0.05);
+    telemetry->speed_kph += random_range(s, -0.5, 0.5);
+    telemetry->engine_temp_c += random_range(s, -0.3, 0.3);
+    telemetry->battery_voltage += random_range(s, -0.05, 0.05);
 }
 
 double get_simulation_elapsed_hours(void) {
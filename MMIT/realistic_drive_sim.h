@@ -3,6 +3,36 @@
 
 #include "blackbox_common.h"
 #include "telemetry_sender.h"
+#include <stdint.h>
+
+// Driving simulation state, one per vehicle
+typedef struct {
+    double elapsed_hours;           // Total elapsed time in hours
+    double speed_kph;               // Current speed
+    double fuel_level_pct;          // Fuel level (starts at 100%)
+    double engine_temp_c;           // Engine temperature
+    double battery_voltage;         // Battery voltage
+    double throttle_pct;            // Throttle position
+    double brake_pct;               // Brake position
+    int gear;                       // Current gear
+    double rpm;                     // Engine RPM
+    double ambient_temp_c;          // Outside temperature
+    int driving_mode;               // 0=city, 1=highway, 2=idle
+    uint64_t rng;                   // Private random stream (never 0)
+} DriveState;
+
+/**
+ * Start a vehicle's drive: full tank, cold engine, city traffic
+ * @param state Vehicle to initialize
+ * @param seed Random stream seed; equal seeds give identical drives
+ */
+void drive_sim_init(DriveState* state, uint64_t seed);
+
+/**
+ * Advance one vehicle and fill its telemetry. Touches nothing but state,
+ * so vehicles may be stepped from different threads.
+ */
+void drive_sim_update(DriveState* state, MMITTelemetryPacket* telemetry, double delta_seconds);
 
 /**
  * Initialize the realistic 10-hour driving simulation
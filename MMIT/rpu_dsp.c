@@ -0,0 +1,182 @@
+/*
+ * BlackBox DPU - RPU DSP Plugin Chain Implementation
+ *
+ * The FIR, normalize and dynamics loops run across the samples of a block
+ * with branch-free selects so the compiler vectorizes them. Filter state
+ * carries over between blocks, so a channel filters as one continuous
+ * stream however it is cut into blocks.
+ */
+
+#include "rpu_dsp.h"
+#include "sensor_health.h"
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+void rpu_dsp_config_defaults(RpuDspConfig* config) {
+    config->lowpass = RPU_DSP_LOWPASS_FIR;
+    config->cutoff = 0.0f;
+    config->decimation = 1;
+    config->offset = 0.0f;
+    config->scale = 1.0f;
+    config->threshold = SENSOR_HEALTH_MAX_VALUE;
+    config->ratio = 4.0f;
+}
+
+void rpu_dsp_configure(RpuDspChain* chain, const RpuDspConfig* config) {
+    memset(chain, 0, sizeof(RpuDspChain));
+    chain->config = *config;
+    RpuDspConfig* c = &chain->config;
+    if (c->decimation < 1) c->decimation = 1;
+    if (c->decimation > RPU_DSP_MAX_DECIMATION) c->decimation = RPU_DSP_MAX_DECIMATION;
+    if (c->ratio < 1.0f) c->ratio = 1.0f;
+
+    // Anti-alias for the decimated rate unless a cutoff was given
+    double fc = c->cutoff;
+    if (fc <= 0.0 || fc >= 0.5) fc = c->decimation > 1 ? 0.4 / c->decimation : 0.25;
+    c->cutoff = (float)fc;
+
+    // Hamming-windowed sinc, normalized to unit gain at DC
+    double sum = 0.0;
+    double taps[RPU_DSP_FIR_TAPS];
+    const double mid = (RPU_DSP_FIR_TAPS - 1) / 2.0;
+    for (int i = 0; i < RPU_DSP_FIR_TAPS; i++) {
+        double t = i - mid;
+        double sinc = t == 0.0 ? 2.0 * fc : sin(2.0 * M_PI * fc * t) / (M_PI * t);
+        double window = 0.54 - 0.46 * cos(2.0 * M_PI * i / (RPU_DSP_FIR_TAPS - 1));
+        taps[i] = sinc * window;
+        sum += taps[i];
+    }
+    for (int i = 0; i < RPU_DSP_FIR_TAPS; i++) chain->taps[i] = (float)(taps[i] / sum);
+
+    chain->iir_alpha = (float)(1.0 - exp(-2.0 * M_PI * fc));
+}
+
+static void rpu_dsp_fir(RpuDspChain* chain, float* values, uint32_t count) {
+    enum { HIST = RPU_DSP_FIR_TAPS - 1 };
+    float ext[HIST + RPU_DSP_CHUNK];
+
+    // Before the first block, pretend the signal was always at its first value
+    if (!chain->primed) {
+        for (int i = 0; i < HIST; i++) chain->history[i] = values[0];
+    }
+    memcpy(ext, chain->history, sizeof(chain->history));
+
+    for (uint32_t done = 0; done < count; done += RPU_DSP_CHUNK) {
+        uint32_t n = count - done < RPU_DSP_CHUNK ? count - done : RPU_DSP_CHUNK;
+        float* x = values + done;
+        memcpy(ext + HIST, x, n * sizeof(float));
+
+        // y[i] = sum_j taps[j] * x[i - j], one tap at a time across the chunk
+        for (uint32_t i = 0; i < n; i++) x[i] = 0.0f;
+        for (int j = 0; j < RPU_DSP_FIR_TAPS; j++) {
+            const float t = chain->taps[j];
+            const float* src = ext + HIST - j;
+            for (uint32_t i = 0; i < n; i++) x[i] += t * src[i];
+        }
+        memmove(ext, ext + n, HIST * sizeof(float));
+    }
+    memcpy(chain->history, ext, sizeof(chain->history));
+}
+
+// Low-pass and keep every decimation-th sample in one pass: only the kept
+// outputs are computed, each as a dot product over the last taps inputs
+static uint32_t rpu_dsp_fir_decimate(RpuDspChain* chain, uint64_t* timestamps, float* values,
+                                     uint32_t count) {
+    enum { HIST = RPU_DSP_FIR_TAPS - 1 };
+    float ext[HIST + RPU_DSP_CHUNK];
+    float rev[RPU_DSP_FIR_TAPS];
+    for (int k = 0; k < RPU_DSP_FIR_TAPS; k++) rev[k] = chain->taps[HIST - k];
+
+    if (!chain->primed) {
+        for (int i = 0; i < HIST; i++) chain->history[i] = values[0];
+    }
+    memcpy(ext, chain->history, sizeof(chain->history));
+
+    const uint32_t step = chain->config.decimation;
+    uint32_t next = chain->decimation_phase;
+    uint32_t kept = 0;
+    for (uint32_t done = 0; done < count; done += RPU_DSP_CHUNK) {
+        uint32_t n = count - done < RPU_DSP_CHUNK ? count - done : RPU_DSP_CHUNK;
+        memcpy(ext + HIST, values + done, n * sizeof(float));
+
+        // Outputs land at or before the chunk just copied out
+        for (; next < n; next += step) {
+            const float* src = ext + next;
+            float acc = 0.0f;
+            for (int k = 0; k < RPU_DSP_FIR_TAPS; k++) acc += rev[k] * src[k];
+            if (timestamps) timestamps[kept] = timestamps[done + next];
+            values[kept++] = acc;
+        }
+        next -= n;
+        memmove(ext, ext + n, HIST * sizeof(float));
+    }
+    memcpy(chain->history, ext, sizeof(chain->history));
+    chain->decimation_phase = next;
+    return kept;
+}
+
+static void rpu_dsp_iir(RpuDspChain* chain, float* values, uint32_t count) {
+    if (!chain->primed) chain->iir_state = values[0];
+    float y = chain->iir_state;
+    const float a = chain->iir_alpha;
+    for (uint32_t i = 0; i < count; i++) {
+        y += a * (values[i] - y);
+        values[i] = y;
+    }
+    chain->iir_state = y;
+}
+
+// Keep every decimation-th sample, continuing the previous block's phase
+static uint32_t rpu_dsp_decimate(RpuDspChain* chain, uint64_t* timestamps, float* values,
+                                 uint32_t count) {
+    const uint32_t step = chain->config.decimation;
+    uint32_t kept = 0;
+    uint32_t i = chain->decimation_phase;
+    for (; i < count; i += step) {
+        if (timestamps) timestamps[kept] = timestamps[i];
+        values[kept++] = values[i];
+    }
+    chain->decimation_phase = i - count;
+    return kept;
+}
+
+static void rpu_dsp_normalize(const RpuDspChain* chain, float* values, uint32_t count) {
+    const float offset = chain->config.offset;
+    const float scale = chain->config.scale;
+    for (uint32_t i = 0; i < count; i++) values[i] = (values[i] - offset) * scale;
+}
+
+static void rpu_dsp_compress(const RpuDspChain* chain, float* values, uint32_t count) {
+    const float threshold = chain->config.threshold;
+    const float slope = 1.0f / chain->config.ratio;
+    for (uint32_t i = 0; i < count; i++) {
+        float x = values[i];
+        float mag = fabsf(x);
+        mag = mag > threshold ? threshold + (mag - threshold) * slope : mag;
+        values[i] = x < 0.0f ? -mag : mag;
+    }
+}
+
+uint32_t rpu_dsp_process(RpuDspChain* chain, const RPUCore* rpu, uint64_t* timestamps,
+                         float* values, uint32_t count) {
+    if (count == 0) return 0;
+
+    if (rpu->filter_enabled) {
+        bool decimate = chain->config.decimation > 1;
+        if (chain->config.lowpass == RPU_DSP_LOWPASS_IIR) {
+            rpu_dsp_iir(chain, values, count);
+            if (decimate) count = rpu_dsp_decimate(chain, timestamps, values, count);
+        } else if (decimate) {
+            count = rpu_dsp_fir_decimate(chain, timestamps, values, count);
+        } else {
+            rpu_dsp_fir(chain, values, count);
+        }
+        chain->primed = true;
+    }
+    if (rpu->normalize_enabled) rpu_dsp_normalize(chain, values, count);
+    if (rpu->compress_dynamics) rpu_dsp_compress(chain, values, count);
+    return count;
+}
@@ -0,0 +1,67 @@
+/*
+ * BlackBox DPU - RPU DSP Plugin Chain
+ * Per-channel signal conditioning run on sample blocks ahead of logging:
+ * low-pass filter, decimation, normalization and dynamic range compression.
+ * Each stage is switched by the matching RPUCore flag.
+ */
+
+#ifndef RPU_DSP_H
+#define RPU_DSP_H
+
+#include "blackbox_common.h"
+
+#define RPU_DSP_FIR_TAPS        16
+#define RPU_DSP_CHUNK           256     // Samples filtered per pass (stack buffer)
+#define RPU_DSP_MAX_DECIMATION  1000
+
+typedef enum {
+    RPU_DSP_LOWPASS_FIR,         // Windowed-sinc FIR, linear phase, vectorized
+    RPU_DSP_LOWPASS_IIR          // One-pole IIR, cheapest, sample by sample
+} RpuDspLowpass;
+
+typedef struct {
+    // Filter stage (filter_enabled)
+    RpuDspLowpass lowpass;
+    float cutoff;                // Fraction of the sample rate, 0 = from decimation
+    uint32_t decimation;         // Keep 1 sample in N after the low-pass
+
+    // Normalize stage (normalize_enabled): y = (x - offset) * scale
+    float offset;
+    float scale;
+
+    // Dynamics stage (compress_dynamics): above threshold, |y| grows
+    // 1/ratio as fast (hard knee, no attack/release)
+    float threshold;
+    float ratio;
+} RpuDspConfig;
+
+struct RpuDspChain {
+    RpuDspConfig config;
+    float taps[RPU_DSP_FIR_TAPS];
+    float history[RPU_DSP_FIR_TAPS - 1];    // Last inputs of the previous block
+    float iir_alpha;
+    float iir_state;
+    uint32_t decimation_phase;   // Samples to skip before the next kept one
+    bool primed;                 // history / iir_state hold real samples
+};
+
+typedef struct RpuDspChain RpuDspChain;
+
+/* ============================================================================
+ * RPU DSP FUNCTIONS
+ * ============================================================================ */
+
+// Pass-through settings: FIR at 0.25 of the sample rate, no decimation,
+// unit gain, compression above the health bounds at 4:1
+void rpu_dsp_config_defaults(RpuDspConfig* config);
+
+// Load a configuration and reset the filter state
+void rpu_dsp_configure(RpuDspChain* chain, const RpuDspConfig* config);
+
+// Run the enabled stages over one block in place and return how many
+// samples remain (fewer after decimation). timestamps follow the kept
+// samples; they may be NULL when the caller only needs values.
+uint32_t rpu_dsp_process(RpuDspChain* chain, const RPUCore* rpu, uint64_t* timestamps,
+                         float* values, uint32_t count);
+
+#endif // RPU_DSP_H
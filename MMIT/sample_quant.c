@@ -0,0 +1,342 @@
+/*
+ * BlackBox DPU - Adaptive Precision Encoder Implementation
+ *
+ * The range and noise scans keep one running result per lane, and codes are
+ * quantized and split into byte planes a chunk at a time, so the compiler
+ * vectorizes every pass over the samples. Planes also keep the slowly
+ * changing high bytes together, where the log compressor finds long runs.
+ */
+
+#include "sample_quant.h"
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+static const uint8_t supported_bits[] = {8, 12, 16, 24, 32};
+
+typedef struct {
+    float lo;
+    float hi;
+    float diff2;                 // Sum of squared second differences
+    bool finite;
+} BlockScan;
+
+uint8_t sample_quant_round_bits(uint8_t bit_depth) {
+    for (size_t i = 0; i < sizeof(supported_bits); i++) {
+        if (bit_depth <= supported_bits[i]) return supported_bits[i];
+    }
+    return 32;
+}
+
+size_t sample_quant_block_size(uint8_t bits, uint32_t count, bool uniform) {
+    size_t size = SAMPLE_QUANT_HEADER_SIZE + (size_t)(bits / 8) * count;
+    if (bits % 8) size += ((size_t)count + 1) / 2;
+    if (!uniform) size += (size_t)count * sizeof(uint64_t);
+    return size;
+}
+
+// Range, finiteness and second-difference energy of a block. Second
+// differences cancel a slow signal: for white noise of deviation s,
+// x[i] - 2x[i+1] + x[i+2] has variance 6s^2.
+static void scan_block(const float* x, uint32_t n, BlockScan* scan) {
+    enum { L = SAMPLE_QUANT_LANES };
+    float lo[L], hi[L], bad[L], d2[L];
+    for (uint32_t j = 0; j < L; j++) {
+        lo[j] = x[0];
+        hi[j] = x[0];
+        bad[j] = 0.0f;
+        d2[j] = 0.0f;
+    }
+
+    // Lane j of pass i sees x[i + j + 2] and the second difference ending there
+    uint32_t m = n > 2 ? n - 2 : 0;
+    uint32_t full = m / L * L;
+    for (uint32_t i = 0; i < full; i += L) {
+        for (uint32_t j = 0; j < L; j++) {
+            float v = x[i + j + 2];
+            float d = x[i + j] - 2.0f * x[i + j + 1] + v;
+            lo[j] = v < lo[j] ? v : lo[j];
+            hi[j] = v > hi[j] ? v : hi[j];
+            bad[j] += v - v;     // NaN from the first NaN or infinity on
+            d2[j] += d * d;
+        }
+    }
+    for (uint32_t i = full; i < m; i++) {
+        float v = x[i + 2];
+        float d = x[i] - 2.0f * x[i + 1] + v;
+        lo[0] = v < lo[0] ? v : lo[0];
+        hi[0] = v > hi[0] ? v : hi[0];
+        bad[0] += v - v;
+        d2[0] += d * d;
+    }
+
+    scan->lo = x[0];
+    scan->hi = x[0];
+    scan->diff2 = 0.0f;
+    float sum_bad = x[0] - x[0];
+    if (n > 1) {
+        scan->lo = x[1] < scan->lo ? x[1] : scan->lo;
+        scan->hi = x[1] > scan->hi ? x[1] : scan->hi;
+        sum_bad += x[1] - x[1];
+    }
+    for (uint32_t j = 0; j < L; j++) {
+        scan->lo = lo[j] < scan->lo ? lo[j] : scan->lo;
+        scan->hi = hi[j] > scan->hi ? hi[j] : scan->hi;
+        scan->diff2 += d2[j];
+        sum_bad += bad[j];
+    }
+    scan->finite = sum_bad == 0.0f;
+}
+
+// Reconstruction grid unit: multiples of it up to twice the block's
+// largest magnitude are exact floats, so offset + code * step decodes
+// exactly (within half a step of the value) when both sit on it
+static double grid_unit(const BlockScan* scan) {
+    float m = fabsf(scan->lo) > fabsf(scan->hi) ? fabsf(scan->lo) : fabsf(scan->hi);
+    int e;
+    frexpf(m, &e);
+    if (e < FLT_MIN_EXP) e = FLT_MIN_EXP;
+    return ldexp(1.0, e + 1 - FLT_MANT_DIG);
+}
+
+// Offset and step spanning the block in bits, both on the grid unit, the
+// step rounded up so the top code still reaches the block's maximum
+static void quant_grid(const BlockScan* scan, uint8_t bits, float* offset, float* step) {
+    double unit = grid_unit(scan);
+    double lo = floor((double)scan->lo / unit) * unit;
+    double span = (double)scan->hi - lo;
+    double top = (double)((1u << bits) - 1);
+    double units = ceil(span / top / unit);
+    if (units < 1.0) units = 1.0;
+    if (units * unit * top < span) units += 1.0;
+    *offset = (float)lo;
+    *step = (float)(units * unit);
+}
+
+// Fewest bits with the same step as bits: once the step is down to the
+// grid unit, more bits only add codes a float cannot tell apart
+static uint8_t useful_bits(const BlockScan* scan, uint8_t bits) {
+    float offset, step, finest;
+    quant_grid(scan, bits, &offset, &finest);
+    for (size_t i = 0; supported_bits[i] < bits; i++) {
+        quant_grid(scan, supported_bits[i], &offset, &step);
+        if (step == finest) return supported_bits[i];
+    }
+    return bits;
+}
+
+// Fewest bits whose step stays under SAMPLE_QUANT_NOISE_FRACTION of the
+// noise floor across the block's range, capped at the useful bits of the
+// ceiling. A noiseless block (too short to tell, or perfectly smooth) keeps
+// that cap.
+static uint8_t adaptive_bits(const BlockScan* scan, uint32_t n, uint8_t max_bits) {
+    float range = scan->hi - scan->lo;
+    if (range <= 0.0f) return supported_bits[0];
+    if (max_bits < 32) max_bits = useful_bits(scan, max_bits);
+    if (n < 3) return max_bits;
+
+    float noise = sqrtf(scan->diff2 / (6.0f * (float)(n - 2)));
+    float step = noise * SAMPLE_QUANT_NOISE_FRACTION;
+    if (!(step > 0.0f) || !isfinite(step)) return max_bits;
+
+    double levels = (double)range / step;
+    for (size_t i = 0; supported_bits[i] < max_bits; i++) {
+        if (levels <= (double)((1u << supported_bits[i]) - 1)) return supported_bits[i];
+    }
+    return max_bits;
+}
+
+// Write the block for a chosen depth, offset and step (unused at 32 bits)
+static uint32_t encode_block(uint32_t channel_id, uint8_t bits, float offset, float step,
+                             const uint64_t* timestamps, const float* values, uint32_t count,
+                             uint8_t* out, uint32_t cap) {
+    // Evenly spaced timestamps (the usual case) collapse to first + period
+    uint64_t period = count > 1 ? timestamps[1] - timestamps[0] : 0;
+    uint64_t drift = 0, expect = timestamps[0];
+    for (uint32_t i = 0; i < count; i++) {
+        drift |= timestamps[i] ^ expect;
+        expect += period;
+    }
+    bool uniform = drift == 0;
+
+    size_t size = sample_quant_block_size(bits, count, uniform);
+    if (size > cap) return 0;
+
+    // Codes in double, where the grid makes the quotient exact
+    double inv_step = 0.0, top = 0.0;
+    if (bits < 32) {
+        inv_step = step > 0.0f ? 1.0 / step : 0.0;
+        top = (double)((1u << bits) - 1);
+    } else {
+        offset = step = 0.0f;
+    }
+    const double base_value = offset;
+
+    memset(out, 0, SAMPLE_QUANT_HEADER_SIZE);
+    out[0] = SAMPLE_QUANT_MAGIC0;
+    out[1] = SAMPLE_QUANT_MAGIC1;
+    out[2] = SAMPLE_QUANT_VERSION;
+    out[3] = bits;
+    memcpy(out + 4, &channel_id, sizeof(uint32_t));
+    memcpy(out + 8, &count, sizeof(uint32_t));
+    out[12] = uniform ? SAMPLE_QUANT_FLAG_UNIFORM : 0;
+    memcpy(out + 16, &timestamps[0], sizeof(uint64_t));
+    memcpy(out + 24, &period, sizeof(uint64_t));
+    memcpy(out + 32, &offset, sizeof(float));
+    memcpy(out + 36, &step, sizeof(float));
+
+    uint8_t* p = out + SAMPLE_QUANT_HEADER_SIZE;
+    if (!uniform) {
+        memcpy(p, timestamps, (size_t)count * sizeof(uint64_t));
+        p += (size_t)count * sizeof(uint64_t);
+    }
+
+    const uint32_t planes = bits / 8;
+    uint8_t* nibbles = p + (size_t)planes * count;
+    uint32_t codes[SAMPLE_QUANT_CHUNK];
+    for (uint32_t base = 0; base < count; base += SAMPLE_QUANT_CHUNK) {
+        uint32_t n = count - base < SAMPLE_QUANT_CHUNK ? count - base : SAMPLE_QUANT_CHUNK;
+        const float* x = values + base;
+
+        if (bits == 32) {
+            memcpy(codes, x, n * sizeof(float));
+        } else {
+            for (uint32_t i = 0; i < n; i++) {
+                double q = ((double)x[i] - base_value) * inv_step + 0.5;
+                q = q >= 0.0 ? q : 0.0;
+                q = q < top ? q : top;
+                codes[i] = (uint32_t)q;
+            }
+        }
+
+        for (uint32_t k = 0; k < planes; k++) {
+            uint8_t* plane = p + (size_t)k * count + base;
+            const uint32_t shift = 8 * k;
+            for (uint32_t i = 0; i < n; i++) plane[i] = (uint8_t)(codes[i] >> shift);
+        }
+
+        // The chunk is even, so only the last one can leave half a byte
+        if (bits % 8) {
+            if (n & 1) codes[n] = 0;
+            uint8_t* q = nibbles + base / 2;
+            const uint32_t shift = 8 * planes;
+            for (uint32_t i = 0; i < (n + 1) / 2; i++) {
+                q[i] = (uint8_t)(((codes[2 * i] >> shift) & 0x0F) |
+                                 (((codes[2 * i + 1] >> shift) & 0x0F) << 4));
+            }
+        }
+    }
+    return (uint32_t)size;
+}
+
+uint32_t sample_quant_encode(uint32_t channel_id, uint8_t bit_depth, bool adaptive,
+                             const uint64_t* timestamps, const float* values, uint32_t count,
+                             uint8_t* out, uint32_t cap) {
+    if (count == 0) return 0;
+
+    BlockScan scan;
+    scan_block(values, count, &scan);
+    float range = scan.hi - scan.lo;
+    uint8_t bits = sample_quant_round_bits(bit_depth);
+    if (!scan.finite || !isfinite(range)) {
+        bits = 32;
+    } else if (adaptive) {
+        bits = adaptive_bits(&scan, count, bits);
+    } else if (bits < 32) {
+        bits = useful_bits(&scan, bits);
+    }
+    float offset = 0.0f, step = 0.0f;
+    if (bits < 32) quant_grid(&scan, bits, &offset, &step);
+    return encode_block(channel_id, bits, offset, step, timestamps, values, count, out, cap);
+}
+
+uint32_t sample_quant_encode_step(uint32_t channel_id, float step, const uint64_t* timestamps,
+                                  const float* values, uint32_t count, uint8_t* out, uint32_t cap) {
+    if (count == 0) return 0;
+    if (!(step > 0.0f)) {
+        return sample_quant_encode(channel_id, 24, true, timestamps, values, count, out, cap);
+    }
+
+    BlockScan scan;
+    scan_block(values, count, &scan);
+    if (!scan.finite || !isfinite(scan.hi - scan.lo)) {
+        return encode_block(channel_id, 32, 0.0f, 0.0f, timestamps, values, count, out, cap);
+    }
+
+    // Offset on the step grid: a value gets the same code in every block
+    float offset = (float)(floor((double)scan.lo / step) * step);
+    double levels = ceil(((double)scan.hi - offset) / step);
+    for (size_t i = 0; supported_bits[i] < 32; i++) {
+        if (levels <= (double)((1u << supported_bits[i]) - 1)) {
+            return encode_block(channel_id, supported_bits[i], offset, step, timestamps, values,
+                                count, out, cap);
+        }
+    }
+    return sample_quant_encode(channel_id, 24, false, timestamps, values, count, out, cap);
+}
+
+uint32_t sample_quant_decode(const uint8_t* block, uint32_t len, uint64_t* timestamps,
+                             float* values, uint32_t max) {
+    if (len < SAMPLE_QUANT_HEADER_SIZE || block[0] != SAMPLE_QUANT_MAGIC0 ||
+        block[1] != SAMPLE_QUANT_MAGIC1 || block[2] != SAMPLE_QUANT_VERSION) {
+        return 0;
+    }
+    uint8_t bits = block[3];
+    if (sample_quant_round_bits(bits) != bits) return 0;
+
+    uint32_t count;
+    memcpy(&count, block + 8, sizeof(uint32_t));
+    bool uniform = (block[12] & SAMPLE_QUANT_FLAG_UNIFORM) != 0;
+    if (count == 0 || count > max) return 0;
+    if (sample_quant_block_size(bits, count, uniform) != len) return 0;
+
+    uint64_t first, period;
+    float offset, step;
+    memcpy(&first, block + 16, sizeof(uint64_t));
+    memcpy(&period, block + 24, sizeof(uint64_t));
+    memcpy(&offset, block + 32, sizeof(float));
+    memcpy(&step, block + 36, sizeof(float));
+
+    const uint8_t* p = block + SAMPLE_QUANT_HEADER_SIZE;
+    if (uniform) {
+        if (timestamps) {
+            for (uint32_t i = 0; i < count; i++) timestamps[i] = first + i * period;
+        }
+    } else {
+        if (timestamps) memcpy(timestamps, p, (size_t)count * sizeof(uint64_t));
+        p += (size_t)count * sizeof(uint64_t);
+    }
+
+    const uint32_t planes = bits / 8;
+    const uint8_t* nibbles = p + (size_t)planes * count;
+    uint32_t codes[SAMPLE_QUANT_CHUNK];
+    for (uint32_t base = 0; base < count; base += SAMPLE_QUANT_CHUNK) {
+        uint32_t n = count - base < SAMPLE_QUANT_CHUNK ? count - base : SAMPLE_QUANT_CHUNK;
+
+        memset(codes, 0, sizeof(codes));
+        for (uint32_t k = 0; k < planes; k++) {
+            const uint8_t* plane = p + (size_t)k * count + base;
+            const uint32_t shift = 8 * k;
+            for (uint32_t i = 0; i < n; i++) codes[i] |= (uint32_t)plane[i] << shift;
+        }
+        if (bits % 8) {
+            const uint8_t* q = nibbles + base / 2;
+            const uint32_t shift = 8 * planes;
+            for (uint32_t i = 0; i < (n + 1) / 2; i++) {
+                codes[2 * i] |= (uint32_t)(q[i] & 0x0F) << shift;
+                codes[2 * i + 1] |= (uint32_t)(q[i] >> 4) << shift;
+            }
+        }
+
+        // In double, so a step off the grid (sample_quant_encode_step) is
+        // rounded only once
+        float* y = values + base;
+        if (bits == 32) {
+            memcpy(y, codes, n * sizeof(float));
+        } else {
+            const double base_value = offset, scale = step;
+            for (uint32_t i = 0; i < n; i++) y[i] = (float)(base_value + (double)codes[i] * scale);
+        }
+    }
+    return count;
+}
@@ -0,0 +1,83 @@
+/*
+ * BlackBox DPU - Adaptive Precision Encoder
+ * Packs a channel's sample block to 8/12/16/24 bits per value against a
+ * per-block offset and step, ahead of logging. With adaptive precision the
+ * bit depth follows the block's range and noise floor, capped by the
+ * channel's bit_depth.
+ */
+
+#ifndef SAMPLE_QUANT_H
+#define SAMPLE_QUANT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define SAMPLE_QUANT_LANES          16
+#define SAMPLE_QUANT_CHUNK          256     // Codes packed per pass (stack buffer)
+
+// Adaptive mode: the step may be up to this fraction of the noise floor,
+// keeping the added quantization noise near 1% of the noise power
+#define SAMPLE_QUANT_NOISE_FRACTION 0.5f
+
+/*
+ * Logged block layout (host byte order, little-endian on every target):
+ *
+ *   0   u8[2]  magic "SQ"
+ *   2   u8     version
+ *   3   u8     bits per value: 8, 12, 16, 24, or 32 (raw f32 bit patterns)
+ *   4   u32    channel_id
+ *   8   u32    sample count (n)
+ *  12   u8     flags
+ *  13   u8[3]  reserved
+ *  16   u64    first timestamp (ns)
+ *  24   u64    sample period (ns), when SAMPLE_QUANT_FLAG_UNIFORM
+ *  32   f32    offset
+ *  36   f32    step: value = offset + code * step
+ *  40   u64[n] timestamps, only without SAMPLE_QUANT_FLAG_UNIFORM
+ *   …   codes as byte planes, least significant first: bits / 8 planes of
+ *       n bytes, then for 12 bits a plane of (n + 1) / 2 bytes holding the
+ *       top nibble of two codes each (even index in the low nibble)
+ */
+#define SAMPLE_QUANT_MAGIC0         'S'
+#define SAMPLE_QUANT_MAGIC1         'Q'
+#define SAMPLE_QUANT_VERSION        1
+#define SAMPLE_QUANT_HEADER_SIZE    40
+#define SAMPLE_QUANT_FLAG_UNIFORM   0x01
+// Values are the channel's deviation from its fusion group's composite
+// (sensor_fusion.h) at the same timestamps
+#define SAMPLE_QUANT_FLAG_DEVIATION 0x02
+
+/* ============================================================================
+ * ADAPTIVE PRECISION FUNCTIONS
+ * ============================================================================ */
+
+// Nearest supported depth at or above bit_depth (8, 12, 16, 24 or 32)
+uint8_t sample_quant_round_bits(uint8_t bit_depth);
+
+// Encoded size of count samples at a supported depth
+size_t sample_quant_block_size(uint8_t bits, uint32_t count, bool uniform);
+
+// Encode one block. bit_depth is the channel's depth, or its ceiling when
+// adaptive. Offset and step sit on a grid whose points are exact floats, so
+// every value decodes within half a step; depths finer than that grid drop
+// to the fewest bits giving the same step. Blocks holding non-finite values
+// are kept at 32 bits. Returns the block size, 0 if count is 0 or the block
+// does not fit in cap.
+uint32_t sample_quant_encode(uint32_t channel_id, uint8_t bit_depth, bool adaptive,
+                             const uint64_t* timestamps, const float* values, uint32_t count,
+                             uint8_t* out, uint32_t cap);
+
+// Encode one block at a fixed resolution: offset is a multiple of step, so
+// a value codes the same in every block and steady input packs into runs.
+// Uses the fewest bits that span the block; without a usable step (or if
+// 24 bits cannot span it) falls back to sample_quant_encode at 24 bits.
+uint32_t sample_quant_encode_step(uint32_t channel_id, float step, const uint64_t* timestamps,
+                                  const float* values, uint32_t count, uint8_t* out, uint32_t cap);
+
+// Decode a block into up to max samples (timestamps may be NULL). Returns
+// the sample count, 0 if the block is malformed or larger than max.
+uint32_t sample_quant_decode(const uint8_t* block, uint32_t len, uint64_t* timestamps,
+                             float* values, uint32_t max);
+
+#endif // SAMPLE_QUANT_H
@@ -0,0 +1,180 @@
+/*
+ * BlackBox DPU - Channel Sample Ring Implementation
+ *
+ * Both arrays share one cache-line aligned allocation. A bulk push or pop
+ * is at most two memcpy calls per array: up to the end of the ring, then
+ * from its start.
+ */
+
+#include "sample_ring.h"
+#include <stdlib.h>
+#include <string.h>
+
+static uint64_t round_up_pow2(uint64_t v) {
+    uint64_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+uint64_t sample_ring_capacity_for_rate(uint32_t sample_rate) {
+    uint64_t capacity = (uint64_t)sample_rate * SAMPLE_RING_SECONDS;
+    if (capacity < SAMPLE_RING_MIN_CAPACITY) capacity = SAMPLE_RING_MIN_CAPACITY;
+    return round_up_pow2(capacity);
+}
+
+SampleRing* sample_ring_create(uint64_t capacity) {
+    if (capacity == 0) return NULL;
+    capacity = round_up_pow2(capacity);
+
+    SampleRing* ring = (SampleRing*)aligned_alloc(SAMPLE_RING_CACHE_LINE, sizeof(SampleRing));
+    if (!ring) return NULL;
+    memset(ring, 0, sizeof(SampleRing));
+
+    // Timestamps first: capacity * 8 keeps the value array line aligned too
+    size_t bytes = capacity * SAMPLE_BLOCK_BYTES_PER_SAMPLE;
+    bytes = (bytes + SAMPLE_RING_CACHE_LINE - 1) & ~(size_t)(SAMPLE_RING_CACHE_LINE - 1);
+    uint8_t* block = (uint8_t*)aligned_alloc(SAMPLE_RING_CACHE_LINE, bytes);
+    if (!block) {
+        free(ring);
+        return NULL;
+    }
+    ring->block = block;
+    ring->timestamps = (uint64_t*)block;
+    ring->values = (float*)(block + capacity * sizeof(uint64_t));
+    ring->capacity = capacity;
+    ring->mask = capacity - 1;
+
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->dropped, 0);
+    return ring;
+}
+
+void sample_ring_destroy(SampleRing* ring) {
+    if (!ring) return;
+    free(ring->block);
+    free(ring);
+}
+
+uint32_t sample_ring_push(SampleRing* ring, const uint64_t* timestamps, const float* values,
+                          uint32_t count) {
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    uint64_t space = ring->capacity - (head - tail);
+    uint32_t n = count < space ? count : (uint32_t)space;
+    if (n < count) {
+        atomic_fetch_add_explicit(&ring->dropped, count - n, memory_order_relaxed);
+    }
+    if (n == 0) return 0;
+
+    uint64_t start = head & ring->mask;
+    uint64_t first = ring->capacity - start;
+    if (first > n) first = n;
+    memcpy(ring->timestamps + start, timestamps, first * sizeof(uint64_t));
+    memcpy(ring->values + start, values, first * sizeof(float));
+    memcpy(ring->timestamps, timestamps + first, (n - first) * sizeof(uint64_t));
+    memcpy(ring->values, values + first, (n - first) * sizeof(float));
+
+    atomic_store_explicit(&ring->head, head + n, memory_order_release);
+    return n;
+}
+
+// Copy n samples starting at position tail out of the ring
+static void copy_out(const SampleRing* ring, uint64_t tail, uint64_t* timestamps, float* values,
+                     uint32_t n) {
+    uint64_t start = tail & ring->mask;
+    uint64_t first = ring->capacity - start;
+    if (first > n) first = n;
+    memcpy(timestamps, ring->timestamps + start, first * sizeof(uint64_t));
+    memcpy(values, ring->values + start, first * sizeof(float));
+    memcpy(timestamps + first, ring->timestamps, (n - first) * sizeof(uint64_t));
+    memcpy(values + first, ring->values, (n - first) * sizeof(float));
+}
+
+uint32_t sample_ring_peek(const SampleRing* ring, uint64_t* timestamps, float* values, uint32_t max) {
+    SampleRing* r = (SampleRing*)ring;
+    uint64_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    uint64_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+
+    uint64_t pending = head - tail;
+    uint32_t n = max < pending ? max : (uint32_t)pending;
+    if (n > 0) copy_out(ring, tail, timestamps, values, n);
+    return n;
+}
+
+void sample_ring_consume(SampleRing* ring, uint32_t count) {
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if (count > head - tail) count = (uint32_t)(head - tail);
+    atomic_store_explicit(&ring->tail, tail + count, memory_order_release);
+}
+
+void sample_ring_discard(SampleRing* ring, uint32_t count) {
+    uint64_t depth = sample_ring_depth(ring);
+    if (count > depth) count = (uint32_t)depth;
+    atomic_fetch_add_explicit(&ring->dropped, count, memory_order_relaxed);
+    sample_ring_consume(ring, count);
+}
+
+uint32_t sample_ring_pop(SampleRing* ring, uint64_t* timestamps, float* values, uint32_t max) {
+    uint32_t n = sample_ring_peek(ring, timestamps, values, max);
+    sample_ring_consume(ring, n);
+    return n;
+}
+
+uint32_t sample_ring_peek_block(const SampleRing* ring, uint32_t channel_id, uint8_t* buf, uint32_t cap) {
+    if (cap < SAMPLE_BLOCK_HEADER_SIZE + SAMPLE_BLOCK_BYTES_PER_SAMPLE) return 0;
+    uint32_t max = (uint32_t)((cap - SAMPLE_BLOCK_HEADER_SIZE) / SAMPLE_BLOCK_BYTES_PER_SAMPLE);
+
+    // The timestamp array is sized to what is pending, so check first
+    uint64_t pending = sample_ring_depth(ring);
+    if (pending < max) max = (uint32_t)pending;
+    if (max == 0) return 0;
+
+    uint8_t* ts = buf + SAMPLE_BLOCK_HEADER_SIZE;
+    uint32_t n = sample_ring_peek(ring, (uint64_t*)ts, (float*)(ts + (size_t)max * sizeof(uint64_t)), max);
+
+    buf[0] = SAMPLE_BLOCK_MAGIC0;
+    buf[1] = SAMPLE_BLOCK_MAGIC1;
+    buf[2] = SAMPLE_BLOCK_VERSION;
+    buf[3] = 0;
+    memcpy(buf + 4, &channel_id, sizeof(uint32_t));
+    memcpy(buf + 8, &n, sizeof(uint32_t));
+    memset(buf + 12, 0, sizeof(uint32_t));
+    return SAMPLE_BLOCK_HEADER_SIZE + n * (uint32_t)SAMPLE_BLOCK_BYTES_PER_SAMPLE;
+}
+
+uint32_t sample_ring_peek_values(const SampleRing* ring, uint64_t from, float* out,
+                                 uint32_t stride, uint32_t max) {
+    SampleRing* r = (SampleRing*)ring;
+    uint64_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    uint64_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+
+    // Slots behind tail may already be refilled by the producer
+    if (from < tail) from = tail;
+    if (from >= head) return 0;
+    uint32_t n = head - from < max ? (uint32_t)(head - from) : max;
+
+    float* dst = out + (size_t)(max - n) * stride;
+    for (uint64_t pos = head - n; pos < head; pos++) {
+        *dst = ring->values[pos & ring->mask];
+        dst += stride;
+    }
+    return n;
+}
+
+uint64_t sample_ring_head(const SampleRing* ring) {
+    return atomic_load_explicit(&((SampleRing*)ring)->head, memory_order_acquire);
+}
+
+uint64_t sample_ring_depth(const SampleRing* ring) {
+    SampleRing* r = (SampleRing*)ring;
+    uint64_t tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    uint64_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    return head >= tail ? head - tail : 0;
+}
+
+uint64_t sample_ring_dropped(const SampleRing* ring) {
+    return atomic_load_explicit(&((SampleRing*)ring)->dropped, memory_order_relaxed);
+}
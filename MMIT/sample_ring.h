@@ -0,0 +1,106 @@
+/*
+ * BlackBox DPU - Channel Sample Ring
+ * Per-channel ring of raw samples in structure-of-arrays form: one
+ * timestamp array and one value array, filled in bulk by a single producer
+ * and drained in bulk by a single consumer, lock-free
+ */
+
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define SAMPLE_RING_CACHE_LINE      64
+
+// A ring holds this many seconds at the channel's sample rate...
+#define SAMPLE_RING_SECONDS         2
+// ...but never less than this many samples
+#define SAMPLE_RING_MIN_CAPACITY    1024
+
+/*
+ * Logged block layout (host byte order, little-endian on every target):
+ *
+ *   0   u8[2]  magic "SB"
+ *   2   u8     version
+ *   3   u8     reserved
+ *   4   u32    channel_id
+ *   8   u32    sample count (n)
+ *  12   u32    reserved
+ *  16   u64[n] timestamps (ns)
+ *   …   f32[n] values
+ */
+#define SAMPLE_BLOCK_MAGIC0         'S'
+#define SAMPLE_BLOCK_MAGIC1         'B'
+#define SAMPLE_BLOCK_VERSION        1
+#define SAMPLE_BLOCK_HEADER_SIZE    16
+#define SAMPLE_BLOCK_BYTES_PER_SAMPLE (sizeof(uint64_t) + sizeof(float))
+
+// head and tail are free-running counters; a full ring rejects the newest
+// samples, so only the consumer ever moves tail
+struct SampleRing {
+    // Producer-owned
+    _Alignas(SAMPLE_RING_CACHE_LINE) _Atomic uint64_t head;
+    _Atomic uint64_t dropped;
+
+    // Consumer-owned
+    _Alignas(SAMPLE_RING_CACHE_LINE) _Atomic uint64_t tail;
+
+    _Alignas(SAMPLE_RING_CACHE_LINE) uint64_t* timestamps;
+    float* values;
+    uint64_t capacity;           // Power of two
+    uint64_t mask;
+    void* block;
+};
+
+typedef struct SampleRing SampleRing;
+
+/* ============================================================================
+ * SAMPLE RING FUNCTIONS
+ * ============================================================================ */
+
+// Capacity for a channel sampled at sample_rate Hz
+uint64_t sample_ring_capacity_for_rate(uint32_t sample_rate);
+
+// capacity is rounded up to a power of two
+SampleRing* sample_ring_create(uint64_t capacity);
+void sample_ring_destroy(SampleRing* ring);
+
+// Producer side: append up to count samples. Returns how many fit; the
+// rest are counted as dropped.
+uint32_t sample_ring_push(SampleRing* ring, const uint64_t* timestamps, const float* values,
+                          uint32_t count);
+
+// Consumer side: move up to max pending samples out. Returns how many.
+uint32_t sample_ring_pop(SampleRing* ring, uint64_t* timestamps, float* values, uint32_t max);
+
+// Consumer side: copy up to max of the oldest pending samples out without
+// consuming them. Returns how many.
+uint32_t sample_ring_peek(const SampleRing* ring, uint64_t* timestamps, float* values, uint32_t max);
+
+// Consumer side: copy the oldest pending samples into a logged block (layout
+// above) of at most cap bytes, without consuming them. Returns the block
+// size, 0 if nothing is pending or cap cannot hold one sample.
+uint32_t sample_ring_peek_block(const SampleRing* ring, uint32_t channel_id, uint8_t* buf, uint32_t cap);
+
+// Consumer side: release the oldest count samples once they are logged
+void sample_ring_consume(SampleRing* ring, uint32_t count);
+
+// Consumer side: release the oldest count samples that will never be
+// logged, counting them as dropped
+void sample_ring_discard(SampleRing* ring, uint32_t count);
+
+// Consumer side: copy the newest values pushed at or after position from
+// (a sample_ring_head() reading), at most max, without consuming them.
+// They land right-aligned in out[0..max) with the given stride: the newest
+// at out[(max - 1) * stride]. Returns how many were copied.
+uint32_t sample_ring_peek_values(const SampleRing* ring, uint64_t from, float* out,
+                                 uint32_t stride, uint32_t max);
+
+// Samples ever accepted, i.e. the position the next push lands at
+uint64_t sample_ring_head(const SampleRing* ring);
+uint64_t sample_ring_depth(const SampleRing* ring);
+uint64_t sample_ring_dropped(const SampleRing* ring);
+
+#endif // SAMPLE_RING_H
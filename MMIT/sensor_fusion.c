@@ -0,0 +1,96 @@
+/*
+ * BlackBox DPU - Sensor Redundancy Fusion Implementation
+ *
+ * The vote runs across the samples of a pass, one member row at a time: an
+ * odd-even transposition network of min/max selects sorts the voting rows
+ * into the median, and the tolerance vote blends with 0/1 weights, so every
+ * inner loop vectorizes.
+ */
+
+#include "sensor_fusion.h"
+#include <float.h>
+
+uint64_t sensor_fusion_vote(SensorFusionMode mode, float tolerance, const float* values,
+                            uint32_t stride, const float* weights, uint32_t members,
+                            uint32_t count, float* composite) {
+    enum { N = SENSOR_FUSION_VOTE_CHUNK };
+    uint32_t voters[SENSOR_FUSION_MAX_MEMBERS];
+    uint32_t k = 0;
+    if (members > SENSOR_FUSION_MAX_MEMBERS) members = SENSOR_FUSION_MAX_MEMBERS;
+    for (uint32_t m = 0; m < members; m++) {
+        if (weights[m] > 0.0f) voters[k++] = m;
+    }
+    if (k == 0) return 0;
+
+    const float limit = tolerance > 0.0f ? tolerance : FLT_MAX;
+    float sorted[SENSOR_FUSION_MAX_MEMBERS][N];
+    float num[N], den[N], outvoted[N];
+    uint64_t rejected = 0;
+
+    for (uint32_t base = 0; base < count; base += N) {
+        uint32_t n = count - base < N ? count - base : N;
+
+        for (uint32_t r = 0; r < k; r++) {
+            memcpy(sorted[r], values + (size_t)voters[r] * stride + base, n * sizeof(float));
+        }
+        for (uint32_t pass = 0; pass < k; pass++) {
+            for (uint32_t r = pass & 1; r + 1 < k; r += 2) {
+                float* a = sorted[r];
+                float* b = sorted[r + 1];
+                for (uint32_t i = 0; i < n; i++) {
+                    float lo = a[i] < b[i] ? a[i] : b[i];
+                    float hi = a[i] < b[i] ? b[i] : a[i];
+                    a[i] = lo;
+                    b[i] = hi;
+                }
+            }
+        }
+
+        float* med = composite + base;
+        if (k & 1) {
+            memcpy(med, sorted[k / 2], n * sizeof(float));
+        } else {
+            const float* a = sorted[k / 2 - 1];
+            const float* b = sorted[k / 2];
+            for (uint32_t i = 0; i < n; i++) med[i] = 0.5f * (a[i] + b[i]);
+        }
+
+        // Members outside tolerance of the median lose their vote
+        memset(num, 0, n * sizeof(float));
+        memset(den, 0, n * sizeof(float));
+        memset(outvoted, 0, n * sizeof(float));
+        for (uint32_t r = 0; r < k; r++) {
+            const float* x = values + (size_t)voters[r] * stride + base;
+            const float w = weights[voters[r]];
+            for (uint32_t i = 0; i < n; i++) {
+                float dist = x[i] - med[i];
+                dist = dist >= 0.0f ? dist : -dist;
+                float in = dist <= limit ? 1.0f : 0.0f;
+                num[i] += w * in * x[i];
+                den[i] += w * in;
+                outvoted[i] += 1.0f - in;
+            }
+        }
+        if (mode == SENSOR_FUSION_WEIGHTED) {
+            for (uint32_t i = 0; i < n; i++) {
+                float safe = den[i] > 0.0f ? den[i] : 1.0f;
+                float mean = num[i] / safe;
+                composite[base + i] = den[i] > 0.0f ? mean : med[i];
+            }
+        }
+
+        float total = 0.0f;
+        for (uint32_t i = 0; i < n; i++) total += outvoted[i];
+        rejected += (uint64_t)total;
+    }
+    return rejected;
+}
+
+void sensor_fusion_deviations(const float* values, uint32_t stride, uint32_t members,
+                              const float* composite, uint32_t count, float* deviations) {
+    for (uint32_t m = 0; m < members; m++) {
+        const float* x = values + (size_t)m * stride;
+        float* d = deviations + (size_t)m * stride;
+        for (uint32_t i = 0; i < count; i++) d[i] = x[i] - composite[i];
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * BlackBox DPU - Sensor Redundancy Fusion
+ * Votes a group of redundant channels (four wheel speeds, dual temperature
+ * probes) into one composite channel. The group logs the composite plus
+ * each member's deviation from it, quantized (sample_quant.h), instead of
+ * every member in full, so a faulty member still leaves its evidence.
+ */
+
+#ifndef SENSOR_FUSION_H
+#define SENSOR_FUSION_H
+
+#include "blackbox_common.h"
+
+#define SENSOR_FUSION_MAX_MEMBERS       8
+#define SENSOR_FUSION_CHUNK             1024    // Samples per member per pass
+#define SENSOR_FUSION_VOTE_CHUNK        256     // Samples sorted per pass (stack buffer)
+// Deviations are logged at tolerance / SENSOR_FUSION_DEVIATION_STEPS: a
+// healthy member's stay within one step of the composite and pack into runs
+#define SENSOR_FUSION_DEVIATION_STEPS   4
+// A member with nothing pending holds its group back until the others are
+// this far ahead, then sits passes out until it catches up
+#define SENSOR_FUSION_MAX_LAG_NS        250000000ULL
+
+typedef enum {
+    SENSOR_FUSION_MEDIAN,        // Median of the voting members
+    SENSOR_FUSION_WEIGHTED       // health_score-weighted mean of the voting
+                                 // members within tolerance of their median
+} SensorFusionMode;
+
+struct SensorGroup {
+    char name[32];
+    SensorFusionMode mode;
+    float tolerance;             // Outvote members further than this from the median, 0 = never
+    ChannelHandle composite;     // Fused output channel
+    ChannelHandle members[SENSOR_FUSION_MAX_MEMBERS];
+    uint32_t member_count;
+    float deviation_step;        // Resolution of logged deviations, 0 = adaptive
+    uint64_t next_ts;            // Member samples before this are already fused
+
+    // Statistics
+    uint64_t samples_fused;
+    uint64_t votes_rejected;     // Voting member samples outside tolerance
+    uint64_t passes_without_quorum;     // No healthy member, so every member voted
+    uint64_t passes_member_silent;      // Voted without a member that had nothing pending
+    uint64_t samples_late;       // Member samples older than next_ts, dropped
+};
+
+/* ============================================================================
+ * SENSOR FUSION FUNCTIONS
+ * ============================================================================ */
+
+// Vote count samples of members channels into composite. values is member
+// major, stride floats per member; a member with weight 0 does not vote.
+// Returns the voting member samples that fell outside tolerance.
+uint64_t sensor_fusion_vote(SensorFusionMode mode, float tolerance, const float* values,
+                            uint32_t stride, const float* weights, uint32_t members,
+                            uint32_t count, float* composite);
+
+// deviations[m][i] = values[m][i] - composite[i], same layout as values
+void sensor_fusion_deviations(const float* values, uint32_t stride, uint32_t members,
+                              const float* composite, uint32_t count, float* deviations);
+
+#endif // SENSOR_FUSION_H
@@ -0,0 +1,141 @@
+/*
+ * BlackBox DPU - Batched Sensor Health Kernel Implementation
+ *
+ * Like the fleet drive kernel, the loops run across channels and express
+ * every choice as a blend with a 0/1 weight, so the compiler turns them into
+ * SIMD without branches. A missing sample has weight 0 and leaves the
+ * channel's state alone.
+ */
+
+#include "sensor_health.h"
+#include "sample_ring.h"
+#include "channel_registry.h"
+
+bool sensor_health_init(SensorHealthBatch* batch, uint32_t channels, uint32_t window) {
+    memset(batch, 0, sizeof(SensorHealthBatch));
+    if (channels == 0 || window == 0) return false;
+    if (window > SENSOR_HEALTH_MAX_WINDOW) window = SENSOR_HEALTH_MAX_WINDOW;
+
+    uint32_t stride = (channels + SENSOR_HEALTH_LANES - 1) / SENSOR_HEALTH_LANES * SENSOR_HEALTH_LANES;
+    const uint32_t arrays = 9;
+    size_t step = (size_t)stride * sizeof(float);
+    size_t bytes = step * (arrays + (size_t)window) + (size_t)stride * sizeof(uint64_t);
+    uint8_t* block = (uint8_t*)aligned_alloc(SENSOR_HEALTH_ALIGN, bytes);
+    if (!block) return false;
+    memset(block, 0, bytes);
+
+    // stride is a whole number of cache lines, so every array stays aligned
+    batch->block = block;
+    batch->cursor = (uint64_t*)block;
+    block += (size_t)stride * sizeof(uint64_t);
+    batch->missing = (float*)(block + 0 * step);
+    batch->last_value = (float*)(block + 1 * step);
+    batch->run_length = (float*)(block + 2 * step);
+    batch->mean = (float*)(block + 3 * step);
+    batch->variance = (float*)(block + 4 * step);
+    batch->dropout = (float*)(block + 5 * step);
+    batch->out_of_bounds = (float*)(block + 6 * step);
+    batch->score = (float*)(block + 7 * step);
+    batch->first_row = (float*)(block + 8 * step);
+    batch->values = (float*)(block + arrays * step);
+
+    for (uint32_t c = 0; c < stride; c++) batch->score[c] = 1.0f;
+    batch->count = channels;
+    batch->stride = stride;
+    batch->window = window;
+    return true;
+}
+
+void sensor_health_free(SensorHealthBatch* batch) {
+    free(batch->block);
+    memset(batch, 0, sizeof(SensorHealthBatch));
+}
+
+void sensor_health_gather(SensorHealthBatch* batch, const ChannelRegistry* channels,
+                          uint64_t tick_ns) {
+    const uint32_t stride = batch->stride;
+    const uint32_t window = batch->window;
+    const float tick_s = (float)(tick_ns / 1e9);
+    uint32_t count = channels->count < batch->count ? channels->count : batch->count;
+
+    for (uint32_t c = 0; c < count; c++) {
+        const SensorChannel* ch = channel_registry_at(channels, c);
+        uint32_t n = 0;
+        batch->missing[c] = 0.0f;
+
+        if (ch->samples && ch->state != CHANNEL_OFF) {
+            uint64_t head = sample_ring_head(ch->samples);
+            // A resized ring starts counting again
+            uint64_t from = batch->cursor[c] <= head ? batch->cursor[c] : 0;
+            n = sample_ring_peek_values(ch->samples, from, batch->values + c, stride, window);
+
+            float delivered = (float)(head - from);
+            float expected = (float)ch->sample_rate * tick_s;
+            if (expected >= 1.0f && expected > delivered) {
+                batch->missing[c] = (expected - delivered) / expected;
+            }
+            batch->cursor[c] = head;
+        }
+
+        // Rows before the samples are empty
+        batch->first_row[c] = (float)(window - n);
+    }
+}
+
+void sensor_health_evaluate(SensorHealthBatch* batch) {
+    const uint32_t stride = batch->stride;
+    float* last = batch->last_value;
+    float* run = batch->run_length;
+    float* mean = batch->mean;
+    float* var = batch->variance;
+    float* oob = batch->out_of_bounds;
+
+    const float* first = batch->first_row;
+
+    for (uint32_t k = 0; k < batch->window; k++) {
+        const float* v = batch->values + (size_t)k * stride;
+        const float row = (float)k;
+
+#pragma GCC ivdep
+        for (uint32_t c = 0; c < stride; c++) {
+            float x = v[c];
+            // Empty rows hold stale data and a NaN sample counts as missing;
+            // either is swapped for the last value so no NaN reaches a blend
+            float w = (float)((row >= first[c]) & (x == x));
+            x = w != 0.0f ? x : last[c];
+
+            // Run of identical values: +1 if unchanged, restart if not
+            float next_run = (float)(x == last[c]) * (run[c] + 1.0f);
+            next_run = next_run < 1e7f ? next_run : 1e7f;
+            run[c] += w * (next_run - run[c]);
+            last[c] = x;
+
+            float outside = (float)((x < SENSOR_HEALTH_MIN_VALUE) | (x > SENSOR_HEALTH_MAX_VALUE));
+            oob[c] += w * outside;
+
+            // Exponentially weighted mean and variance
+            float d = x - mean[c];
+            float incr = SENSOR_HEALTH_ALPHA * d;
+            mean[c] += w * incr;
+            var[c] += w * ((1.0f - SENSOR_HEALTH_ALPHA) * (var[c] + d * incr) - var[c]);
+        }
+    }
+
+    const float max_var = SENSOR_HEALTH_MAX_STDDEV * SENSOR_HEALTH_MAX_STDDEV;
+    float* dropout = batch->dropout;
+    const float* missing = batch->missing;
+    float* score = batch->score;
+
+#pragma GCC ivdep
+    for (uint32_t c = 0; c < stride; c++) {
+        dropout[c] += SENSOR_HEALTH_DROPOUT_ALPHA * (missing[c] - dropout[c]);
+
+        float s = 1.0f;
+        s -= SENSOR_HEALTH_PENALTY_STAGNANT * (float)(run[c] > (float)SENSOR_HEALTH_STAGNANT_RUN);
+        s -= SENSOR_HEALTH_PENALTY_BOUNDS * (float)(oob[c] > 0.0f);
+        s -= SENSOR_HEALTH_PENALTY_NOISE * (float)(var[c] > max_var);
+        s -= SENSOR_HEALTH_PENALTY_DROPOUT * (float)(dropout[c] > SENSOR_HEALTH_MAX_DROPOUT);
+        score[c] = s > 0.0f ? s : 0.0f;
+        oob[c] = 0.0f;
+    }
+}
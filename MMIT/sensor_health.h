@@ -0,0 +1,76 @@
+/*
+ * BlackBox DPU - Batched Sensor Health Kernel
+ * Scores every channel in one pass over a window of its newest samples:
+ * stagnation run length, bounds, variance and dropout rate. State is laid
+ * out structure-of-arrays across channels so the update loops vectorize.
+ */
+
+#ifndef SENSOR_HEALTH_H
+#define SENSOR_HEALTH_H
+
+#include "blackbox_common.h"
+
+// Arrays are padded to a whole number of vectors and cache-line aligned
+#define SENSOR_HEALTH_LANES         16
+#define SENSOR_HEALTH_ALIGN         64
+// Most samples per channel evaluated in one tick
+#define SENSOR_HEALTH_MAX_WINDOW    64
+
+// Scoring rules (the per-sample rpu_monitor_sensor_health() applies the
+// stagnation and bounds rules too)
+#define SENSOR_HEALTH_STAGNANT_RUN  100         // Identical samples in a row
+#define SENSOR_HEALTH_MIN_VALUE     -1000.0f
+#define SENSOR_HEALTH_MAX_VALUE     1000.0f
+#define SENSOR_HEALTH_MAX_STDDEV    100.0f      // Of the exponential moving variance
+#define SENSOR_HEALTH_MAX_DROPOUT   0.2f        // Smoothed fraction of missed samples
+#define SENSOR_HEALTH_ALPHA         0.05f       // Moving mean/variance weight per sample
+#define SENSOR_HEALTH_DROPOUT_ALPHA 0.1f        // Dropout weight per tick
+
+#define SENSOR_HEALTH_PENALTY_STAGNANT  0.4f
+#define SENSOR_HEALTH_PENALTY_BOUNDS    0.5f
+#define SENSOR_HEALTH_PENALTY_NOISE     0.2f
+#define SENSOR_HEALTH_PENALTY_DROPOUT   0.3f
+
+struct SensorHealthBatch {
+    uint32_t count;              // Channels
+    uint32_t stride;             // count rounded up to SENSOR_HEALTH_LANES
+    uint32_t window;             // Sample rows per tick
+
+    // Tick input, sample-major: row k of channel c is [k * stride + c].
+    // Samples are right-aligned; rows before first_row are empty.
+    float* values;
+    float* first_row;
+    float* missing;              // Fraction of expected samples not delivered
+
+    // Per-channel state
+    float* last_value;
+    float* run_length;
+    float* mean;
+    float* variance;
+    float* dropout;
+    float* out_of_bounds;        // Samples out of bounds this tick
+    float* score;
+    uint64_t* cursor;            // Ring position evaluated up to
+
+    void* block;
+};
+
+typedef struct SensorHealthBatch SensorHealthBatch;
+
+/* ============================================================================
+ * SENSOR HEALTH FUNCTIONS
+ * ============================================================================ */
+
+bool sensor_health_init(SensorHealthBatch* batch, uint32_t channels, uint32_t window);
+void sensor_health_free(SensorHealthBatch* batch);
+
+// Load each channel's samples pushed since the previous tick (the newest
+// window of them) and how many of the tick_ns worth it was due went missing.
+// OFF channels and channels without a sample ring are left out.
+void sensor_health_gather(SensorHealthBatch* batch, const ChannelRegistry* channels,
+                          uint64_t tick_ns);
+
+// Advance every channel over the gathered window and rescore it
+void sensor_health_evaluate(SensorHealthBatch* batch);
+
+#endif // SENSOR_HEALTH_H
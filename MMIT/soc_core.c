@@ -5,6 +5,15 @@
 
 #include "soc_core.h"
 #include "network_client.h"
+#include "backlog_redemption.h"
+#include "sample_ring.h"
+#include "sensor_health.h"
+#include "rpu_dsp.h"
+#include "sample_quant.h"
+#include "sensor_fusion.h"
+#include "channel_registry.h"
+#include "core_runtime.h"
+#include "history_rollup.h"
 
 // Platform-specific terminal handling
 #if defined(__unix__) || defined(__APPLE__)
@@ -39,6 +48,13 @@ void rpu_init(RPUCore* rpu) {
     rpu->compress_dynamics = false;
     rpu->monitored_channels = 0;
     rpu->health_threshold = 0.3f;  // Flag below 30%
+    rpu->health_batch = NULL;
+
+    enum { N = SENSOR_FUSION_CHUNK, M = SENSOR_FUSION_MAX_MEMBERS };
+    rpu->drain_block = (uint8_t*)malloc(BLACKBOX_LOG_BLOCK_MAX);
+    rpu->drain_packed = (uint8_t*)malloc(BLACKBOX_LOG_BLOCK_MAX);
+    rpu->fusion_values = (float*)malloc((size_t)(2 * M + 1) * N * sizeof(float));
+    rpu->fusion_ts = (uint64_t*)malloc((size_t)M * N * sizeof(uint64_t));
 }
 
 bool apu_validate_config_request(APUCore* apu, bool is_local) {
@@ -58,7 +74,7 @@ bool apu_validate_config_request(APUCore* apu, bool is_local) {
 void rpu_monitor_sensor_health(RPUCore* rpu, SensorChannel* channel, float value) {
     // Multi-factor sensor health analysis
     bool stagnant = (value == channel->last_value);
-    bool out_of_bounds = (value < -1000.0f || value > 1000.0f);
+    bool out_of_bounds = (value < SENSOR_HEALTH_MIN_VALUE || value > SENSOR_HEALTH_MAX_VALUE);
     
     if (stagnant) {
         channel->stagnation_counter++;
@@ -68,8 +84,8 @@ void rpu_monitor_sensor_health(RPUCore* rpu, SensorChannel* channel, float value
     
     // Calculate health score
     float score = 1.0f;
-    if (channel->stagnation_counter > 100) score -= 0.4f;
-    if (out_of_bounds) score -= 0.5f;
+    if (channel->stagnation_counter > SENSOR_HEALTH_STAGNANT_RUN) score -= SENSOR_HEALTH_PENALTY_STAGNANT;
+    if (out_of_bounds) score -= SENSOR_HEALTH_PENALTY_BOUNDS;
     
     channel->health_score = score;
     channel->last_value = value;
@@ -80,6 +96,64 @@ void rpu_monitor_sensor_health(RPUCore* rpu, SensorChannel* channel, float value
     }
 }
 
+void rpu_monitor_channels(BlackBoxSoC* soc, uint64_t tick_ns, uint64_t timestamp) {
+    RPUCore* rpu = &soc->rpu;
+
+    // The window has to hold a tick's worth of the fastest channel
+    uint64_t window = 1;
+    for (uint32_t i = 0; i < soc->channels.count; i++) {
+        const SensorChannel* ch = channel_registry_at(&soc->channels, i);
+        uint64_t due = ((uint64_t)ch->sample_rate * tick_ns + 999999999ULL) / 1000000000ULL;
+        if (ch->state != CHANNEL_OFF && due > window) window = due;
+    }
+    if (window > SENSOR_HEALTH_MAX_WINDOW) window = SENSOR_HEALTH_MAX_WINDOW;
+
+    SensorHealthBatch* batch = rpu->health_batch;
+    if (!batch || batch->count < soc->channels.count || batch->window < window) {
+        // Channels were added or sped up: start over with fresh state
+        if (!batch) batch = (SensorHealthBatch*)malloc(sizeof(SensorHealthBatch));
+        else sensor_health_free(batch);
+        if (!batch || !sensor_health_init(batch, soc->channels.count, (uint32_t)window)) {
+            free(batch);
+            rpu->health_batch = NULL;
+            return;
+        }
+        rpu->health_batch = batch;
+    }
+
+    sensor_health_gather(batch, &soc->channels, tick_ns);
+    sensor_health_evaluate(batch);
+
+    uint32_t monitored = 0;
+    for (uint32_t i = 0; i < soc->channels.count; i++) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, i);
+        if (ch->state == CHANNEL_OFF || !ch->samples) continue;
+        monitored++;
+        ch->health_score = batch->score[i];
+        ch->stagnation_counter = (uint32_t)batch->run_length[i];
+        ch->last_value = batch->last_value[i];
+        if (ch->health_score < rpu->health_threshold && ch->state != CHANNEL_FROZEN) {
+            sensor_channel_set_state(ch, CHANNEL_FROZEN, timestamp);
+        }
+    }
+    rpu->monitored_channels = monitored;
+}
+
+void rpu_cleanup(RPUCore* rpu) {
+    if (rpu->health_batch) {
+        sensor_health_free(rpu->health_batch);
+        free(rpu->health_batch);
+        rpu->health_batch = NULL;
+    }
+    free(rpu->drain_block);
+    free(rpu->drain_packed);
+    free(rpu->fusion_values);
+    free(rpu->fusion_ts);
+    rpu->drain_block = rpu->drain_packed = NULL;
+    rpu->fusion_values = NULL;
+    rpu->fusion_ts = NULL;
+}
+
 /* ============================================================================
  * SENSOR CHANNEL MANAGEMENT
  * ============================================================================ */
@@ -97,6 +171,275 @@ void sensor_channel_init(SensorChannel* channel, uint32_t id, const char* name)
     channel->adaptive_precision = false;
     channel->samples_recorded = 0;
     channel->freeze_start_time = 0;
+    channel->fusion_group = -1;
+    channel->samples = sample_ring_create(sample_ring_capacity_for_rate(channel->sample_rate));
+
+    RpuDspConfig dsp;
+    rpu_dsp_config_defaults(&dsp);
+    channel->dsp = (RpuDspChain*)malloc(sizeof(RpuDspChain));
+    if (channel->dsp) rpu_dsp_configure(channel->dsp, &dsp);
+}
+
+void sensor_channel_free(SensorChannel* channel) {
+    sample_ring_destroy(channel->samples);
+    channel->samples = NULL;
+    free(channel->dsp);
+    channel->dsp = NULL;
+}
+
+bool sensor_channel_set_sample_rate(SensorChannel* channel, uint32_t sample_rate) {
+    if (sample_rate == 0) return false;
+    if (channel->samples && sample_ring_depth(channel->samples) > 0) return false;
+
+    uint64_t capacity = sample_ring_capacity_for_rate(sample_rate);
+    if (!channel->samples || channel->samples->capacity != capacity) {
+        SampleRing* ring = sample_ring_create(capacity);
+        if (!ring) return false;
+        sample_ring_destroy(channel->samples);
+        channel->samples = ring;
+    }
+    channel->sample_rate = sample_rate;
+    return true;
+}
+
+uint32_t sensor_channel_push_samples(SensorChannel* channel, const uint64_t* timestamps,
+                                     const float* values, uint32_t count) {
+    if (!channel->samples || count == 0) return 0;
+    return sample_ring_push(channel->samples, timestamps, values, count);
+}
+
+// With the cores threaded the RPU hands the block to the APU, which owns
+// the logging pipeline; otherwise it is logged here and now
+static bool sensor_log_block(BlackBoxSoC* soc, const uint8_t* block, uint32_t len,
+                             uint64_t ts_start, uint64_t ts_end) {
+    if (soc->runtime) return core_runtime_handoff_log(soc->runtime, block, len, ts_start, ts_end);
+    return blackbox_log_block(soc, block, len, ts_start, ts_end, NULL);
+}
+
+// Whether blocks drained now (blocks of them, at most bytes in total) can
+// be logged; checked before any samples are conditioned, so a refusal
+// leaves the rings untouched
+static bool sensor_log_ready(BlackBoxSoC* soc, uint32_t bytes, uint32_t blocks) {
+    if (soc->runtime) return core_runtime_log_room(soc->runtime, bytes, blocks);
+    return soc->nvme.storage_file != NULL;
+}
+
+// Closed rollup buckets go where the blocks went: to the APU, or straight
+// into the side files. Records the APU cannot take yet wait for the next
+// drain; a failed write is not retried.
+static void sensor_store_rollups(BlackBoxSoC* soc) {
+    HistoryRollup* history = soc->history;
+    for (uint32_t level = 0; level < HISTORY_LEVELS; level++) {
+        uint32_t count = history->pending_count[level];
+        uint32_t done = 0;
+        while (done < count) {
+            uint32_t n = count - done < HISTORY_STORE_BATCH ? count - done : HISTORY_STORE_BATCH;
+            const HistoryRecord* records = history->pending[level] + done;
+            if (soc->runtime) {
+                if (!core_runtime_handoff_rollup(soc->runtime, level, records, n)) break;
+            } else if (!history_rollup_store(history, level, records, n)) {
+                done = count;
+                break;
+            }
+            done += n;
+        }
+        memmove(history->pending[level], history->pending[level] + done,
+                (count - done) * sizeof(HistoryRecord));
+        history->pending_count[level] = count - done;
+    }
+}
+
+// Vote each group's pending samples into its composite channel's ring and
+// log every member's deviation from the composite. Members are matched by
+// timestamp: a pass takes the oldest timestamps pending, voted by the
+// members that hold them, for as long as their timestamps agree. A member
+// with nothing pending holds the group back (SENSOR_FUSION_MAX_LAG_NS);
+// one switched off never does. Returns member samples logged.
+static uint64_t sensor_groups_drain(BlackBoxSoC* soc, uint8_t* packed) {
+    enum { N = SENSOR_FUSION_CHUNK, M = SENSOR_FUSION_MAX_MEMBERS };
+    float* values = soc->rpu.fusion_values;
+    uint64_t* ts = soc->rpu.fusion_ts;
+    float* deviations = values + (size_t)M * N;
+    float* composite = deviations + (size_t)M * N;
+
+    uint64_t logged = 0;
+    for (uint32_t g = 0; g < soc->num_groups; g++) {
+        SensorGroup* group = &soc->groups[g];
+        SensorChannel* out = channel_registry_at(&soc->channels, group->composite);
+        while (true) {
+            // Peek every live member; slot r holds member present[r]
+            SensorChannel* present[M];
+            uint32_t depth[M];
+            uint32_t k = 0;
+            uint64_t front = UINT64_MAX, newest = 0;
+            bool silent = false, late = false;
+            for (uint32_t m = 0; m < group->member_count; m++) {
+                SensorChannel* ch = channel_registry_at(&soc->channels, group->members[m]);
+                if (ch->state == CHANNEL_OFF || !ch->samples) continue;
+                uint64_t* mts = ts + (size_t)k * N;
+                uint32_t got = sample_ring_peek(ch->samples, mts, values + (size_t)k * N, N);
+                if (got == 0) {
+                    silent = true;
+                    continue;
+                }
+                // Arrived after the group voted past them: nothing left to vote with
+                uint32_t stale = 0;
+                while (stale < got && mts[stale] < group->next_ts) stale++;
+                if (stale > 0) {
+                    sample_ring_discard(ch->samples, stale);
+                    group->samples_late += stale;
+                    late = true;
+                    continue;
+                }
+                present[k] = ch;
+                depth[k++] = got;
+                if (mts[0] < front) front = mts[0];
+                if (mts[got - 1] > newest) newest = mts[got - 1];
+            }
+            if (late) continue;
+            if (k == 0 || (silent && newest - front < SENSOR_FUSION_MAX_LAG_NS)) break;
+
+            // Members whose oldest sample is the front vote; the others
+            // start later and bound the pass
+            uint64_t limit = UINT64_MAX;
+            uint32_t voters = 0;
+            for (uint32_t r = 0; r < k; r++) {
+                uint64_t first = ts[(size_t)r * N];
+                if (first != front) {
+                    if (first < limit) limit = first;
+                    continue;
+                }
+                if (r != voters) {
+                    memcpy(ts + (size_t)voters * N, ts + (size_t)r * N, depth[r] * sizeof(uint64_t));
+                    memcpy(values + (size_t)voters * N, values + (size_t)r * N, depth[r] * sizeof(float));
+                    present[voters] = present[r];
+                    depth[voters] = depth[r];
+                }
+                voters++;
+            }
+            k = voters;
+
+            uint32_t n = depth[0];
+            for (uint32_t r = 1; r < k; r++) n = depth[r] < n ? depth[r] : n;
+            uint32_t matched = 0;
+            while (matched < n && ts[matched] < limit) {
+                uint32_t r = 1;
+                while (r < k && ts[(size_t)r * N + matched] == ts[matched]) r++;
+                if (r < k) break;
+                matched++;
+            }
+            n = matched;
+            uint64_t room = out->samples ? out->samples->capacity - sample_ring_depth(out->samples) : 0;
+            if (room < n) n = (uint32_t)room;
+            if (n == 0 || !sensor_log_ready(soc, k * (uint32_t)sample_quant_block_size(32, n, false), k)) break;
+            if (silent) group->passes_member_silent++;
+
+            // Frozen members still log their deviations but lose their vote
+            float weights[M];
+            bool quorum = false;
+            for (uint32_t r = 0; r < k; r++) {
+                bool voting = present[r]->state == CHANNEL_ON || present[r]->state == CHANNEL_RECORDING;
+                weights[r] = voting ? present[r]->health_score : 0.0f;
+                if (weights[r] > 0.0f) quorum = true;
+            }
+            if (!quorum) {
+                for (uint32_t r = 0; r < k; r++) weights[r] = 1.0f;
+                group->passes_without_quorum++;
+            }
+
+            group->votes_rejected += sensor_fusion_vote(group->mode, group->tolerance, values, N,
+                                                        weights, k, n, composite);
+            group->samples_fused += n;
+            group->next_ts = ts[n - 1] + 1;
+            sample_ring_push(out->samples, ts, composite, n);
+
+            sensor_fusion_deviations(values, N, k, composite, n, deviations);
+            for (uint32_t r = 0; r < k; r++) {
+                uint32_t len = sample_quant_encode_step(present[r]->channel_id, group->deviation_step,
+                                                        ts, deviations + (size_t)r * N, n,
+                                                        packed, BLACKBOX_LOG_BLOCK_MAX);
+                if (len > 0) packed[12] |= SAMPLE_QUANT_FLAG_DEVIATION;
+                if (len == 0 || !sensor_log_block(soc, packed, len, ts[0], ts[n - 1])) {
+                    sample_ring_discard(present[r]->samples, n);
+                    continue;
+                }
+                sample_ring_consume(present[r]->samples, n);
+                if (soc->history) {
+                    history_rollup_ingest(soc->history, present[r]->channel_id, ts,
+                                          values + (size_t)r * N, n);
+                }
+                present[r]->samples_recorded += n;
+                logged += n;
+            }
+        }
+    }
+    return logged;
+}
+
+uint64_t sensor_channels_drain(BlackBoxSoC* soc) {
+    uint8_t* block = soc->rpu.drain_block;
+    uint8_t* packed = soc->rpu.drain_packed;
+    if (!block || !packed || !soc->rpu.fusion_values || !soc->rpu.fusion_ts) return 0;
+
+    // Groups first, so this pass also logs the composites they fill
+    uint64_t logged = soc->num_groups > 0 ? sensor_groups_drain(soc, packed) : 0;
+    for (uint32_t i = 0; i < soc->channels.count; i++) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, i);
+        if (!ch->samples || ch->fusion_group >= 0) continue;
+
+        // Samples stay in the ring until their block is logged, so a
+        // pipeline that cannot take one leaves them for a later drain
+        uint32_t len;
+        while (sample_ring_depth(ch->samples) > 0 && sensor_log_ready(soc, BLACKBOX_LOG_BLOCK_MAX, 1) &&
+               (len = sample_ring_peek_block(ch->samples, ch->channel_id, block, BLACKBOX_LOG_BLOCK_MAX)) > 0) {
+            uint32_t n;
+            memcpy(&n, block + 8, sizeof(uint32_t));
+            uint32_t taken = n;
+            uint64_t* ts = (uint64_t*)(block + SAMPLE_BLOCK_HEADER_SIZE);
+            float* values = (float*)(block + SAMPLE_BLOCK_HEADER_SIZE + (size_t)n * sizeof(uint64_t));
+
+            // The RPU conditions (and may decimate) the block before it is logged
+            if (ch->dsp) {
+                uint32_t kept = rpu_dsp_process(ch->dsp, &soc->rpu, ts, values, n);
+                if (kept == 0) {
+                    sample_ring_consume(ch->samples, taken);
+                    continue;
+                }
+                if (kept != n) {
+                    memmove(ts + kept, values, kept * sizeof(float));
+                    memcpy(block + 8, &kept, sizeof(uint32_t));
+                    n = kept;
+                    len = SAMPLE_BLOCK_HEADER_SIZE + n * (uint32_t)SAMPLE_BLOCK_BYTES_PER_SAMPLE;
+                }
+            }
+
+            // Below 32 bits (or when adaptive) the block is logged quantized;
+            // one that will not pack into the slot goes out as floats
+            const uint8_t* out = block;
+            if (ch->bit_depth < 32 || ch->adaptive_precision) {
+                uint32_t packed_len = sample_quant_encode(ch->channel_id, ch->bit_depth,
+                                                          ch->adaptive_precision, ts, values, n,
+                                                          packed, BLACKBOX_LOG_BLOCK_MAX);
+                if (packed_len > 0) {
+                    out = packed;
+                    len = packed_len;
+                }
+            }
+
+            // The DSP state has moved past these samples, so a block refused
+            // after all is dropped rather than conditioned twice
+            if (!sensor_log_block(soc, out, len, ts[0], ts[n - 1])) {
+                sample_ring_discard(ch->samples, taken);
+                break;
+            }
+            sample_ring_consume(ch->samples, taken);
+            if (soc->history) history_rollup_ingest(soc->history, ch->channel_id, ts, values, n);
+            ch->samples_recorded += n;
+            logged += n;
+        }
+    }
+    if (soc->history) sensor_store_rollups(soc);
+    return logged;
 }
 
 void sensor_channel_set_state(SensorChannel* channel, ChannelState state, uint64_t timestamp) {
@@ -115,30 +458,67 @@ float sensor_channel_get_health(SensorChannel* channel) {
  * ============================================================================
  */
 
-// Add a sensor channel dynamically. New channels are appended after existing ones.
-void sensor_channel_add(BlackBoxSoC* soc, const char* name) {
-    uint32_t old_count = soc->num_channels;
-    uint32_t new_count = old_count + 1;
-    SensorChannel* new_buf = (SensorChannel*)realloc(soc->channels, new_count * sizeof(SensorChannel));
-    if (!new_buf) return; // allocation failed
-    soc->channels = new_buf;
-    soc->num_channels = new_count;
-    sensor_channel_init(&soc->channels[new_count - 1], new_count - 1, name);
+// Add a sensor channel dynamically. New channels are appended after existing
+// ones and never move, so earlier handles and pointers stay valid.
+ChannelHandle sensor_channel_add(BlackBoxSoC* soc, const char* name) {
+    SensorChannel* channel = channel_registry_append(&soc->channels, name);
+    if (!channel) return CHANNEL_HANDLE_INVALID;
+    sensor_channel_init(channel, channel->channel_id, name);
+    return channel->channel_id;
 }
 
 // Ensure minimum baseline channels exist (used at init)
 void sensor_ensure_minimum(BlackBoxSoC* soc, uint32_t min_count) {
-    if (soc->num_channels >= min_count) return;
-    SensorChannel* new_buf = (SensorChannel*)realloc(soc->channels, min_count * sizeof(SensorChannel));
-    if (!new_buf) return;
-    soc->channels = new_buf;
-    for (uint32_t i = soc->num_channels; i < min_count; ++i) {
+    if (soc->channels.count >= min_count) return;
+    if (!channel_registry_reserve(&soc->channels, min_count)) return;
+    while (soc->channels.count < min_count) {
         char name[32];
-        snprintf(name, sizeof(name), "Unused_%u", i);
-        sensor_channel_init(&soc->channels[i], i, name);
-        sensor_channel_set_state(&soc->channels[i], CHANNEL_OFF, 0);
+        snprintf(name, sizeof(name), "Unused_%u", soc->channels.count);
+        ChannelHandle handle = sensor_channel_add(soc, name);
+        if (handle == CHANNEL_HANDLE_INVALID) return;
+        sensor_channel_set_state(channel_registry_at(&soc->channels, handle), CHANNEL_OFF, 0);
     }
-    soc->num_channels = min_count;
+}
+
+/* ============================================================================
+ * SENSOR REDUNDANCY FUSION
+ * ============================================================================ */
+
+int32_t sensor_group_add(BlackBoxSoC* soc, const char* name, const uint32_t* members,
+                         uint32_t count, SensorFusionMode mode, float tolerance) {
+    if (count < 2 || count > SENSOR_FUSION_MAX_MEMBERS) return -1;
+    const SensorChannel* lead = channel_registry_at(&soc->channels, members[0]);
+    if (!lead) return -1;
+    for (uint32_t m = 0; m < count; m++) {
+        const SensorChannel* ch = channel_registry_at(&soc->channels, members[m]);
+        if (!ch || ch->fusion_group >= 0 || ch->sample_rate != lead->sample_rate) return -1;
+        for (uint32_t other = 0; other < m; other++) {
+            if (members[other] == members[m]) return -1;
+        }
+    }
+
+    SensorGroup* groups = (SensorGroup*)realloc(soc->groups, (soc->num_groups + 1) * sizeof(SensorGroup));
+    if (!groups) return -1;
+    soc->groups = groups;
+
+    ChannelHandle composite = sensor_channel_add(soc, name);
+    SensorChannel* out = channel_registry_at(&soc->channels, composite);
+    if (!out || !sensor_channel_set_sample_rate(out, lead->sample_rate)) return -1;
+
+    int32_t index = (int32_t)soc->num_groups++;
+    SensorGroup* group = &soc->groups[index];
+    memset(group, 0, sizeof(SensorGroup));
+    snprintf(group->name, sizeof(group->name), "%s", name);
+    group->mode = mode;
+    group->tolerance = tolerance;
+    group->composite = composite;
+    group->deviation_step = tolerance > 0.0f ? tolerance / SENSOR_FUSION_DEVIATION_STEPS : 0.0f;
+    for (uint32_t m = 0; m < count; m++) {
+        group->members[m] = members[m];
+        channel_registry_at(&soc->channels, members[m])->fusion_group = index;
+    }
+    group->member_count = count;
+    return index;
 }
 
 // Live in-place channel display using ANSI escape sequences.
@@ -151,7 +531,7 @@ void soc_display_channels(BlackBoxSoC* soc) {
     }
     
     // Count lines: one header + one per channel
-    int lines = 2 + (int)soc->num_channels; // header + blank + channels
+    int lines = 2 + (int)soc->channels.count; // header + blank + channels
 
     // If we've printed before, move cursor up to overwrite the block
     if (g_last_display_lines > 0) {
@@ -164,8 +544,8 @@ void soc_display_channels(BlackBoxSoC* soc) {
     printf("(Press Ctrl-C to interrupt)\n");
 
     // Print each channel line
-    for (uint32_t i = 0; i < soc->num_channels; ++i) {
-        SensorChannel* ch = &soc->channels[i];
+    for (uint32_t i = 0; i < soc->channels.count; ++i) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, i);
         const char* state_str = (ch->state == CHANNEL_ON) ? "ON" :
                                 (ch->state == CHANNEL_FROZEN) ? "FROZEN" :
                                 (ch->state == CHANNEL_RECORDING) ? "REC" : "OFF";
@@ -234,13 +614,17 @@ void soc_handle_command(BlackBoxSoC* soc, const char* cmd) {
     // Simple command parsing: add <name>, list, help
     if (strncmp(cmd, "add ", 4) == 0) {
         const char* name = cmd + 4;
-        sensor_channel_add(soc, name);
-        printf("Added sensor '%s' as CH%u\n", name, soc->num_channels - 1);
+        ChannelHandle handle = sensor_channel_add(soc, name);
+        if (handle == CHANNEL_HANDLE_INVALID) {
+            printf("Could not add sensor '%s'\n", name);
+        } else {
+            printf("Added sensor '%s' as CH%u\n", name, handle);
+        }
         soc_display_channels(soc);
     } else if (strcmp(cmd, "list") == 0) {
-        printf("Channels (%u):\n", soc->num_channels);
-        for (uint32_t i = 0; i < soc->num_channels; ++i) {
-            SensorChannel* ch = &soc->channels[i];
+        printf("Channels (%u):\n", soc->channels.count);
+        for (uint32_t i = 0; i < soc->channels.count; ++i) {
+            SensorChannel* ch = channel_registry_at(&soc->channels, i);
             printf("  CH%u: %s (%s)\n", ch->channel_id, ch->name,
                    ch->state == CHANNEL_ON ? "ON" : "OFF");
         }
@@ -270,14 +654,17 @@ void add_event_marker(BlackBoxSoC* soc, const char* label, const char* metadata)
 }
 
 void add_log_index_entry(BlackBoxSoC* soc, uint64_t ts_start, uint64_t ts_end, 
-                         uint64_t offset, uint32_t comp_size) {
+                         uint64_t offset, uint32_t comp_size, uint32_t uncomp_size) {
     LogIndex* entry = (LogIndex*)malloc(sizeof(LogIndex));
     entry->timestamp_start = ts_start;
     entry->timestamp_end = ts_end;
     entry->file_offset = offset;
     entry->compressed_size = comp_size;
+    entry->uncompressed_size = uncomp_size;
     entry->next = soc->log_index;
     soc->log_index = entry;
+    
+    nvme_persist_index_entry(soc, entry);
 }
 
 LogIndex* query_log_by_timestamp(BlackBoxSoC* soc, uint64_t timestamp) {
@@ -301,23 +688,84 @@ void cloud_sync_init(CloudSyncState* sync) {
     sync->last_sync_timestamp = 0;
     sync->backlog_bytes = 0;
     sync->redemption_in_progress = false;
+    sync->probing = false;
 }
 
 void cloud_sync_update_watermark(CloudSyncState* sync, uint64_t timestamp) {
     sync->last_sync_timestamp = timestamp;
 }
 
+static void cloud_sync_announce(BlackBoxSoC* soc) {
+    printf("[%lu ns] Cloud reconnected - starting backlog redemption\n",
+           soc->event_queue.current_time);
+    add_event_marker(soc, "Backlog-Start", 
+                    "{\"event\": \"cloud_reconnect\"}");
+}
+
 void cloud_sync_handle_reconnect(BlackBoxSoC* soc) {
     if (!soc->cloud_sync.connected) {
-        printf("[%lu ns] Cloud reconnected - starting backlog redemption\n",
-               soc->event_queue.current_time);
         soc->cloud_sync.connected = true;
-        soc->cloud_sync.redemption_in_progress = true;
-        add_event_marker(soc, "Backlog-Start", 
-                        "{\"event\": \"cloud_reconnect\"}");
+        redemption_start(soc);
+        cloud_sync_announce(soc);
+    }
+}
+
+void cloud_sync_probe(BlackBoxSoC* soc) {
+    if (!soc->cloud_sync.connected) {
+        soc->cloud_sync.connected = true;
+        soc->cloud_sync.probing = true;
+        redemption_start(soc);
     }
 }
 
+void cloud_sync_confirm(BlackBoxSoC* soc) {
+    if (soc->cloud_sync.probing) {
+        soc->cloud_sync.probing = false;
+        cloud_sync_announce(soc);
+    }
+}
+
+void cloud_sync_handle_disconnect(BlackBoxSoC* soc) {
+    if (soc->cloud_sync.probing) {
+        // Never announced: drop the try quietly
+        soc->cloud_sync.probing = false;
+        soc->cloud_sync.connected = false;
+        redemption_abort(soc);
+    } else if (soc->cloud_sync.connected) {
+        printf("[%lu ns] Cloud disconnected - backlog held at offset %lu\n",
+               soc->event_queue.current_time, soc->cloud_sync.last_sync_offset);
+        soc->cloud_sync.connected = false;
+        redemption_abort(soc);
+        add_event_marker(soc, "Backlog-Hold",
+                        "{\"event\": \"cloud_disconnect\"}");
+    }
+}
+
+// Send one indexed log block to the cloud straight from mapped storage,
+// split into MAC-sized chunks. Returns true only if every chunk went out.
+bool cloud_transmit_log_block(BlackBoxSoC* soc, const LogIndex* entry, uint32_t* chunks_out) {
+    NVMeRegion region;
+    if (!nvme_map_region(soc, entry->file_offset, entry->compressed_size, &region)) {
+        return false;
+    }
+    if (!region.mapped) {
+        soc->eth_mac.bytes_copied += region.length;
+    }
+
+    uint32_t chunks = 0;
+    bool sent_ok = true;
+    for (uint32_t sent = 0; sent < region.length && sent_ok; sent += ETH_TX_MAX_CHUNK) {
+        uint32_t chunk = region.length - sent;
+        if (chunk > ETH_TX_MAX_CHUNK) chunk = ETH_TX_MAX_CHUNK;
+        sent_ok = ethernet_transmit_buffer(soc, region.data + sent, chunk);
+        chunks++;
+    }
+    nvme_unmap_region(&region);
+
+    if (chunks_out) *chunks_out = chunks;
+    return sent_ok;
+}
+
 bool apu_request_controller_permission(APUCore* apu) {
     // Simulate asking for permission from the pilot/controller
     // In a real system, this would involve a more complex interaction
@@ -371,25 +819,21 @@ void handle_cloud_transfer_request(BlackBoxSoC* soc, uint64_t timestamp, const c
     printf("Found data block at offset %lu (size: %u bytes).\n", 
            log_entry->file_offset, log_entry->compressed_size);
 
-    // 4. Read data from NVMe storage
-    uint8_t* data_to_transfer = (uint8_t*)malloc(log_entry->compressed_size);
-    fseek(soc->nvme.storage_file, log_entry->file_offset, SEEK_SET);
-    fread(data_to_transfer, 1, log_entry->compressed_size, soc->nvme.storage_file);
-
-    // 5. Copy data to Ethernet buffer
-    uint32_t eth_buf_addr = SBM_BASE + (3 * 1024 * 1024); // Use the dedicated ETH buffer
-    uint8_t* eth_buf = memory_translate(&soc->memory, eth_buf_addr);
-    memcpy(eth_buf, data_to_transfer, log_entry->compressed_size);
-    free(data_to_transfer);
-
-    // 6. Transmit data via Ethernet
+    // 4. Transmit straight from mapped NVMe storage (no staging copy)
+    uint32_t chunks = 0;
+    bool was_connected = soc->cloud_sync.connected;
     soc->cloud_sync.connected = true;
-    bus_write(soc, ETH_TX_BUF_ADDR, eth_buf_addr);
-    bus_write(soc, ETH_TX_BUF_LEN, log_entry->compressed_size);
-    bus_write(soc, ETH_CTRL_REG, 0x01); // Start transmission
-    soc->cloud_sync.connected = false;
+    bool sent_ok = cloud_transmit_log_block(soc, log_entry, &chunks);
+    soc->cloud_sync.connected = was_connected;
+
+    if (!sent_ok) {
+        printf("Transfer FAILED: Network transmission incomplete.\n");
+        return;
+    }
+    printf("Transmitted %u bytes in %u chunk(s).\n", log_entry->compressed_size, chunks);
 
-    cloud_sync_update_watermark(&soc->cloud_sync, soc->event_queue.current_time);
+    // A query transfer is out-of-band: it must not move the redemption
+    // watermark, which only advances over contiguous acknowledged blocks.
 
     printf("[%lu ns] === Cloud Transfer Request Completed Successfully ===\n", 
            soc->event_queue.current_time);
@@ -399,7 +843,7 @@ void handle_cloud_transfer_request(BlackBoxSoC* soc, uint64_t timestamp, const c
  * SOC INITIALIZATION
  * ============================================================================ */
 
-void blackbox_soc_init(BlackBoxSoC* soc, bool verbose, bool interactive) {
+void blackbox_soc_init(BlackBoxSoC* soc, bool verbose, bool interactive, bool resume_log) {
     memset(soc, 0, sizeof(BlackBoxSoC));
     soc->verbose = verbose;
     soc->interactive_display = interactive;
@@ -424,21 +868,25 @@ void blackbox_soc_init(BlackBoxSoC* soc, bool verbose, bool interactive) {
     // even when no external sensors are assigned. Additional sensors can be
     // added dynamically with sensor_channel_add().
     uint32_t initial_channels = 4; // default visible baseline
-    soc->num_channels = initial_channels;
-    soc->channels = (SensorChannel*)calloc(soc->num_channels, sizeof(SensorChannel));
-    for (uint32_t i = 0; i < soc->num_channels; ++i) {
-        char name[32];
-        snprintf(name, sizeof(name), "Unused_%u", i);
-        sensor_channel_init(&soc->channels[i], i, name);
-        sensor_channel_set_state(&soc->channels[i], CHANNEL_OFF, 0);
-    }
+    channel_registry_init(&soc->channels);
+    sensor_ensure_minimum(soc, initial_channels);
     
     // Initialize event markers and log index
     soc->markers = NULL;
     soc->log_index = NULL;
     
-    // Open NVMe storage file
-    soc->nvme.storage_file = fopen("nvme_storage.bin", "wb");
+    // Open NVMe storage and its index (optionally resuming a previous log),
+    // then restore the durable cloud sync watermark
+    if (!nvme_open_storage(soc, resume_log)) {
+        fprintf(stderr, "Warning: NVMe storage could not be opened\n");
+    }
+    soc->history = (HistoryRollup*)malloc(sizeof(HistoryRollup));
+    if (soc->history && !history_rollup_open(soc->history, NVME_HISTORY_BASE, resume_log)) {
+        fprintf(stderr, "Warning: history rollups could not be opened\n");
+        free(soc->history);
+        soc->history = NULL;
+    }
+    redemption_init(soc);
     
     printf("BlackBox DPU Virtual Platform Initialized\n");
     printf("=========================================\n");
@@ -455,7 +903,7 @@ void blackbox_soc_init(BlackBoxSoC* soc, bool verbose, bool interactive) {
     printf("  DMA Engine: 0x%08X (4 channels)\n", DMA_REGS_BASE);
     printf("  NVMe Controller: 0x%08X\n", PCIE_REGS_BASE);
     printf("  Ethernet MAC: 0x%08X\n", ETH_MAC_REGS_BASE);
-    printf("\nSensor Channels: %u configured\n", soc->num_channels);
+    printf("\nSensor Channels: %u configured\n", soc->channels.count);
     printf("Security Model: Local-First (remote config %s)\n\n",
         soc->apu.allow_remote_config ? "ENABLED" : "DISABLED");
     
@@ -465,18 +913,26 @@ void blackbox_soc_init(BlackBoxSoC* soc, bool verbose, bool interactive) {
     }
 }
 void blackbox_soc_cleanup(BlackBoxSoC* soc) {
-    // Cleanup network client
+    // Cleanup network client, then retire the uploads it finished
     network_client_cleanup();
+    ethernet_reap_tx(soc);
     
     memory_cleanup(&soc->memory);
-    if (soc->nvme.storage_file) {
-        fclose(soc->nvme.storage_file);
+    nvme_close_storage(soc);
+    if (soc->history) {
+        history_rollup_close(soc->history);
+        free(soc->history);
+        soc->history = NULL;
     }
+    redemption_cleanup(soc);
+    rpu_cleanup(&soc->rpu);
     
     // Clean up sensor channels
-    if (soc->channels) {
-        free(soc->channels);
+    for (uint32_t i = 0; i < soc->channels.count; i++) {
+        sensor_channel_free(channel_registry_at(&soc->channels, i));
     }
+    channel_registry_free(&soc->channels);
+    free(soc->groups);
     
     // Clean up event markers
     while (soc->markers) {
@@ -504,12 +960,11 @@ void blackbox_soc_cleanup(BlackBoxSoC* soc) {
  * HIGH-LEVEL DATA FLOW ORCHESTRATION (Section 5.1)
  * ============================================================================ */
 
-void blackbox_process_data_block(BlackBoxSoC* soc, uint8_t* input_data, uint32_t data_size) {
-    printf("\n[%lu ns] === Starting Dual-Path Logging Pipeline ===\n", 
-           soc->event_queue.current_time);
-    
-    uint64_t pipeline_start = soc->event_queue.current_time;
-    
+// Steps 1-3: stage input in the SBM, compress it and DMA the result to the
+// NVMe write buffer. Returns the compressed size. The console-facing pipeline
+// keeps the live display and command prompt serviced while it waits.
+static uint32_t pipeline_compress_block(BlackBoxSoC* soc, const uint8_t* input_data,
+                                        uint32_t data_size, bool service_console) {
     // Step 1: Copy input data to SBM input buffer
     uint32_t input_buf_addr = SBM_BASE;
     uint8_t* input_buf = memory_translate(&soc->memory, input_buf_addr);
@@ -527,43 +982,73 @@ void blackbox_process_data_block(BlackBoxSoC* soc, uint8_t* input_data, uint32_t
     // Process events until compression completes
     while (soc->zstd.busy) {
         event_process_next(&soc->event_queue);
-        // Update live channel display while waiting
-        soc_display_channels(soc);
-        soc_poll_input(soc);
+        if (service_console) {
+            // Update live channel display while waiting
+            soc_display_channels(soc);
+            soc_poll_input(soc);
+        }
     }
     
     uint32_t compressed_size = bus_read(soc, ZSTD_COMP_SIZE_REG);
     
-    // Step 3: Configure DMA for NVMe logging
-    uint32_t nvme_buf_addr = SBM_BASE + (2 * 1024 * 1024);  // 2MB offset
-
-    // Configure DMA Channel 2 for NVMe logging
+    // Step 3: Configure DMA Channel 2 for NVMe logging
     bus_write(soc, DMA_CH2_CTRL + 0x08, comp_output_addr);  // SRC_ADDR
-    bus_write(soc, DMA_CH2_CTRL + 0x0C, nvme_buf_addr);     // DST_ADDR
+    bus_write(soc, DMA_CH2_CTRL + 0x0C, SBM_NVME_BUF);      // DST_ADDR
     bus_write(soc, DMA_CH2_CTRL + 0x10, compressed_size);   // LENGTH
     bus_write(soc, DMA_CH2_CTRL, DMA_CTRL_START);
     
     // Process DMA transfer event
     while (soc->dma.channels[2].busy) {
         event_process_next(&soc->event_queue);
-        // Update live channel display while waiting for DMA
-        soc_display_channels(soc);
-        soc_poll_input(soc);
+        if (service_console) {
+            // Update live channel display while waiting for DMA
+            soc_display_channels(soc);
+            soc_poll_input(soc);
+        }
     }
     
+    return compressed_size;
+}
+
+// Steps 4-5: index the staged block and write it to NVMe storage
+static void pipeline_commit_block(BlackBoxSoC* soc, uint64_t ts_start, uint64_t ts_end,
+                                  uint32_t compressed_size, uint32_t data_size) {
     // Step 4: Add log index entry
-    add_log_index_entry(soc, pipeline_start, soc->event_queue.current_time,
-                       soc->nvme.bytes_written, compressed_size);
+    add_log_index_entry(soc, ts_start, ts_end,
+                       soc->nvme.bytes_written, compressed_size, data_size);
     
     // Step 5: Write to NVMe storage
-    bus_write(soc, NVME_WRITE_BUF_ADDR, nvme_buf_addr);
+    bus_write(soc, NVME_WRITE_BUF_ADDR, SBM_NVME_BUF);
     bus_write(soc, NVME_WRITE_BUF_LEN, compressed_size);
     bus_write(soc, NVME_CTRL_REG, 0x01);  // Start write
     
+    soc->cloud_sync.backlog_bytes = soc->nvme.bytes_written - soc->cloud_sync.last_sync_offset;
+}
+
+void blackbox_process_data_block(BlackBoxSoC* soc, uint8_t* input_data, uint32_t data_size) {
+    printf("\n[%lu ns] === Starting Dual-Path Logging Pipeline ===\n", 
+           soc->event_queue.current_time);
+    
+    uint64_t pipeline_start = soc->event_queue.current_time;
+    uint32_t compressed_size = pipeline_compress_block(soc, input_data, data_size, true);
+    pipeline_commit_block(soc, pipeline_start, soc->event_queue.current_time,
+                          compressed_size, data_size);
+    
     printf("[%lu ns] === Local Logging Complete ===\n\n", 
            soc->event_queue.current_time);
 }
 
+bool blackbox_log_block(BlackBoxSoC* soc, const uint8_t* input_data, uint32_t data_size,
+                        uint64_t ts_start, uint64_t ts_end, uint32_t* compressed_out) {
+    if (data_size == 0 || data_size > BLACKBOX_LOG_BLOCK_MAX || !soc->nvme.storage_file) {
+        return false;
+    }
+    uint32_t compressed_size = pipeline_compress_block(soc, input_data, data_size, false);
+    pipeline_commit_block(soc, ts_start, ts_end, compressed_size, data_size);
+    if (compressed_out) *compressed_out = compressed_size;
+    return true;
+}
+
 /* ============================================================================
  * STATISTICS REPORTING
  * ============================================================================ */
@@ -581,8 +1066,8 @@ void print_statistics(BlackBoxSoC* soc) {
            soc->apu.allow_remote_config ? "Remote Allowed" : "Remote Blocked");
     
     printf("\nSensor Channels:\n");
-    for (uint32_t i = 0; i < soc->num_channels; i++) {
-        SensorChannel* ch = &soc->channels[i];
+    for (uint32_t i = 0; i < soc->channels.count; i++) {
+        SensorChannel* ch = channel_registry_at(&soc->channels, i);
         printf("  CH%u [%-16s]: %s (Health: %.1f%%)\n",
                ch->channel_id, ch->name,
                ch->state == CHANNEL_ON ? "ON" :
@@ -605,8 +1090,16 @@ void print_statistics(BlackBoxSoC* soc) {
     printf("  Connection status:    %s\n", soc->cloud_sync.connected ? "Connected" : "Disconnected");
     printf("  Total packets:        %u\n", soc->eth_mac.packets_transmitted);
     printf("  Total bytes sent:     %lu bytes\n", soc->eth_mac.bytes_transmitted);
+    printf("  Bytes copied/sent:    %.3f\n", soc->eth_mac.bytes_transmitted ?
+           (double)soc->eth_mac.bytes_copied / soc->eth_mac.bytes_transmitted : 0.0);
     printf("  Backlog bytes:        %lu bytes\n", soc->cloud_sync.backlog_bytes);
-    printf("  Last sync watermark:  %lu ns\n", soc->cloud_sync.last_sync_timestamp);
+    printf("  Last sync watermark:  %lu ns (offset %lu)\n",
+           soc->cloud_sync.last_sync_timestamp, soc->cloud_sync.last_sync_offset);
+    printf("  Blocks redeemed:      %lu (%lu bytes, %u send failures)\n",
+           soc->redemption.blocks_redeemed, soc->redemption.bytes_redeemed,
+           soc->redemption.send_failures);
+    
+    http_transport_print_stats();
     
     printf("\nNetwork-on-Chip Statistics:\n");
     printf("  Total transactions:   %lu\n", soc->noc_stats.total_transactions);
@@ -14,14 +14,25 @@
 #include "nvme_controller.h"
 #include "ethernet_mac.h"
 #include "bus_interconnect.h"
+#include "sensor_fusion.h"
+
+// Largest block blackbox_log_block() accepts: the RLE model can triple its
+// input, and the compressed block has to fit one SBM slot
+#define BLACKBOX_LOG_BLOCK_MAX  (SBM_SLOT_SIZE / 3)
 
 /* ============================================================================
  * SOC CORE FUNCTIONS
  * ============================================================================ */
 
-void blackbox_soc_init(BlackBoxSoC* soc, bool verbose, bool interactive);
+void blackbox_soc_init(BlackBoxSoC* soc, bool verbose, bool interactive, bool resume_log);
 void blackbox_soc_cleanup(BlackBoxSoC* soc);
 void blackbox_process_data_block(BlackBoxSoC* soc, uint8_t* input_data, uint32_t data_size);
+
+// Same Zstd -> DMA -> NVMe path without the console trace, indexed by the
+// capture time span of the data rather than the pipeline's own clock.
+// Returns false if the block is empty, too large or storage is not open.
+bool blackbox_log_block(BlackBoxSoC* soc, const uint8_t* input_data, uint32_t data_size,
+                        uint64_t ts_start, uint64_t ts_end, uint32_t* compressed_out);
 void print_statistics(BlackBoxSoC* soc);
 
 /* ============================================================================
@@ -33,15 +44,48 @@ void rpu_init(RPUCore* rpu);
 bool apu_validate_config_request(APUCore* apu, bool is_local);
 void rpu_monitor_sensor_health(RPUCore* rpu, SensorChannel* channel, float value);
 
+// Score every channel from the samples pushed in the last tick_ns in one
+// batched pass (sensor_health.h), freezing any that fall below the health
+// threshold. Runs on the thread that drains the sample rings, before it
+// drains them.
+void rpu_monitor_channels(BlackBoxSoC* soc, uint64_t tick_ns, uint64_t timestamp);
+void rpu_cleanup(RPUCore* rpu);
+
 /* ============================================================================
  * SENSOR CHANNEL MANAGEMENT
  * ============================================================================ */
 
 void sensor_channel_init(SensorChannel* channel, uint32_t id, const char* name);
+void sensor_channel_free(SensorChannel* channel);
+
+// Resize the sample ring for a new rate. Fails while samples are pending.
+bool sensor_channel_set_sample_rate(SensorChannel* channel, uint32_t sample_rate);
+
+// Bulk-append samples from the channel's single producer: lock-free and
+// allocation-free. Returns how many fit; the rest are counted as dropped.
+uint32_t sensor_channel_push_samples(SensorChannel* channel, const uint64_t* timestamps,
+                                     const float* values, uint32_t count);
+
+// Consumer side: log every channel's pending samples as blocks
+// (sample_ring.h layout) indexed by their timestamps. Fusion group members
+// are voted into their composite and logged as deviations from it
+// (sensor_fusion.h). Logged samples also feed the history rollups
+// (history_rollup.h). While the cores run as threads the blocks and closed
+// rollups go to the APU instead (core_runtime.h). Samples leave their ring
+// only once their block is logged or handed over; one refused after its
+// samples were conditioned is counted as dropped. Returns samples logged or
+// handed over.
+uint64_t sensor_channels_drain(BlackBoxSoC* soc);
 void sensor_channel_set_state(SensorChannel* channel, ChannelState state, uint64_t timestamp);
 float sensor_channel_get_health(SensorChannel* channel);
-void sensor_channel_add(BlackBoxSoC* soc, const char* name);
+ChannelHandle sensor_channel_add(BlackBoxSoC* soc, const char* name);
 void sensor_ensure_minimum(BlackBoxSoC* soc, uint32_t min_count);
+
+// Fuse count redundant channels (same sample rate, not already grouped) into
+// a new composite channel named name. Members are then logged only as
+// deviations from the composite. Returns the group index, -1 on bad members.
+int32_t sensor_group_add(BlackBoxSoC* soc, const char* name, const uint32_t* members,
+                         uint32_t count, SensorFusionMode mode, float tolerance);
 void soc_display_channels(BlackBoxSoC* soc);
 
 // Poll for interactive input (non-blocking). On POSIX this will check stdin
@@ -55,7 +99,8 @@ void soc_handle_command(BlackBoxSoC* soc, const char* cmd);
  * ============================================================================ */
 
 void add_event_marker(BlackBoxSoC* soc, const char* label, const char* metadata);
-void add_log_index_entry(BlackBoxSoC* soc, uint64_t ts_start, uint64_t ts_end, uint64_t offset, uint32_t comp_size);
+void add_log_index_entry(BlackBoxSoC* soc, uint64_t ts_start, uint64_t ts_end, uint64_t offset,
+                         uint32_t comp_size, uint32_t uncomp_size);
 LogIndex* query_log_by_timestamp(BlackBoxSoC* soc, uint64_t timestamp);
 
 /* ============================================================================
@@ -65,6 +110,14 @@ LogIndex* query_log_by_timestamp(BlackBoxSoC* soc, uint64_t timestamp);
 void cloud_sync_init(CloudSyncState* sync);
 void cloud_sync_update_watermark(CloudSyncState* sync, uint64_t timestamp);
 void cloud_sync_handle_reconnect(BlackBoxSoC* soc);
+void cloud_sync_handle_disconnect(BlackBoxSoC* soc);
+
+// Retry a link that is down without announcing it: redemption restarts
+// quietly, the reconnect is reported on its first acknowledged block
+// (cloud_sync_confirm) and a failed try leaves no trace in the event log
+void cloud_sync_probe(BlackBoxSoC* soc);
+void cloud_sync_confirm(BlackBoxSoC* soc);
+bool cloud_transmit_log_block(BlackBoxSoC* soc, const LogIndex* entry, uint32_t* chunks_out);
 bool apu_request_controller_permission(APUCore* apu);
 bool read_marker_key(char* buffer, size_t len);
 void handle_cloud_transfer_request(BlackBoxSoC* soc, uint64_t timestamp, const char* key);
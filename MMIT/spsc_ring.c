@@ -0,0 +1,103 @@
+/*
+ * BlackBox DPU - Lock-Free SPSC Ring Implementation
+ *
+ * head and tail are free-running counters; index = counter & mask. Under
+ * DROP_OLDEST the producer may advance tail itself, so the consumer copies
+ * an element first and then claims it with a CAS on tail. A failed CAS
+ * means the slot was evicted (and possibly overwritten) meanwhile, so the
+ * copy is discarded and the pop retried.
+ */
+
+#include "spsc_ring.h"
+#include <stdlib.h>
+#include <string.h>
+
+static uint64_t round_up_pow2(uint64_t v) {
+    uint64_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+bool spsc_ring_init(SpscRing* ring, size_t elem_size, uint64_t capacity, SpscOverflowPolicy policy) {
+    memset(ring, 0, sizeof(SpscRing));
+    if (elem_size == 0 || capacity == 0) return false;
+
+    ring->capacity = round_up_pow2(capacity);
+    ring->mask = ring->capacity - 1;
+    ring->elem_size = elem_size;
+    ring->policy = policy;
+    ring->slots = (uint8_t*)calloc(ring->capacity, elem_size);
+    if (!ring->slots) return false;
+
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->pushed, 0);
+    atomic_init(&ring->dropped, 0);
+    atomic_init(&ring->high_water, 0);
+    return true;
+}
+
+void spsc_ring_free(SpscRing* ring) {
+    free(ring->slots);
+    ring->slots = NULL;
+}
+
+bool spsc_ring_push(SpscRing* ring, const void* elem) {
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (head - tail >= ring->capacity) {
+        if (ring->policy == SPSC_DROP_NEWEST) {
+            atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+            return false;
+        }
+        // Evict the oldest; if the consumer got there first there is room anyway
+        if (atomic_compare_exchange_strong(&ring->tail, &tail, tail + 1)) {
+            atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        }
+    }
+
+    memcpy(ring->slots + (head & ring->mask) * ring->elem_size, elem, ring->elem_size);
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    atomic_fetch_add_explicit(&ring->pushed, 1, memory_order_relaxed);
+
+    uint64_t depth = head + 1 - atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    if (depth > atomic_load_explicit(&ring->high_water, memory_order_relaxed)) {
+        atomic_store_explicit(&ring->high_water, depth, memory_order_relaxed);
+    }
+    return true;
+}
+
+bool spsc_ring_pop(SpscRing* ring, void* out) {
+    while (true) {
+        uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (tail == head) return false;
+
+        memcpy(out, ring->slots + (tail & ring->mask) * ring->elem_size, ring->elem_size);
+
+        if (ring->policy == SPSC_DROP_NEWEST) {
+            // Only the consumer moves tail
+            atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+            return true;
+        }
+        if (atomic_compare_exchange_strong(&ring->tail, &tail, tail + 1)) {
+            return true;
+        }
+    }
+}
+
+uint64_t spsc_ring_depth(const SpscRing* ring) {
+    uint64_t tail = atomic_load_explicit(&((SpscRing*)ring)->tail, memory_order_acquire);
+    uint64_t head = atomic_load_explicit(&((SpscRing*)ring)->head, memory_order_acquire);
+    return head >= tail ? head - tail : 0;
+}
+
+void spsc_ring_get_stats(const SpscRing* ring, SpscRingStats* stats) {
+    SpscRing* r = (SpscRing*)ring;
+    stats->depth = spsc_ring_depth(ring);
+    stats->capacity = ring->capacity;
+    stats->high_water = atomic_load_explicit(&r->high_water, memory_order_relaxed);
+    stats->pushed = atomic_load_explicit(&r->pushed, memory_order_relaxed);
+    stats->dropped = atomic_load_explicit(&r->dropped, memory_order_relaxed);
+}
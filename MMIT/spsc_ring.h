@@ -0,0 +1,65 @@
+/*
+ * BlackBox DPU - Lock-Free SPSC Ring
+ * Fixed-size element queue between exactly one producer and one consumer
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#define SPSC_CACHE_LINE     64
+
+// What a push does when the ring is full. The producer never blocks.
+typedef enum {
+    SPSC_DROP_NEWEST,        // Reject the new element
+    SPSC_DROP_OLDEST         // Evict the oldest queued element to make room
+} SpscOverflowPolicy;
+
+typedef struct {
+    // Producer-owned
+    _Alignas(SPSC_CACHE_LINE) _Atomic uint64_t head;
+    _Atomic uint64_t pushed;
+    _Atomic uint64_t dropped;
+    _Atomic uint64_t high_water;
+
+    // Consumer-owned (the producer advances it only under DROP_OLDEST)
+    _Alignas(SPSC_CACHE_LINE) _Atomic uint64_t tail;
+
+    _Alignas(SPSC_CACHE_LINE) uint8_t* slots;
+    size_t elem_size;
+    uint64_t capacity;       // Power of two
+    uint64_t mask;
+    SpscOverflowPolicy policy;
+} SpscRing;
+
+typedef struct {
+    uint64_t depth;
+    uint64_t capacity;
+    uint64_t high_water;
+    uint64_t pushed;
+    uint64_t dropped;
+} SpscRingStats;
+
+/* ============================================================================
+ * SPSC RING FUNCTIONS
+ * ============================================================================ */
+
+// capacity is rounded up to a power of two
+bool spsc_ring_init(SpscRing* ring, size_t elem_size, uint64_t capacity, SpscOverflowPolicy policy);
+void spsc_ring_free(SpscRing* ring);
+
+// Producer side. Returns false if the element was dropped (DROP_NEWEST);
+// under DROP_OLDEST it always succeeds and counts the evicted element.
+bool spsc_ring_push(SpscRing* ring, const void* elem);
+
+// Consumer side. Returns false when empty.
+bool spsc_ring_pop(SpscRing* ring, void* out);
+
+uint64_t spsc_ring_depth(const SpscRing* ring);
+void spsc_ring_get_stats(const SpscRing* ring, SpscRingStats* stats);
+
+#endif // SPSC_RING_H
@@ -0,0 +1,162 @@
+/*
+ * BlackBox DPU - Telemetry Deadband Filter Implementation
+ *
+ * Values are compared against the last value sent, not the last sample, so
+ * a slow drift is still reported once it adds up to the threshold.
+ */
+
+#include "telemetry_deadband.h"
+#include "network_config.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define KEEPALIVE   TELEMETRY_DEADBAND_KEEPALIVE_MS
+
+// Thresholds sit at or below what the dashboard displays; 0 = any change
+static const char* const g_field_names[TELEMETRY_FIELD_COUNT] = {
+    "speed_kph", "rpm", "throttle_pct", "brake_pct", "battery_voltage",
+    "engine_temp_c", "fuel_level_pct", "gps_lat", "gps_lon", "ambient_temp_c",
+    "humidity_pct", "wheel_fl", "wheel_fr", "wheel_rl", "wheel_rr",
+    "cpu_usage_pct", "ram_usage_pct", "network_latency_ms", "gear",
+    "ABS_active", "traction_control"
+};
+
+static TelemetryDeadbandRule g_rules[TELEMETRY_FIELD_COUNT] = {
+    {0.5f, KEEPALIVE},           // speed_kph
+    {50.0f, KEEPALIVE},          // rpm
+    {1.0f, KEEPALIVE},           // throttle_pct
+    {1.0f, KEEPALIVE},           // brake_pct
+    {0.05f, KEEPALIVE},          // battery_voltage
+    {0.5f, KEEPALIVE},           // engine_temp_c
+    {0.2f, KEEPALIVE},           // fuel_level_pct
+    {0.00001f, KEEPALIVE},       // gps_lat (~1 m)
+    {0.00001f, KEEPALIVE},       // gps_lon
+    {0.2f, KEEPALIVE},           // ambient_temp_c
+    {0.5f, KEEPALIVE},           // humidity_pct
+    {0.5f, KEEPALIVE},           // wheel_fl
+    {0.5f, KEEPALIVE},           // wheel_fr
+    {0.5f, KEEPALIVE},           // wheel_rl
+    {0.5f, KEEPALIVE},           // wheel_rr
+    {2.0f, KEEPALIVE},           // cpu_usage_pct
+    {1.0f, KEEPALIVE},           // ram_usage_pct
+    {5.0f, KEEPALIVE},           // network_latency_ms
+    {0.0f, KEEPALIVE},           // gear
+    {0.0f, KEEPALIVE},           // ABS_active
+    {0.0f, KEEPALIVE},           // traction_control
+};
+
+static const size_t g_float_offsets[TELEMETRY_FIELD_FLOATS] = {
+    offsetof(MMITTelemetryPacket, speed_kph),
+    offsetof(MMITTelemetryPacket, rpm),
+    offsetof(MMITTelemetryPacket, throttle_pct),
+    offsetof(MMITTelemetryPacket, brake_pct),
+    offsetof(MMITTelemetryPacket, battery_voltage),
+    offsetof(MMITTelemetryPacket, engine_temp_c),
+    offsetof(MMITTelemetryPacket, fuel_level_pct),
+    offsetof(MMITTelemetryPacket, gps_lat),
+    offsetof(MMITTelemetryPacket, gps_lon),
+    offsetof(MMITTelemetryPacket, ambient_temp_c),
+    offsetof(MMITTelemetryPacket, humidity_pct),
+    offsetof(MMITTelemetryPacket, wheel_fl),
+    offsetof(MMITTelemetryPacket, wheel_fr),
+    offsetof(MMITTelemetryPacket, wheel_rl),
+    offsetof(MMITTelemetryPacket, wheel_rr),
+    offsetof(MMITTelemetryPacket, cpu_usage_pct),
+    offsetof(MMITTelemetryPacket, ram_usage_pct),
+    offsetof(MMITTelemetryPacket, network_latency_ms),
+};
+
+/* ============================================================================
+ * FIELD ACCESS
+ * ============================================================================ */
+
+float telemetry_field_value(const MMITTelemetryPacket* packet, TelemetryField field) {
+    if (field < TELEMETRY_FIELD_FLOATS) {
+        float value;
+        memcpy(&value, (const uint8_t*)packet + g_float_offsets[field], sizeof(value));
+        return value;
+    }
+    switch (field) {
+        case TELEMETRY_FIELD_GEAR: return (float)packet->gear;
+        case TELEMETRY_FIELD_ABS: return packet->abs_active ? 1.0f : 0.0f;
+        case TELEMETRY_FIELD_TC: return packet->traction_control ? 1.0f : 0.0f;
+        default: return 0.0f;
+    }
+}
+
+const char* telemetry_field_name(TelemetryField field) {
+    return field < TELEMETRY_FIELD_COUNT ? g_field_names[field] : "unknown";
+}
+
+void telemetry_deadband_set_rule(TelemetryField field, float threshold, uint32_t keepalive_ms) {
+    if (field >= TELEMETRY_FIELD_COUNT) return;
+    g_rules[field].threshold = threshold;
+    g_rules[field].keepalive_ms = keepalive_ms;
+}
+
+TelemetryDeadbandRule telemetry_deadband_get_rule(TelemetryField field) {
+    TelemetryDeadbandRule none = {0.0f, 0};
+    return field < TELEMETRY_FIELD_COUNT ? g_rules[field] : none;
+}
+
+/* ============================================================================
+ * FILTER
+ * ============================================================================ */
+
+void telemetry_deadband_init(TelemetryDeadband* db) {
+    memset(db, 0, sizeof(TelemetryDeadband));
+}
+
+// Slot for a vehicle, taking over the least recently seen one if needed
+static DeadbandVehicle* find_vehicle(TelemetryDeadband* db, const char* vehicle_id, uint64_t now_ns) {
+    DeadbandVehicle* victim = &db->vehicles[0];
+    for (int i = 0; i < TELEMETRY_DEADBAND_VEHICLES; i++) {
+        DeadbandVehicle* v = &db->vehicles[i];
+        if (v->vehicle_id[0] != '\0' &&
+            strncmp(v->vehicle_id, vehicle_id, sizeof(v->vehicle_id)) == 0) {
+            v->last_seen_ns = now_ns;
+            return v;
+        }
+        if (v->last_seen_ns < victim->last_seen_ns) victim = v;
+    }
+
+    memset(victim, 0, sizeof(DeadbandVehicle));
+    snprintf(victim->vehicle_id, sizeof(victim->vehicle_id), "%s", vehicle_id);
+    victim->last_seen_ns = now_ns;
+    return victim;
+}
+
+uint32_t telemetry_deadband_filter(TelemetryDeadband* db, const MMITTelemetryPacket* packet) {
+    uint64_t now_ns = packet->timestamp_ns ? packet->timestamp_ns : telemetry_now_ns();
+    DeadbandVehicle* v = find_vehicle(db, packet->vehicle_id, now_ns);
+
+    uint32_t mask = 0;
+    for (int f = 0; f < TELEMETRY_FIELD_COUNT; f++) {
+        float value = telemetry_field_value(packet, (TelemetryField)f);
+        uint64_t keepalive_ns = (uint64_t)g_rules[f].keepalive_ms * 1000000ULL;
+        // Written so a NaN on either side counts as a change
+        bool moved = !(fabsf(value - v->last_value[f]) <= g_rules[f].threshold);
+        if (!v->primed || moved || now_ns - v->last_sent_ns[f] >= keepalive_ns) {
+            mask |= 1u << f;
+            v->last_value[f] = value;
+            v->last_sent_ns[f] = now_ns;
+        }
+    }
+    v->primed = true;
+
+    db->fields_offered += TELEMETRY_FIELD_COUNT;
+    db->fields_sent += (uint64_t)__builtin_popcount(mask);
+    if (mask == 0) db->packets_suppressed++;
+    return mask;
+}
+
+void telemetry_deadband_reset(TelemetryDeadband* db, const char* vehicle_id) {
+    for (int i = 0; i < TELEMETRY_DEADBAND_VEHICLES; i++) {
+        DeadbandVehicle* v = &db->vehicles[i];
+        if (!vehicle_id || strncmp(v->vehicle_id, vehicle_id, sizeof(v->vehicle_id)) == 0) {
+            v->primed = false;
+        }
+    }
+}
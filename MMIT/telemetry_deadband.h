@@ -0,0 +1,90 @@
+/*
+ * BlackBox DPU - Telemetry Deadband Filter
+ * Send-on-change per field: a value goes out only when it has moved past
+ * its threshold since it was last sent, or its keepalive interval expired
+ */
+
+#ifndef TELEMETRY_DEADBAND_H
+#define TELEMETRY_DEADBAND_H
+
+#include "telemetry_sender.h"
+
+// Packet fields; the first TELEMETRY_FIELD_FLOATS follow the wire format's
+// float order (telemetry_wire.h)
+typedef enum {
+    TELEMETRY_FIELD_SPEED,
+    TELEMETRY_FIELD_RPM,
+    TELEMETRY_FIELD_THROTTLE,
+    TELEMETRY_FIELD_BRAKE,
+    TELEMETRY_FIELD_BATTERY,
+    TELEMETRY_FIELD_ENGINE_TEMP,
+    TELEMETRY_FIELD_FUEL,
+    TELEMETRY_FIELD_GPS_LAT,
+    TELEMETRY_FIELD_GPS_LON,
+    TELEMETRY_FIELD_AMBIENT_TEMP,
+    TELEMETRY_FIELD_HUMIDITY,
+    TELEMETRY_FIELD_WHEEL_FL,
+    TELEMETRY_FIELD_WHEEL_FR,
+    TELEMETRY_FIELD_WHEEL_RL,
+    TELEMETRY_FIELD_WHEEL_RR,
+    TELEMETRY_FIELD_CPU,
+    TELEMETRY_FIELD_RAM,
+    TELEMETRY_FIELD_LATENCY,
+    TELEMETRY_FIELD_GEAR,
+    TELEMETRY_FIELD_ABS,
+    TELEMETRY_FIELD_TC,
+    TELEMETRY_FIELD_COUNT
+} TelemetryField;
+
+#define TELEMETRY_FIELD_FLOATS      18
+#define TELEMETRY_FIELDS_ALL        ((1u << TELEMETRY_FIELD_COUNT) - 1)
+
+// Vehicles tracked at once; the least recently seen one is evicted (its
+// next packet then goes out in full)
+#define TELEMETRY_DEADBAND_VEHICLES 8
+
+typedef struct {
+    float threshold;             // Send when |value - last sent| exceeds this
+    uint32_t keepalive_ms;       // Resend at least this often regardless
+} TelemetryDeadbandRule;
+
+typedef struct {
+    char vehicle_id[32];
+    bool primed;                 // last_* hold values the backend has
+    uint64_t last_seen_ns;
+    float last_value[TELEMETRY_FIELD_COUNT];
+    uint64_t last_sent_ns[TELEMETRY_FIELD_COUNT];
+} DeadbandVehicle;
+
+typedef struct {
+    DeadbandVehicle vehicles[TELEMETRY_DEADBAND_VEHICLES];
+    uint64_t fields_offered;
+    uint64_t fields_sent;
+    uint64_t packets_suppressed; // Nothing changed and no keepalive due
+} TelemetryDeadband;
+
+/* ============================================================================
+ * DEADBAND FUNCTIONS
+ * ============================================================================ */
+
+// Field rules are process-wide; defaults come from the table in
+// telemetry_deadband.c and TELEMETRY_DEADBAND_KEEPALIVE_MS
+void telemetry_deadband_set_rule(TelemetryField field, float threshold, uint32_t keepalive_ms);
+TelemetryDeadbandRule telemetry_deadband_get_rule(TelemetryField field);
+
+void telemetry_deadband_init(TelemetryDeadband* db);
+
+// Decide which fields of packet to send and record them as sent. Returns a
+// bitmask of TelemetryField bits: TELEMETRY_FIELDS_ALL for the first packet
+// of a vehicle, 0 when nothing needs sending.
+uint32_t telemetry_deadband_filter(TelemetryDeadband* db, const MMITTelemetryPacket* packet);
+
+// Forget what the backend has for a vehicle (NULL = all) so its next packet
+// is sent in full. Call after a failed delivery or a backend reconnect.
+void telemetry_deadband_reset(TelemetryDeadband* db, const char* vehicle_id);
+
+// Field accessors shared by the delta encoders
+float telemetry_field_value(const MMITTelemetryPacket* packet, TelemetryField field);
+const char* telemetry_field_name(TelemetryField field);
+
+#endif // TELEMETRY_DEADBAND_H
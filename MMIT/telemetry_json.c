@@ -0,0 +1,374 @@
+/*
+ * BlackBox DPU - Telemetry JSON Serializer Implementation
+ * Fixed-precision float formatting written straight into the output buffer.
+ *
+ * A float widened to double and scaled by 10^2 or 10^6 is exact (24 + 20
+ * mantissa bits fit in 53), so rounding it with rint() (ties-to-even)
+ * reproduces printf's correctly rounded "%.Nf" digit for digit.
+ */
+
+#include "telemetry_json.h"
+#include "telemetry_deadband.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Appends a string literal and advances the cursor
+#define PUT_LIT(p, s)   (memcpy((p), (s), sizeof(s) - 1), (p) += sizeof(s) - 1)
+
+// Worst case: every float takes the snprintf fallback at FLT_MAX width
+#define FLOAT_FIELD_MAX 64
+
+static const char g_digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const double g_pow10[] = {1.0, 10.0, 100.0, 1e3, 1e4, 1e5, 1e6};
+
+/* ============================================================================
+ * NUMBER FORMATTING
+ * ============================================================================ */
+
+// Unsigned decimal, no padding
+static char* put_u64(char* p, uint64_t v) {
+    char tmp[20];
+    char* t = tmp + sizeof(tmp);
+    while (v >= 100) {
+        uint32_t pair = (uint32_t)(v % 100) * 2;
+        v /= 100;
+        *--t = g_digit_pairs[pair + 1];
+        *--t = g_digit_pairs[pair];
+    }
+    if (v >= 10) {
+        *--t = g_digit_pairs[v * 2 + 1];
+        *--t = g_digit_pairs[v * 2];
+    } else {
+        *--t = (char)('0' + v);
+    }
+    size_t n = (size_t)(tmp + sizeof(tmp) - t);
+    memcpy(p, t, n);
+    return p + n;
+}
+
+// Exactly `width` digits, zero padded
+static char* put_u32_fixed(char* p, uint32_t v, int width) {
+    for (int i = width - 1; i >= 0; i--) {
+        p[i] = (char)('0' + v % 10);
+        v /= 10;
+    }
+    return p + width;
+}
+
+static char* put_int(char* p, int v) {
+    if (v < 0) {
+        *p++ = '-';
+        return put_u64(p, (uint64_t)0 - (uint64_t)(int64_t)v);
+    }
+    return put_u64(p, (uint64_t)v);
+}
+
+// Equivalent of "%.<precision>f" for a float argument (precision 0..6)
+static char* put_fixed(char* p, float value, int precision) {
+    double d = (double)value;
+    double scaled = fabs(d) * g_pow10[precision];
+
+    // NaN/inf and values beyond 2^53 go through printf
+    if (!(scaled < 9007199254740992.0)) {
+        int n = snprintf(p, FLOAT_FIELD_MAX, "%.*f", precision, d);
+        return p + (n > 0 ? n : 0);
+    }
+
+    uint64_t units = (uint64_t)rint(scaled);
+    uint64_t divisor = (uint64_t)g_pow10[precision];
+    if (signbit(d)) *p++ = '-';
+    p = put_u64(p, units / divisor);
+    if (precision > 0) {
+        *p++ = '.';
+        p = put_u32_fixed(p, (uint32_t)(units % divisor), precision);
+    }
+    return p;
+}
+
+/* ============================================================================
+ * TIMESTAMP FORMATTING
+ * ============================================================================ */
+
+// "YYYY-MM-DDTHH:MM:SS" in UTC, as strftime() would print gmtime() output
+static char* put_iso8601(char* p, time_t t) {
+    int64_t secs = (int64_t)t;
+    int64_t days = secs / 86400;
+    int64_t rem = secs % 86400;
+    if (rem < 0) {
+        rem += 86400;
+        days--;
+    }
+
+    // Civil date from days since 1970-01-01 (proleptic Gregorian)
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    uint32_t doe = (uint32_t)(days - era * 146097);
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t year = (int64_t)yoe + era * 400;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    uint32_t day = doy - (153 * mp + 2) / 5 + 1;
+    uint32_t month = mp < 10 ? mp + 3 : mp - 9;
+    if (month <= 2) year++;
+
+    if (year < 0 || year > 9999) {
+        struct tm* tm_info = gmtime(&t);
+        return p + strftime(p, 64, "%Y-%m-%dT%H:%M:%S", tm_info);
+    }
+
+    p = put_u32_fixed(p, (uint32_t)year, 4);
+    *p++ = '-';
+    p = put_u32_fixed(p, month, 2);
+    *p++ = '-';
+    p = put_u32_fixed(p, day, 2);
+    *p++ = 'T';
+    p = put_u32_fixed(p, (uint32_t)(rem / 3600), 2);
+    *p++ = ':';
+    p = put_u32_fixed(p, (uint32_t)(rem / 60 % 60), 2);
+    *p++ = ':';
+    p = put_u32_fixed(p, (uint32_t)(rem % 60), 2);
+    return p;
+}
+
+static char* put_timestamp(char* p, const MMITTelemetryPacket* packet) {
+    if (packet->timestamp_ns == 0) {
+        return put_iso8601(p, time(NULL));
+    }
+    p = put_iso8601(p, (time_t)(packet->timestamp_ns / 1000000000ULL));
+    *p++ = '.';
+    return put_u32_fixed(p, (uint32_t)(packet->timestamp_ns / 1000000ULL % 1000ULL), 3);
+}
+
+/* ============================================================================
+ * PACKET SERIALIZATION
+ * ============================================================================ */
+
+// Writes the packet without bounds checks; out must hold TELEMETRY_JSON_MAX
+static size_t write_unchecked(char* out, const MMITTelemetryPacket* packet) {
+    char* p = out;
+    char ts[40];
+    size_t ts_len = (size_t)(put_timestamp(ts, packet) - ts);
+
+    PUT_LIT(p, "{\"vehicle_id\":\"");
+    size_t id_len = strnlen(packet->vehicle_id, sizeof(packet->vehicle_id));
+    memcpy(p, packet->vehicle_id, id_len);
+    p += id_len;
+    PUT_LIT(p, "\",\"timestamp\":\"");
+    memcpy(p, ts, ts_len);
+    p += ts_len;
+
+    PUT_LIT(p, "Z\",\"telemetry\":{\"speed_kph\":");
+    p = put_fixed(p, packet->speed_kph, 2);
+    PUT_LIT(p, ",\"rpm\":");
+    p = put_fixed(p, packet->rpm, 2);
+    PUT_LIT(p, ",\"throttle_pct\":");
+    p = put_fixed(p, packet->throttle_pct, 2);
+    PUT_LIT(p, ",\"brake_pct\":");
+    p = put_fixed(p, packet->brake_pct, 2);
+    PUT_LIT(p, ",\"gear\":");
+    p = put_int(p, packet->gear);
+    PUT_LIT(p, ",\"battery_voltage\":");
+    p = put_fixed(p, packet->battery_voltage, 2);
+    PUT_LIT(p, ",\"engine_temp_c\":");
+    p = put_fixed(p, packet->engine_temp_c, 2);
+    PUT_LIT(p, ",\"fuel_level_pct\":");
+    p = put_fixed(p, packet->fuel_level_pct, 2);
+    PUT_LIT(p, ",\"gps\":{\"lat\":");
+    p = put_fixed(p, packet->gps_lat, 6);
+    PUT_LIT(p, ",\"lon\":");
+    p = put_fixed(p, packet->gps_lon, 6);
+    PUT_LIT(p, "},\"ambient_temp_c\":");
+    p = put_fixed(p, packet->ambient_temp_c, 2);
+    PUT_LIT(p, ",\"humidity_pct\":");
+    p = put_fixed(p, packet->humidity_pct, 2);
+    PUT_LIT(p, ",\"wheel_speed\":{\"front_left\":");
+    p = put_fixed(p, packet->wheel_fl, 2);
+    PUT_LIT(p, ",\"front_right\":");
+    p = put_fixed(p, packet->wheel_fr, 2);
+    PUT_LIT(p, ",\"rear_left\":");
+    p = put_fixed(p, packet->wheel_rl, 2);
+    PUT_LIT(p, ",\"rear_right\":");
+    p = put_fixed(p, packet->wheel_rr, 2);
+
+    PUT_LIT(p, "}},\"system\":{\"cpu_usage_pct\":");
+    p = put_fixed(p, packet->cpu_usage_pct, 2);
+    PUT_LIT(p, ",\"ram_usage_pct\":");
+    p = put_fixed(p, packet->ram_usage_pct, 2);
+    PUT_LIT(p, ",\"network_latency_ms\":");
+    p = put_fixed(p, packet->network_latency_ms, 2);
+    PUT_LIT(p, ",\"last_sync\":\"");
+    memcpy(p, ts, ts_len);
+    p += ts_len;
+
+    PUT_LIT(p, "Z\"},\"status\":{\"ABS_active\":");
+    if (packet->abs_active) PUT_LIT(p, "true");
+    else PUT_LIT(p, "false");
+    PUT_LIT(p, ",\"traction_control\":");
+    if (packet->traction_control) PUT_LIT(p, "true");
+    else PUT_LIT(p, "false");
+    PUT_LIT(p, ",\"DTC\":[]}}");
+
+    *p = '\0';
+    return (size_t)(p - out);
+}
+
+size_t telemetry_json_write(char* buf, size_t cap, const MMITTelemetryPacket* packet) {
+    if (cap >= TELEMETRY_JSON_MAX) {
+        return write_unchecked(buf, packet);
+    }
+
+    // Small destination: stage on the stack, copy only if it fits
+    char staging[TELEMETRY_JSON_MAX];
+    size_t len = write_unchecked(staging, packet);
+    if (len >= cap) return 0;
+    memcpy(buf, staging, len + 1);
+    return len;
+}
+
+static size_t write_delta_unchecked(char* out, const MMITTelemetryPacket* packet, uint32_t mask) {
+    char* p = out;
+    PUT_LIT(p, "{\"vehicle_id\":\"");
+    size_t id_len = strnlen(packet->vehicle_id, sizeof(packet->vehicle_id));
+    memcpy(p, packet->vehicle_id, id_len);
+    p += id_len;
+    PUT_LIT(p, "\",\"timestamp\":\"");
+    p = put_timestamp(p, packet);
+    PUT_LIT(p, "Z\",\"delta\":{");
+
+    bool first = true;
+    for (int f = 0; f < TELEMETRY_FIELD_COUNT; f++) {
+        if (!(mask & (1u << f))) continue;
+        if (!first) *p++ = ',';
+        first = false;
+
+        const char* name = telemetry_field_name((TelemetryField)f);
+        size_t name_len = strlen(name);
+        *p++ = '"';
+        memcpy(p, name, name_len);
+        p += name_len;
+        *p++ = '"';
+        *p++ = ':';
+
+        if (f == TELEMETRY_FIELD_GEAR) {
+            p = put_int(p, packet->gear);
+        } else if (f == TELEMETRY_FIELD_ABS || f == TELEMETRY_FIELD_TC) {
+            bool on = f == TELEMETRY_FIELD_ABS ? packet->abs_active : packet->traction_control;
+            if (on) PUT_LIT(p, "true");
+            else PUT_LIT(p, "false");
+        } else {
+            int precision = (f == TELEMETRY_FIELD_GPS_LAT || f == TELEMETRY_FIELD_GPS_LON) ? 6 : 2;
+            p = put_fixed(p, telemetry_field_value(packet, (TelemetryField)f), precision);
+        }
+    }
+    PUT_LIT(p, "}}");
+
+    *p = '\0';
+    return (size_t)(p - out);
+}
+
+size_t telemetry_json_write_delta(char* buf, size_t cap, const MMITTelemetryPacket* packet,
+                                  uint32_t mask) {
+    if (cap >= TELEMETRY_JSON_MAX) {
+        return write_delta_unchecked(buf, packet, mask);
+    }
+
+    char staging[TELEMETRY_JSON_MAX];
+    size_t len = write_delta_unchecked(staging, packet, mask);
+    if (len >= cap) return 0;
+    memcpy(buf, staging, len + 1);
+    return len;
+}
+
+/* ============================================================================
+ * REFERENCE FORMATTER
+ * ============================================================================ */
+
+size_t telemetry_json_write_reference(char* buf, size_t cap, const MMITTelemetryPacket* packet) {
+    // Capture time in ISO format (stamp now if the producer left it unset)
+    time_t now = packet->timestamp_ns ? (time_t)(packet->timestamp_ns / 1000000000ULL)
+                                      : time(NULL);
+    struct tm* tm_info = gmtime(&now);
+    char timestamp[64];
+    size_t ts_len = strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", tm_info);
+    if (packet->timestamp_ns) {
+        // Millisecond resolution keeps batched samples distinguishable
+        snprintf(timestamp + ts_len, sizeof(timestamp) - ts_len, ".%03u",
+                 (unsigned)(packet->timestamp_ns / 1000000ULL % 1000ULL));
+    }
+
+    int written = snprintf(buf, cap,
+        "{"
+        "\"vehicle_id\":\"%s\","
+        "\"timestamp\":\"%sZ\","
+        "\"telemetry\":{"
+            "\"speed_kph\":%.2f,"
+            "\"rpm\":%.2f,"
+            "\"throttle_pct\":%.2f,"
+            "\"brake_pct\":%.2f,"
+            "\"gear\":%d,"
+            "\"battery_voltage\":%.2f,"
+            "\"engine_temp_c\":%.2f,"
+            "\"fuel_level_pct\":%.2f,"
+            "\"gps\":{\"lat\":%.6f,\"lon\":%.6f},"
+            "\"ambient_temp_c\":%.2f,"
+            "\"humidity_pct\":%.2f,"
+            "\"wheel_speed\":{"
+                "\"front_left\":%.2f,"
+                "\"front_right\":%.2f,"
+                "\"rear_left\":%.2f,"
+                "\"rear_right\":%.2f"
+            "}"
+        "},"
+        "\"system\":{"
+            "\"cpu_usage_pct\":%.2f,"
+            "\"ram_usage_pct\":%.2f,"
+            "\"network_latency_ms\":%.2f,"
+            "\"last_sync\":\"%sZ\""
+        "},"
+        "\"status\":{"
+            "\"ABS_active\":%s,"
+            "\"traction_control\":%s,"
+            "\"DTC\":[]"
+        "}"
+        "}",
+        packet->vehicle_id,
+        timestamp,
+        packet->speed_kph,
+        packet->rpm,
+        packet->throttle_pct,
+        packet->brake_pct,
+        packet->gear,
+        packet->battery_voltage,
+        packet->engine_temp_c,
+        packet->fuel_level_pct,
+        packet->gps_lat,
+        packet->gps_lon,
+        packet->ambient_temp_c,
+        packet->humidity_pct,
+        packet->wheel_fl,
+        packet->wheel_fr,
+        packet->wheel_rl,
+        packet->wheel_rr,
+        packet->cpu_usage_pct,
+        packet->ram_usage_pct,
+        packet->network_latency_ms,
+        timestamp,
+        packet->abs_active ? "true" : "false",
+        packet->traction_control ? "true" : "false"
+    );
+    if (written < 0 || (size_t)written >= cap) return 0;
+    return (size_t)written;
+}
@@ -0,0 +1,31 @@
+/*
+ * BlackBox DPU - Telemetry JSON Serializer
+ * Formats MMITTelemetryPacket without snprintf or heap allocation
+ */
+
+#ifndef TELEMETRY_JSON_H
+#define TELEMETRY_JSON_H
+
+#include "telemetry_sender.h"
+#include <stddef.h>
+
+/* ============================================================================
+ * JSON SERIALIZATION
+ * ============================================================================ */
+
+// Serialize one packet as a JSON object matching the backend MMIT model,
+// directly into buf (NUL-terminated). Returns the length excluding the NUL,
+// or 0 if it did not fit. Output is byte-identical to the snprintf reference.
+size_t telemetry_json_write(char* buf, size_t cap, const MMITTelemetryPacket* packet);
+
+// Serialize only the fields set in mask (TelemetryField bits) as a delta:
+// {"vehicle_id":..,"timestamp":..,"delta":{"speed_kph":..,...}}, using the
+// same number formatting as the full packet. Returns 0 if it did not fit.
+size_t telemetry_json_write_delta(char* buf, size_t cap, const MMITTelemetryPacket* packet,
+                                  uint32_t mask);
+
+// Original snprintf-based formatter, kept as the correctness oracle and
+// benchmark baseline
+size_t telemetry_json_write_reference(char* buf, size_t cap, const MMITTelemetryPacket* packet);
+
+#endif // TELEMETRY_JSON_H
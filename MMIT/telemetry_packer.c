@@ -0,0 +1,75 @@
+/*
+ * BlackBox DPU - Telemetry Packer Implementation
+ */
+
+#include "telemetry_packer.h"
+#include "telemetry_wire.h"
+#include "soc_core.h"
+
+bool telemetry_packer_init(TelemetryPacker* packer, BlackBoxSoC* soc, uint32_t block_bytes) {
+    memset(packer, 0, sizeof(TelemetryPacker));
+    if (block_bytes == 0) block_bytes = TELEMETRY_PACKER_BLOCK_BYTES;
+    if (block_bytes > BLACKBOX_LOG_BLOCK_MAX) block_bytes = BLACKBOX_LOG_BLOCK_MAX;
+    if (block_bytes < TELEMETRY_WIRE_MAX) block_bytes = TELEMETRY_WIRE_MAX;
+
+    packer->buf = (uint8_t*)malloc(block_bytes);
+    if (!packer->buf) return false;
+    packer->soc = soc;
+    packer->cap = block_bytes;
+    packer->max_span_ns = (uint64_t)TELEMETRY_PACKER_MAX_SPAN_MS * 1000000ULL;
+    return true;
+}
+
+void telemetry_packer_close(TelemetryPacker* packer) {
+    if (!packer->buf) return;
+    telemetry_packer_flush(packer);
+    free(packer->buf);
+    packer->buf = NULL;
+}
+
+static void telemetry_packer_write_block(TelemetryPacker* packer) {
+    if (packer->len == 0) return;
+
+    uint32_t compressed = 0;
+    if (blackbox_log_block(packer->soc, packer->buf, packer->len,
+                           packer->block_first_ns, packer->block_last_ns, &compressed)) {
+        packer->blocks++;
+        packer->bytes_raw += packer->len;
+        packer->bytes_compressed += compressed;
+    } else {
+        packer->packets_dropped += packer->block_packets;
+    }
+    packer->len = 0;
+    packer->block_packets = 0;
+}
+
+void telemetry_packer_flush(TelemetryPacker* packer) {
+    uint64_t start = monotonic_ns();
+    telemetry_packer_write_block(packer);
+    packer->busy_ns += monotonic_ns() - start;
+}
+
+void telemetry_packer_append(TelemetryPacker* packer, const MMITTelemetryPacket* packet) {
+    uint64_t start = monotonic_ns();
+
+    // Close the block on size or on capture span (a clock step backwards
+    // also starts a new block, so every index entry stays ordered)
+    if (packer->block_packets > 0 &&
+        (packer->cap - packer->len < TELEMETRY_WIRE_MAX ||
+         packet->timestamp_ns < packer->block_last_ns ||
+         packet->timestamp_ns - packer->block_first_ns >= packer->max_span_ns)) {
+        telemetry_packer_write_block(packer);
+    }
+
+    size_t n = telemetry_wire_encode(packer->buf + packer->len, packer->cap - packer->len, packet);
+    if (n > 0) {
+        if (packer->block_packets == 0) packer->block_first_ns = packet->timestamp_ns;
+        packer->block_last_ns = packet->timestamp_ns;
+        packer->block_packets++;
+        packer->len += (uint32_t)n;
+        packer->packets++;
+    } else {
+        packer->packets_dropped++;
+    }
+    packer->busy_ns += monotonic_ns() - start;
+}
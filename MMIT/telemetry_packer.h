@@ -0,0 +1,59 @@
+/*
+ * BlackBox DPU - Telemetry Packer
+ * Records streamed telemetry locally: packets are appended as wire records
+ * to an ingest buffer that is flushed block by block through the
+ * Zstd -> DMA -> NVMe logging pipeline
+ */
+
+#ifndef TELEMETRY_PACKER_H
+#define TELEMETRY_PACKER_H
+
+#include "blackbox_common.h"
+#include "telemetry_sender.h"
+
+// A block is flushed once it reaches this size...
+#define TELEMETRY_PACKER_BLOCK_BYTES    (64 * 1024)
+// ...or spans this much capture time, so slow streams still land on disk
+#define TELEMETRY_PACKER_MAX_SPAN_MS    10000
+
+// Records are telemetry_wire.h full records back to back, so the log reads
+// back with log_replay.h. Each block's index entry covers the capture
+// timestamps of its first and last packet.
+typedef struct {
+    BlackBoxSoC* soc;
+    uint8_t* buf;
+    uint32_t cap;
+    uint32_t len;
+    uint64_t max_span_ns;
+
+    uint32_t block_packets;
+    uint64_t block_first_ns;
+    uint64_t block_last_ns;
+
+    uint64_t packets;            // Appended
+    uint64_t packets_dropped;    // Lost with a block the pipeline refused
+    uint64_t blocks;             // Written and indexed
+    uint64_t bytes_raw;
+    uint64_t bytes_compressed;
+    uint64_t busy_ns;            // Time spent appending and flushing
+} TelemetryPacker;
+
+/* ============================================================================
+ * TELEMETRY PACKER FUNCTIONS
+ * ============================================================================ */
+
+// block_bytes = 0 picks TELEMETRY_PACKER_BLOCK_BYTES (clamped to what the
+// pipeline accepts)
+bool telemetry_packer_init(TelemetryPacker* packer, BlackBoxSoC* soc, uint32_t block_bytes);
+
+// Flushes the partial block, then releases the buffer
+void telemetry_packer_close(TelemetryPacker* packer);
+
+// Append one packet, flushing first if it does not fit or the block's
+// capture span is up
+void telemetry_packer_append(TelemetryPacker* packer, const MMITTelemetryPacket* packet);
+
+// Write out the partial block, if any
+void telemetry_packer_flush(TelemetryPacker* packer);
+
+#endif // TELEMETRY_PACKER_H
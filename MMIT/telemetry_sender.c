@@ -1,185 +1,639 @@
 /*
  * BlackBox DPU - Telemetry Sender Implementation
- * Sends formatted JSON telemetry to FastAPI backend
+ * Sends JSON or binary telemetry to FastAPI backend
  */
 
 #include "telemetry_sender.h"
+#include "http_transport.h"
+#include "telemetry_json.h"
+#include "telemetry_wire.h"
+#include "telemetry_spool.h"
+#include "telemetry_deadband.h"
+#include "ws_client.h"
+#include "network_config.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 #ifdef __unix__
-#include <curl/curl.h>
-#else
-// Stub for Windows
+#include <pthread.h>
+#include <stdatomic.h>
 #endif
 
 static char g_backend_url[256] = {0};
 static int g_backend_port = 8000;
 static bool g_sender_initialized = false;
+static TelemetrySenderStats g_stats;
+static TelemetryFormat g_format = TELEMETRY_FORMAT_JSON;
+static TelemetryTransport g_transport = TELEMETRY_TRANSPORT_HTTP;
 
-bool telemetry_sender_init(const char* backend_url, int backend_port) {
+// Send-on-change: per-field deadband state for the vehicles being sent
+static TelemetryDeadband g_deadband;
+static bool g_deadband_enabled = TELEMETRY_DEADBAND_DEFAULT;
+
+// WebSocket transport: one long-lived connection, one frame per packet
+static WsClient g_ws;
+static bool g_ws_ready = false;
+
+// Batch accumulator: packets are serialized straight into the request body
+static bool g_batching = false;
+static uint32_t g_batch_max_packets = 0;
+static uint32_t g_batch_max_latency_ms = 0;
+static char* g_batch_buf = NULL;
+static size_t g_batch_cap = 0;
+static size_t g_batch_len = 0;
+static uint32_t g_batch_count = 0;
+static char g_batch_vehicle[32];
+static uint64_t g_batch_opened_ns = 0;
+static MMITTelemetryPacket* g_batch_packets = NULL;   // Kept for spooling on failure
+
+// Offline spool: failed packets go to disk and are replayed in batches
+static TelemetrySpool g_spool;
+static bool g_spool_enabled = false;
+static uint64_t g_spool_retry_ns = 0;
+static MMITTelemetryPacket* g_replay_packets = NULL;
+static char* g_replay_buf = NULL;
+static size_t g_replay_cap = 0;
+
+// Async mode: producer -> ring -> sender thread
+static SpscRing g_queue;
+static bool g_queue_valid = false;
+static bool g_async_running = false;
 #ifdef __unix__
-    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
-        fprintf(stderr, "Telemetry Sender: Failed to initialize libcurl\n");
+static pthread_t g_sender_thread;
+static atomic_bool g_async_stop;
+#endif
+
+uint64_t telemetry_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+bool telemetry_sender_init(const char* backend_url, int backend_port) {
+    // Shares the process-wide transport (and its connections) with the
+    // cloud uploader
+    if (!http_transport_init()) {
+        fprintf(stderr, "Telemetry Sender: Failed to initialize HTTP transport\n");
         return false;
     }
-#endif
     
     snprintf(g_backend_url, sizeof(g_backend_url), "%s", backend_url);
     g_backend_port = backend_port;
     g_sender_initialized = true;
+    memset(&g_stats, 0, sizeof(g_stats));
+    telemetry_deadband_init(&g_deadband);
+    telemetry_sender_set_transport(TELEMETRY_DEFAULT_TRANSPORT);
     
     printf("Telemetry Sender: Initialized (backend: %s:%d)\n", backend_url, backend_port);
     return true;
 }
 
 void telemetry_sender_cleanup(void) {
-#ifdef __unix__
     if (g_sender_initialized) {
-        curl_global_cleanup();
+        telemetry_sender_stop_async();
+        if (g_queue_valid) {
+            spsc_ring_free(&g_queue);
+            g_queue_valid = false;
+        }
+        telemetry_sender_flush();
+        free(g_batch_buf);
+        free(g_batch_packets);
+        g_batch_buf = NULL;
+        g_batch_packets = NULL;
+        g_batch_cap = 0;
+        g_batching = false;
+        if (g_spool_enabled) {
+            telemetry_spool_close(&g_spool);
+            free(g_replay_packets);
+            free(g_replay_buf);
+            g_replay_packets = NULL;
+            g_replay_buf = NULL;
+            g_spool_enabled = false;
+        }
+        if (g_ws_ready) {
+            ws_client_free(&g_ws);
+            g_ws_ready = false;
+        }
+        g_transport = TELEMETRY_TRANSPORT_HTTP;
+        http_transport_cleanup();
         g_sender_initialized = false;
     }
-#endif
 }
 
-bool telemetry_send_to_backend(const MMITTelemetryPacket* packet) {
-    if (!g_sender_initialized) {
-        fprintf(stderr, "Telemetry Sender: Not initialized\n");
-        return false;
-    }
+/* ============================================================================
+ * HTTP DELIVERY
+ * ============================================================================ */
 
-#ifdef __unix__
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        fprintf(stderr, "Telemetry Sender: Failed to create CURL handle\n");
-        return false;
+// Serialize the given fields of a packet in the negotiated format; anything
+// short of TELEMETRY_FIELDS_ALL becomes a delta the backend merges
+static size_t telemetry_encode(char* buf, size_t cap, const MMITTelemetryPacket* packet,
+                               uint32_t fields) {
+    bool full = fields == TELEMETRY_FIELDS_ALL;
+    if (g_format == TELEMETRY_FORMAT_BINARY) {
+        return full ? telemetry_wire_encode((uint8_t*)buf, cap, packet)
+                    : telemetry_wire_encode_delta((uint8_t*)buf, cap, packet, fields);
     }
+    return full ? telemetry_json_write(buf, cap, packet)
+                : telemetry_json_write_delta(buf, cap, packet, fields);
+}
 
-    // Get current timestamp in ISO format
-    time_t now = time(NULL);
-    struct tm* tm_info = gmtime(&now);
-    char timestamp[64];
-    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S", tm_info);
-    
-    // Build JSON payload matching backend TelemetryData model
-    char json_payload[2048];
-    snprintf(json_payload, sizeof(json_payload),
-        "{"
-        "\"vehicle_id\":\"%s\","
-        "\"timestamp\":\"%sZ\","
-        "\"telemetry\":{"
-            "\"speed_kph\":%.2f,"
-            "\"rpm\":%.2f,"
-            "\"throttle_pct\":%.2f,"
-            "\"brake_pct\":%.2f,"
-            "\"gear\":%d,"
-            "\"battery_voltage\":%.2f,"
-            "\"engine_temp_c\":%.2f,"
-            "\"fuel_level_pct\":%.2f,"
-            "\"gps\":{\"lat\":%.6f,\"lon\":%.6f},"
-            "\"ambient_temp_c\":%.2f,"
-            "\"humidity_pct\":%.2f,"
-            "\"wheel_speed\":{"
-                "\"front_left\":%.2f,"
-                "\"front_right\":%.2f,"
-                "\"rear_left\":%.2f,"
-                "\"rear_right\":%.2f"
-            "}"
-        "},"
-        "\"system\":{"
-            "\"cpu_usage_pct\":%.2f,"
-            "\"ram_usage_pct\":%.2f,"
-            "\"network_latency_ms\":%.2f,"
-            "\"last_sync\":\"%sZ\""
-        "},"
-        "\"status\":{"
-            "\"ABS_active\":%s,"
-            "\"traction_control\":%s,"
-            "\"DTC\":[]"
-        "}"
-        "}",
-        packet->vehicle_id,
-        timestamp,
-        packet->speed_kph,
-        packet->rpm,
-        packet->throttle_pct,
-        packet->brake_pct,
-        packet->gear,
-        packet->battery_voltage,
-        packet->engine_temp_c,
-        packet->fuel_level_pct,
-        packet->gps_lat,
-        packet->gps_lon,
-        packet->ambient_temp_c,
-        packet->humidity_pct,
-        packet->wheel_fl,
-        packet->wheel_fr,
-        packet->wheel_rl,
-        packet->wheel_rr,
-        packet->cpu_usage_pct,
-        packet->ram_usage_pct,
-        packet->network_latency_ms,
-        timestamp,
-        packet->abs_active ? "true" : "false",
-        packet->traction_control ? "true" : "false"
-    );
+// Fields of packet the backend needs; all of them while deadband is off
+static uint32_t deadband_fields(const MMITTelemetryPacket* packet) {
+    if (!g_deadband_enabled) return TELEMETRY_FIELDS_ALL;
+    return telemetry_deadband_filter(&g_deadband, packet);
+}
+
+void telemetry_sender_set_deadband(bool enabled) {
+    telemetry_sender_flush();
+    g_deadband_enabled = enabled;
+    telemetry_deadband_reset(&g_deadband, NULL);
+}
 
+bool telemetry_sender_get_deadband(void) {
+    return g_deadband_enabled;
+}
+
+static bool telemetry_post(const char* vehicle_id, const char* route,
+                           const char* body, size_t body_len, long* status) {
     // Build full URL
     char url[512];
-    snprintf(url, sizeof(url), "http://%s:%d/api/v1/telemetry/%s/update",
-             g_backend_url, g_backend_port, packet->vehicle_id);
-
-    // Configure request
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_POST, 1L);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json_payload);
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, (long)strlen(json_payload));
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 5L);
-    
-    // Set content type header
-    struct curl_slist* headers = NULL;
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    snprintf(url, sizeof(url), "http://%s:%d/api/v1/telemetry/%s/%s",
+             g_backend_url, g_backend_port, vehicle_id, route);
+
+    HttpRequest req = {
+        .url = url,
+        .content_type = g_format == TELEMETRY_FORMAT_BINARY ? TELEMETRY_WIRE_CONTENT_TYPE
+                                                            : "application/json",
+        .body = body,
+        .body_len = body_len,
+        .timeout_sec = 5L,
+        .compress = true,
+    };
+
+    long response_code = 0;
+    bool success = http_transport_post(&req, &response_code);
+    g_stats.requests++;
+    g_stats.payload_bytes += body_len;
+    if (status) *status = response_code;
 
-    // Perform request
-    CURLcode res = curl_easy_perform(curl);
+    // 415: backend predates the binary format, JSON is always accepted
+    if (response_code == 415 && g_format == TELEMETRY_FORMAT_BINARY) {
+        fprintf(stderr, "Telemetry Sender: Backend rejected %s, falling back to JSON\n",
+                TELEMETRY_WIRE_CONTENT_TYPE);
+        g_format = TELEMETRY_FORMAT_JSON;
+        return false;
+    }
     
-    bool success = false;
     static int error_count = 0;
-    if (res == CURLE_OK) {
-        long response_code;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-        if (response_code == 200) {
-            success = true;
-            error_count = 0;  // Reset error count on success
+    if (success) {
+        error_count = 0;  // Reset error count on success
+    } else if (error_count < 3) {  // Only show first 3 errors
+        if (response_code != 0) {
+            fprintf(stderr, "Telemetry Sender: Server returned HTTP %ld\n", response_code);
         } else {
-            if (error_count < 3) {  // Only show first 3 errors
-                fprintf(stderr, "Telemetry Sender: Server returned HTTP %ld\n", response_code);
-                error_count++;
-            }
+            fprintf(stderr, "Telemetry Sender: Transfer failed - backend unreachable\n");
         }
-    } else {
-        if (error_count < 3) {  // Only show first 3 errors
-            fprintf(stderr, "Telemetry Sender: Transfer failed - %s\n", curl_easy_strerror(res));
-            error_count++;
-            if (error_count == 3) {
-                fprintf(stderr, "Telemetry Sender: Further errors will be suppressed\n");
-            }
+        error_count++;
+        if (error_count == 3) {
+            fprintf(stderr, "Telemetry Sender: Further errors will be suppressed\n");
         }
     }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
     return success;
-#else
-    // Windows stub - just log
-    printf("Telemetry Sender: [STUB] Would send telemetry for vehicle %s\n", packet->vehicle_id);
-    printf("  Speed: %.2f km/h, RPM: %.2f, Gear: %d\n", 
-           packet->speed_kph, packet->rpm, packet->gear);
+}
+
+/* ============================================================================
+ * OFFLINE SPOOL
+ * ============================================================================ */
+
+bool telemetry_sender_enable_spool(const char* dir) {
+    if (!g_sender_initialized || g_spool_enabled) return g_spool_enabled;
+
+    g_replay_cap = (size_t)TELEMETRY_SPOOL_REPLAY_BATCH * TELEMETRY_JSON_MAX + 128;
+    g_replay_packets = (MMITTelemetryPacket*)malloc(TELEMETRY_SPOOL_REPLAY_BATCH *
+                                                    sizeof(MMITTelemetryPacket));
+    g_replay_buf = (char*)malloc(g_replay_cap);
+    if (!g_replay_packets || !g_replay_buf ||
+        !telemetry_spool_open(&g_spool, dir, TELEMETRY_SPOOL_SEGMENT_BYTES,
+                              TELEMETRY_SPOOL_MAX_SEGMENTS)) {
+        free(g_replay_packets);
+        free(g_replay_buf);
+        g_replay_packets = NULL;
+        g_replay_buf = NULL;
+        return false;
+    }
+    g_spool_enabled = true;
+    g_spool_retry_ns = 0;
+
+    uint64_t pending = telemetry_spool_pending(&g_spool);
+    if (pending > 0) {
+        printf("Telemetry Sender: %lu spooled packets awaiting replay\n", pending);
+    }
+    return true;
+}
+
+static bool spool_has_backlog(void) {
+    return g_spool_enabled && telemetry_spool_pending(&g_spool) > 0;
+}
+
+// Park undelivered packets on disk; returns how many were stored
+static uint32_t spool_packets(const MMITTelemetryPacket* packets, uint32_t count) {
+    if (!g_spool_enabled) return 0;
+    uint32_t stored = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (telemetry_spool_append(&g_spool, &packets[i])) stored++;
+    }
+    g_stats.packets_spooled += stored;
+    return stored;
+}
+
+// One JSON envelope or binary record run for a single vehicle
+static size_t build_batch_body(char* buf, size_t cap, const MMITTelemetryPacket* packets, uint32_t count) {
+    bool json = g_format == TELEMETRY_FORMAT_JSON;
+    size_t len = 0;
+    if (json) {
+        len = (size_t)snprintf(buf, cap, "{\"vehicle_id\":\"%s\",\"packets\":[", packets[0].vehicle_id);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (json && i > 0) buf[len++] = ',';
+        size_t n = telemetry_encode(buf + len, cap - len - 2, &packets[i], TELEMETRY_FIELDS_ALL);
+        if (n == 0) return 0;
+        len += n;
+    }
+    if (json) {
+        buf[len++] = ']';
+        buf[len++] = '}';
+    }
+    return len;
+}
+
+// Deliver the oldest spooled run (one vehicle, up to the replay batch size).
+// Returns false when nothing was sent (empty, backing off, or failed).
+static bool spool_replay_batch(void) {
+    if (!spool_has_backlog() || monotonic_ns() < g_spool_retry_ns) return false;
+
+    uint64_t bytes = 0;
+    uint32_t count = telemetry_spool_peek(&g_spool, g_replay_packets,
+                                          TELEMETRY_SPOOL_REPLAY_BATCH, &bytes);
+    if (count == 0) {
+        // Only an unreadable remainder was found: skip past it
+        telemetry_spool_consume(&g_spool, 0, bytes);
+        return bytes > 0;
+    }
+
+    // A batch targets one vehicle's endpoint
+    uint32_t run = 1;
+    while (run < count &&
+           strcmp(g_replay_packets[run].vehicle_id, g_replay_packets[0].vehicle_id) == 0) {
+        run++;
+    }
+    if (run < count) {
+        bytes = 0;
+        for (uint32_t i = 0; i < run; i++) bytes += telemetry_wire_record_size(&g_replay_packets[i]);
+    }
+
+    size_t len = build_batch_body(g_replay_buf, g_replay_cap, g_replay_packets, run);
+    if (len == 0) return false;
+    if (!telemetry_post(g_replay_packets[0].vehicle_id, "batch", g_replay_buf, len, NULL)) {
+        g_spool_retry_ns = monotonic_ns() + TELEMETRY_SPOOL_RETRY_MS * 1000000ULL;
+        return false;
+    }
+    telemetry_spool_consume(&g_spool, run, bytes);
+    // The backend's latest state for the vehicle is now the replayed tail
+    telemetry_deadband_reset(&g_deadband, g_replay_packets[0].vehicle_id);
+    g_stats.packets_replayed += run;
+    g_stats.batches++;
+    return true;
+}
+
+static void spool_replay(uint32_t max_batches) {
+    for (uint32_t i = 0; i < max_batches && spool_replay_batch(); i++) {
+    }
+}
+
+/* ============================================================================
+ * WEBSOCKET DELIVERY
+ * ============================================================================ */
+
+bool telemetry_sender_set_transport(TelemetryTransport transport) {
+    telemetry_sender_flush();
+    if (transport == TELEMETRY_TRANSPORT_WEBSOCKET && !g_ws_ready) {
+        g_ws_ready = ws_client_init(&g_ws, g_backend_url, g_backend_port, "/ws/telemetry/");
+        if (!g_ws_ready) return false;
+    }
+    g_transport = transport;
+    return true;
+}
+
+TelemetryTransport telemetry_sender_get_transport(void) {
+    return g_transport;
+}
+
+void telemetry_sender_get_ws_stats(WsClientStats* stats) {
+    if (g_ws_ready) *stats = g_ws.stats;
+    else memset(stats, 0, sizeof(WsClientStats));
+}
+
+static bool telemetry_ws_send(const char* vehicle_id, const char* payload, size_t len) {
+    // The backend endpoint is per vehicle
+    char path[128];
+    snprintf(path, sizeof(path), "/ws/telemetry/%s", vehicle_id);
+    ws_client_set_path(&g_ws, path);
+
+    bool was_connected = g_ws.connected;
+    WsOpcode opcode = g_format == TELEMETRY_FORMAT_BINARY ? WS_OP_BINARY : WS_OP_TEXT;
+    bool success = ws_client_send(&g_ws, opcode, payload, len);
+    g_stats.requests++;
+    g_stats.payload_bytes += len;
+
+    if (success && !was_connected) {
+        printf("Telemetry Sender: WebSocket connected (ws://%s:%d%s)\n",
+               g_backend_url, g_backend_port, path);
+    } else if (!success && was_connected) {
+        fprintf(stderr, "Telemetry Sender: WebSocket connection lost, reconnecting with backoff\n");
+    }
+    return success;
+}
+
+bool telemetry_send_to_backend(const MMITTelemetryPacket* packet) {
+    if (!g_sender_initialized) {
+        fprintf(stderr, "Telemetry Sender: Not initialized\n");
+        return false;
+    }
+
+    // A new connection may be a restarted backend without our baseline
+    if (g_transport == TELEMETRY_TRANSPORT_WEBSOCKET && !g_ws.connected) {
+        telemetry_deadband_reset(&g_deadband, packet->vehicle_id);
+    }
+    uint32_t fields = deadband_fields(packet);
+    if (fields == 0) return true;   // Nothing moved and no keepalive due
+
+    // Build payload matching backend MMIT packet model
+    char payload[TELEMETRY_JSON_MAX];
+    size_t len = telemetry_encode(payload, sizeof(payload), packet, fields);
+    if (len == 0) return false;
+
+    if (g_transport == TELEMETRY_TRANSPORT_WEBSOCKET) {
+        bool sent = telemetry_ws_send(packet->vehicle_id, payload, len);
+        if (sent) {
+            g_stats.packets_sent++;
+            return true;
+        }
+        telemetry_deadband_reset(&g_deadband, packet->vehicle_id);
+        if (spool_packets(packet, 1) == 1) {
+            g_spool_retry_ns = monotonic_ns() + TELEMETRY_SPOOL_RETRY_MS * 1000000ULL;
+        } else {
+            g_stats.packets_failed++;
+        }
+        return sent;
+    }
+
+    long status = 0;
+    TelemetryFormat format = g_format;
+    bool success = telemetry_post(packet->vehicle_id, "update", payload, len, &status);
+    if (!success && format != g_format) {
+        // Format was downgraded: resend this packet as JSON
+        len = telemetry_encode(payload, sizeof(payload), packet, fields);
+        success = len > 0 && telemetry_post(packet->vehicle_id, "update", payload, len, NULL);
+    }
+    if (success) {
+        g_stats.packets_sent++;
+        return true;
+    }
+    // The backend may have missed (or rejected) a delta: resync in full
+    telemetry_deadband_reset(&g_deadband, packet->vehicle_id);
+    if (spool_packets(packet, 1) == 1) {
+        g_spool_retry_ns = monotonic_ns() + TELEMETRY_SPOOL_RETRY_MS * 1000000ULL;
+    } else {
+        g_stats.packets_failed++;
+    }
+    return false;
+}
+
+/* ============================================================================
+ * BATCHED DELIVERY
+ * ============================================================================ */
+
+void telemetry_sender_set_format(TelemetryFormat format) {
+    // A pending batch is in the old encoding
+    telemetry_sender_flush();
+    g_format = format;
+}
+
+TelemetryFormat telemetry_sender_get_format(void) {
+    return g_format;
+}
+
+bool telemetry_sender_set_batching(uint32_t max_packets, uint32_t max_latency_ms) {
+    telemetry_sender_flush();
+    if (max_packets <= 1) {
+        g_batching = false;
+        return true;
+    }
+
+    // Worst case: every packet at full size plus the envelope
+    size_t cap = (size_t)max_packets * TELEMETRY_JSON_MAX + 128;
+    char* buf = (char*)realloc(g_batch_buf, cap);
+    if (!buf) return false;
+    g_batch_buf = buf;
+    MMITTelemetryPacket* packets = (MMITTelemetryPacket*)realloc(g_batch_packets,
+                                                                 max_packets * sizeof(MMITTelemetryPacket));
+    if (!packets) return false;
+    g_batch_packets = packets;
+    g_batch_cap = cap;
+    g_batch_max_packets = max_packets;
+    g_batch_max_latency_ms = max_latency_ms;
+    g_batching = true;
+    return true;
+}
+
+bool telemetry_sender_flush(void) {
+    if (g_batch_count == 0) return true;
+
+    uint32_t count = g_batch_count;
+    if (g_format == TELEMETRY_FORMAT_JSON) {
+        g_batch_buf[g_batch_len++] = ']';
+        g_batch_buf[g_batch_len++] = '}';
+    }
+
+    bool success = telemetry_post(g_batch_vehicle, "batch", g_batch_buf, g_batch_len, NULL);
+    if (success) {
+        g_stats.packets_sent += count;
+    } else {
+        telemetry_deadband_reset(&g_deadband, g_batch_vehicle);
+        uint32_t stored = spool_packets(g_batch_packets, count);
+        if (stored > 0) g_spool_retry_ns = monotonic_ns() + TELEMETRY_SPOOL_RETRY_MS * 1000000ULL;
+        g_stats.packets_failed += count - stored;
+    }
+    g_stats.batches++;
+
+    g_batch_len = 0;
+    g_batch_count = 0;
+    return success;
+}
+
+bool telemetry_sender_enqueue(const MMITTelemetryPacket* packet) {
+    // Keep delivery in order: while a backlog exists new packets join it
+    if (spool_has_backlog()) {
+        telemetry_sender_flush();
+        bool stored = spool_packets(packet, 1) == 1;
+        if (!stored) g_stats.packets_failed++;
+        spool_replay(TELEMETRY_SPOOL_REPLAY_BURST);
+        return stored;
+    }
+
+    // Frames are cheap on an open socket: WebSocket sends every packet at once
+    if (!g_batching || g_transport == TELEMETRY_TRANSPORT_WEBSOCKET) {
+        return telemetry_send_to_backend(packet);
+    }
+
+    // A batch targets one vehicle's endpoint
+    bool ok = true;
+    if (g_batch_count > 0 && strcmp(g_batch_vehicle, packet->vehicle_id) != 0) {
+        ok = telemetry_sender_flush();
+    }
+
+    uint32_t fields = deadband_fields(packet);
+    if (fields == 0) {
+        telemetry_sender_poll();
+        return ok;
+    }
+
+    // Binary batches are bare records back to back; JSON needs an envelope
+    bool json = g_format == TELEMETRY_FORMAT_JSON;
+    if (g_batch_count == 0) {
+        snprintf(g_batch_vehicle, sizeof(g_batch_vehicle), "%s", packet->vehicle_id);
+        g_batch_len = 0;
+        if (json) {
+            g_batch_len = (size_t)snprintf(g_batch_buf, g_batch_cap,
+                                           "{\"vehicle_id\":\"%s\",\"packets\":[", g_batch_vehicle);
+        }
+        g_batch_opened_ns = monotonic_ns();
+    } else if (json) {
+        g_batch_buf[g_batch_len++] = ',';
+    }
+
+    // Leave room for the closing "]}"
+    size_t len = telemetry_encode(g_batch_buf + g_batch_len,
+                                  g_batch_cap - g_batch_len - 2, packet, fields);
+    if (len == 0) {
+        g_stats.packets_failed++;
+        return false;
+    }
+    g_batch_len += len;
+    g_batch_packets[g_batch_count++] = *packet;
+
+    if (g_batch_count >= g_batch_max_packets) {
+        ok = telemetry_sender_flush() && ok;
+    } else {
+        telemetry_sender_poll();
+    }
+    return ok;
+}
+
+void telemetry_sender_poll(void) {
+    if (g_batch_count > 0) {
+        uint64_t age_ms = (monotonic_ns() - g_batch_opened_ns) / 1000000ULL;
+        if (age_ms >= g_batch_max_latency_ms) {
+            telemetry_sender_flush();
+        }
+    }
+    spool_replay(TELEMETRY_SPOOL_REPLAY_BURST);
+    if (g_ws_ready) {
+        // Answer pings and consume the backend's broadcasts
+        ws_client_poll(&g_ws, 0);
+    }
+}
+
+void telemetry_sender_get_stats(TelemetrySenderStats* stats) {
+    *stats = g_stats;
+    stats->spool_pending = g_spool_enabled ? telemetry_spool_pending(&g_spool) : 0;
+    stats->spool_dropped = g_spool_enabled ? g_spool.meta->dropped : 0;
+    stats->packets_suppressed = g_deadband.packets_suppressed;
+    stats->fields_offered = g_deadband.fields_offered;
+    stats->fields_sent = g_deadband.fields_sent;
+}
+
+/* ============================================================================
+ * ASYNC SENDER THREAD
+ * ============================================================================ */
+
+#ifdef __unix__
+
+static void* sender_thread_main(void* arg) {
+    (void)arg;
+    MMITTelemetryPacket packet;
+    const struct timespec idle = {0, TELEMETRY_SENDER_IDLE_NS};
+
+    while (true) {
+        bool drained_any = false;
+        while (spsc_ring_pop(&g_queue, &packet)) {
+            telemetry_sender_enqueue(&packet);
+            drained_any = true;
+        }
+        telemetry_sender_poll();
+
+        // Stop only once everything queued before the request is sent
+        if (atomic_load(&g_async_stop) && spsc_ring_depth(&g_queue) == 0) break;
+        if (!drained_any) nanosleep(&idle, NULL);
+    }
+    telemetry_sender_flush();
+    return NULL;
+}
+
+bool telemetry_sender_start_async(uint32_t capacity, SpscOverflowPolicy policy) {
+    if (!g_sender_initialized) return false;
+    if (g_async_running) return true;
+
+    if (g_queue_valid) spsc_ring_free(&g_queue);
+    g_queue_valid = spsc_ring_init(&g_queue, sizeof(MMITTelemetryPacket), capacity, policy);
+    if (!g_queue_valid) return false;
+
+    atomic_store(&g_async_stop, false);
+    if (pthread_create(&g_sender_thread, NULL, sender_thread_main, NULL) != 0) {
+        fprintf(stderr, "Telemetry Sender: Failed to start sender thread\n");
+        return false;
+    }
+    g_async_running = true;
     return true;
+}
+
+void telemetry_sender_stop_async(void) {
+    if (!g_async_running) return;
+    atomic_store(&g_async_stop, true);
+    pthread_join(g_sender_thread, NULL);
+    g_async_running = false;
+}
+
+#else
+
+bool telemetry_sender_start_async(uint32_t capacity, SpscOverflowPolicy policy) {
+    // No threads: submit() sends synchronously
+    (void)capacity;
+    (void)policy;
+    return false;
+}
+
+void telemetry_sender_stop_async(void) {
+}
+
 #endif
+
+bool telemetry_sender_submit(const MMITTelemetryPacket* packet) {
+    if (!g_async_running) {
+        return telemetry_sender_enqueue(packet);
+    }
+    return spsc_ring_push(&g_queue, packet);
+}
+
+void telemetry_sender_get_queue_stats(SpscRingStats* stats) {
+    if (!g_queue_valid) {
+        memset(stats, 0, sizeof(SpscRingStats));
+        return;
+    }
+    spsc_ring_get_stats(&g_queue, stats);
 }
 
 void mmit_sensors_to_telemetry(BlackBoxSoC* soc, MMITTelemetryPacket* packet, const char* vehicle_id) {
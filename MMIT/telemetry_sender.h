@@ -7,12 +7,15 @@
 #define TELEMETRY_SENDER_H
 
 #include "blackbox_common.h"
+#include "spsc_ring.h"
+#include "ws_client.h"
 #include <stdint.h>
 #include <stdbool.h>
 
 // Telemetry data structure matching backend model
 typedef struct {
     char vehicle_id[32];
+    uint64_t timestamp_ns;       // Capture time (Unix ns); 0 = stamp at send
     
     // Telemetry values from MMIT sensors
     float speed_kph;
@@ -48,12 +51,100 @@ typedef struct {
     bool traction_control;
 } MMITTelemetryPacket;
 
+// Sender thread sleep when its queue is empty
+#define TELEMETRY_SENDER_IDLE_NS    1000000
+
+// Upper bound for one serialized packet
+#define TELEMETRY_JSON_MAX      2048
+
+// Request body encoding. JSON is the default; binary (telemetry_wire.h) is
+// opt-in and falls back to JSON if the backend answers 415.
+typedef enum {
+    TELEMETRY_FORMAT_JSON,
+    TELEMETRY_FORMAT_BINARY
+} TelemetryFormat;
+
+// How packets reach the backend. HTTP POSTs to /api/v1/telemetry/{id}/...;
+// WebSocket streams one frame per packet to /ws/telemetry/{id}.
+typedef enum {
+    TELEMETRY_TRANSPORT_HTTP,
+    TELEMETRY_TRANSPORT_WEBSOCKET
+} TelemetryTransport;
+
+typedef struct {
+    uint64_t packets_sent;
+    uint64_t packets_failed;
+    uint64_t requests;
+    uint64_t batches;
+    uint64_t payload_bytes;
+    uint64_t packets_spooled;    // Parked on disk after a failed send
+    uint64_t packets_replayed;   // Delivered later from the spool
+    uint64_t spool_pending;
+    uint64_t spool_dropped;      // Lost to the spool's disk bound
+    uint64_t packets_suppressed; // Deadband: nothing changed, nothing sent
+    uint64_t fields_offered;     // Deadband: fields sampled / fields sent
+    uint64_t fields_sent;
+} TelemetrySenderStats;
+
 // Initialize telemetry sender with backend URL
 bool telemetry_sender_init(const char* backend_url, int backend_port);
 
 // Send telemetry packet to backend API
 bool telemetry_send_to_backend(const MMITTelemetryPacket* packet);
 
+void telemetry_sender_set_format(TelemetryFormat format);
+TelemetryFormat telemetry_sender_get_format(void);
+
+// Send-on-change (telemetry_deadband.h): packets carry only the fields that
+// moved past their threshold or are due a keepalive, as deltas the backend
+// merges. Default from TELEMETRY_DEADBAND_DEFAULT in network_config.h.
+void telemetry_sender_set_deadband(bool enabled);
+bool telemetry_sender_get_deadband(void);
+
+// Default comes from TELEMETRY_DEFAULT_TRANSPORT in network_config.h.
+// Batching applies to HTTP only; the spool always replays over HTTP.
+bool telemetry_sender_set_transport(TelemetryTransport transport);
+TelemetryTransport telemetry_sender_get_transport(void);
+void telemetry_sender_get_ws_stats(WsClientStats* stats);
+
+// Batching: queued packets go out as one array payload to .../batch once
+// max_packets accumulate or the oldest is max_latency_ms old.
+// max_packets <= 1 disables batching.
+bool telemetry_sender_set_batching(uint32_t max_packets, uint32_t max_latency_ms);
+
+// Send now, or queue when batching is enabled (may trigger a flush)
+bool telemetry_sender_enqueue(const MMITTelemetryPacket* packet);
+
+// Flush the pending batch / flush it if its latency deadline has passed
+bool telemetry_sender_flush(void);
+void telemetry_sender_poll(void);
+
+// Offline spool (telemetry_spool.h): undelivered packets are written to dir
+// and replayed in order, in batches, once the backend answers again. A
+// spool left by a previous run is resumed.
+bool telemetry_sender_enable_spool(const char* dir);
+
+// Stats are updated by the sender thread in async mode; read them after
+// telemetry_sender_stop_async() for exact values
+void telemetry_sender_get_stats(TelemetrySenderStats* stats);
+
+// Async mode: a dedicated thread drains a lock-free SPSC ring of packets, so
+// the (single) producer never waits on the network. Batching still applies.
+bool telemetry_sender_start_async(uint32_t capacity, SpscOverflowPolicy policy);
+
+// Send everything already queued, then join the sender thread
+void telemetry_sender_stop_async(void);
+
+// Producer side: never blocks when async is running (returns false if the
+// packet was dropped by the overflow policy); sends inline otherwise
+bool telemetry_sender_submit(const MMITTelemetryPacket* packet);
+
+// Queue depth, high-water mark and drop counters
+void telemetry_sender_get_queue_stats(SpscRingStats* stats);
+
+// Current wall-clock time in Unix nanoseconds (packet timestamps)
+uint64_t telemetry_now_ns(void);
+
 // Cleanup telemetry sender
 void telemetry_sender_cleanup(void);
 
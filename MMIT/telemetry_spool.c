@@ -0,0 +1,278 @@
+/*
+ * BlackBox DPU - Telemetry Offline Spool Implementation
+ *
+ * Records are telemetry_wire.h records appended to seg_NNNNNNNN.bin files.
+ * The head offset is advanced only after a record is fully written, so a
+ * torn append is truncated away when the spool is reopened.
+ */
+
+#include "telemetry_spool.h"
+#include "telemetry_wire.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __unix__
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static void segment_path(const TelemetrySpool* spool, uint32_t segment, char* out, size_t cap) {
+    snprintf(out, cap, "%s/seg_%08u.bin", spool->dir, segment);
+}
+
+static int open_segment(const TelemetrySpool* spool, uint32_t segment, bool truncate) {
+    char path[320];
+    segment_path(spool, segment, path, sizeof(path));
+    int flags = O_WRONLY | O_CREAT | O_APPEND | (truncate ? O_TRUNC : 0);
+    return open(path, flags, 0644);
+}
+
+// Count records from offset to the end of a segment
+static uint64_t count_records(const TelemetrySpool* spool, uint32_t segment, uint64_t offset) {
+    char path[320];
+    segment_path(spool, segment, path, sizeof(path));
+    FILE* f = fopen(path, "rb");
+    if (!f) return 0;
+
+    uint64_t count = 0;
+    uint8_t header[8];
+    fseek(f, (long)offset, SEEK_SET);
+    while (fread(header, 1, sizeof(header), f) == sizeof(header)) {
+        uint16_t len = (uint16_t)(header[4] | (header[5] << 8));
+        if (len < sizeof(header) || fseek(f, len - (long)sizeof(header), SEEK_CUR) != 0) break;
+        count++;
+    }
+    fclose(f);
+    return count;
+}
+
+static void remove_segment(const TelemetrySpool* spool, uint32_t segment) {
+    char path[320];
+    segment_path(spool, segment, path, sizeof(path));
+    unlink(path);
+}
+
+// Disk bound reached: discard the oldest segment's unsent records
+static void drop_tail_segment(TelemetrySpool* spool) {
+    SpoolMeta* m = spool->meta;
+    uint64_t lost = count_records(spool, m->tail_segment, m->tail_offset);
+    remove_segment(spool, m->tail_segment);
+    m->tail_segment++;
+    m->tail_offset = 0;
+    m->pending = m->pending > lost ? m->pending - lost : 0;
+    m->dropped += lost;
+}
+
+bool telemetry_spool_open(TelemetrySpool* spool, const char* dir,
+                          uint64_t segment_bytes, uint32_t max_segments) {
+    memset(spool, 0, sizeof(TelemetrySpool));
+    snprintf(spool->dir, sizeof(spool->dir), "%s", dir);
+    spool->segment_bytes = segment_bytes;
+    spool->max_segments = max_segments < 2 ? 2 : max_segments;
+    spool->meta_fd = -1;
+    spool->head_fd = -1;
+
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST) {
+        perror("Spool: mkdir");
+        return false;
+    }
+
+    char path[320];
+    snprintf(path, sizeof(path), "%s/%s", dir, TELEMETRY_SPOOL_META);
+    spool->meta_fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (spool->meta_fd < 0 || ftruncate(spool->meta_fd, sizeof(SpoolMeta)) != 0) {
+        perror("Spool: meta");
+        telemetry_spool_close(spool);
+        return false;
+    }
+    void* map = mmap(NULL, sizeof(SpoolMeta), PROT_READ | PROT_WRITE, MAP_SHARED, spool->meta_fd, 0);
+    if (map == MAP_FAILED) {
+        perror("Spool: mmap");
+        telemetry_spool_close(spool);
+        return false;
+    }
+    spool->meta = (SpoolMeta*)map;
+
+    SpoolMeta* m = spool->meta;
+    bool resume = (m->magic == TELEMETRY_SPOOL_MAGIC && m->version == TELEMETRY_SPOOL_VERSION &&
+                   m->tail_segment <= m->head_segment);
+    if (!resume) {
+        memset(m, 0, sizeof(SpoolMeta));
+        m->magic = TELEMETRY_SPOOL_MAGIC;
+        m->version = TELEMETRY_SPOOL_VERSION;
+    }
+
+    spool->head_fd = open_segment(spool, m->head_segment, !resume);
+    if (spool->head_fd < 0) {
+        perror("Spool: segment");
+        telemetry_spool_close(spool);
+        return false;
+    }
+    // Discard a torn append past the committed head
+    if (ftruncate(spool->head_fd, (off_t)m->head_offset) != 0) {
+        perror("Spool: truncate");
+    }
+    return true;
+}
+
+void telemetry_spool_close(TelemetrySpool* spool) {
+    if (spool->head_fd >= 0) close(spool->head_fd);
+    if (spool->meta) {
+        msync(spool->meta, sizeof(SpoolMeta), MS_SYNC);
+        munmap(spool->meta, sizeof(SpoolMeta));
+    }
+    if (spool->meta_fd >= 0) close(spool->meta_fd);
+    spool->head_fd = -1;
+    spool->meta_fd = -1;
+    spool->meta = NULL;
+}
+
+bool telemetry_spool_append(TelemetrySpool* spool, const MMITTelemetryPacket* packet) {
+    if (!spool->meta) return false;
+    SpoolMeta* m = spool->meta;
+
+    uint8_t record[TELEMETRY_WIRE_MAX];
+    size_t len = telemetry_wire_encode(record, sizeof(record), packet);
+    if (len == 0) return false;
+
+    // Seal a full segment and start the next one
+    if (m->head_offset + len > spool->segment_bytes) {
+        close(spool->head_fd);
+        spool->head_fd = open_segment(spool, m->head_segment + 1, true);
+        if (spool->head_fd < 0) return false;
+        m->head_segment++;
+        m->head_offset = 0;
+        msync(m, sizeof(SpoolMeta), MS_ASYNC);
+
+        while (m->head_segment - m->tail_segment >= spool->max_segments) {
+            drop_tail_segment(spool);
+        }
+    }
+
+    ssize_t written = write(spool->head_fd, record, len);
+    if (written != (ssize_t)len) {
+        // Roll back a partial write so the segment stays parseable
+        if (ftruncate(spool->head_fd, (off_t)m->head_offset) != 0) {
+            perror("Spool: truncate");
+        }
+        return false;
+    }
+    m->head_offset += len;
+    m->pending++;
+    m->appended++;
+    return true;
+}
+
+uint32_t telemetry_spool_peek(TelemetrySpool* spool, MMITTelemetryPacket* out,
+                              uint32_t max, uint64_t* bytes) {
+    *bytes = 0;
+    if (!spool->meta || spool->meta->pending == 0) return 0;
+    SpoolMeta* m = spool->meta;
+
+    char path[320];
+    struct stat st;
+    while (true) {
+        segment_path(spool, m->tail_segment, path, sizeof(path));
+        uint64_t end = m->head_offset;
+        if (m->tail_segment < m->head_segment) {
+            end = (stat(path, &st) == 0) ? (uint64_t)st.st_size : 0;
+        }
+        if (m->tail_offset < end) break;
+        if (m->tail_segment == m->head_segment) return 0;
+
+        // Tail segment fully replayed
+        remove_segment(spool, m->tail_segment);
+        m->tail_segment++;
+        m->tail_offset = 0;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    uint64_t end = (m->tail_segment < m->head_segment && fstat(fd, &st) == 0)
+                   ? (uint64_t)st.st_size : m->head_offset;
+    void* map = end > 0 ? mmap(NULL, end, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (map == MAP_FAILED) return 0;
+
+    const uint8_t* base = (const uint8_t*)map;
+    uint64_t pos = m->tail_offset;
+    uint32_t count = 0;
+    while (count < max && pos < end) {
+        size_t used = telemetry_wire_decode(base + pos, end - pos, &out[count]);
+        if (used == 0) {
+            // Corrupt remainder: skip to the end of this segment
+            pos = end;
+            break;
+        }
+        pos += used;
+        count++;
+    }
+    munmap(map, end);
+
+    *bytes = pos - m->tail_offset;
+    return count;
+}
+
+void telemetry_spool_consume(TelemetrySpool* spool, uint32_t count, uint64_t bytes) {
+    if (!spool->meta) return;
+    SpoolMeta* m = spool->meta;
+    m->tail_offset += bytes;
+    m->pending = m->pending > count ? m->pending - count : 0;
+    m->replayed += count;
+    if (m->pending == 0 && m->tail_segment == m->head_segment) {
+        msync(m, sizeof(SpoolMeta), MS_ASYNC);
+    }
+}
+
+uint64_t telemetry_spool_pending(const TelemetrySpool* spool) {
+    return spool->meta ? spool->meta->pending : 0;
+}
+
+#else
+
+/* ============================================================================
+ * WINDOWS STUB (no mmap; packets are not spooled)
+ * ============================================================================ */
+
+bool telemetry_spool_open(TelemetrySpool* spool, const char* dir,
+                          uint64_t segment_bytes, uint32_t max_segments) {
+    (void)dir;
+    (void)segment_bytes;
+    (void)max_segments;
+    memset(spool, 0, sizeof(TelemetrySpool));
+    return false;
+}
+
+void telemetry_spool_close(TelemetrySpool* spool) {
+    (void)spool;
+}
+
+bool telemetry_spool_append(TelemetrySpool* spool, const MMITTelemetryPacket* packet) {
+    (void)spool;
+    (void)packet;
+    return false;
+}
+
+uint32_t telemetry_spool_peek(TelemetrySpool* spool, MMITTelemetryPacket* out,
+                              uint32_t max, uint64_t* bytes) {
+    (void)spool;
+    (void)out;
+    (void)max;
+    *bytes = 0;
+    return 0;
+}
+
+void telemetry_spool_consume(TelemetrySpool* spool, uint32_t count, uint64_t bytes) {
+    (void)spool;
+    (void)count;
+    (void)bytes;
+}
+
+uint64_t telemetry_spool_pending(const TelemetrySpool* spool) {
+    (void)spool;
+    return 0;
+}
+
+#endif
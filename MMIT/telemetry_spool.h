@@ -0,0 +1,62 @@
+/*
+ * BlackBox DPU - Telemetry Offline Spool
+ * Disk-backed FIFO of unsent packets: append-only segment files plus an
+ * mmap'd head/tail record, bounded by dropping the oldest segment
+ */
+
+#ifndef TELEMETRY_SPOOL_H
+#define TELEMETRY_SPOOL_H
+
+#include "telemetry_sender.h"
+
+#define TELEMETRY_SPOOL_DIR         "telemetry_spool"
+#define TELEMETRY_SPOOL_META        "spool.meta"
+#define TELEMETRY_SPOOL_MAGIC       0x4C4F5053u      // "SPOL"
+#define TELEMETRY_SPOOL_VERSION     1
+
+// Persistent cursor state (mmap'd; every store is the update)
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t head_segment;   // Segment being appended
+    uint32_t tail_segment;   // Oldest segment with unsent records
+    uint64_t head_offset;    // Bytes committed in the head segment
+    uint64_t tail_offset;    // Replay position in the tail segment
+    uint64_t pending;        // Records between tail and head
+    uint64_t appended;
+    uint64_t replayed;
+    uint64_t dropped;        // Lost to the disk bound
+} SpoolMeta;
+
+typedef struct {
+    char dir[256];
+    SpoolMeta* meta;
+    int meta_fd;
+    int head_fd;
+    uint64_t segment_bytes;
+    uint32_t max_segments;
+} TelemetrySpool;
+
+/* ============================================================================
+ * SPOOL FUNCTIONS
+ * ============================================================================ */
+
+// Open (or resume) the spool in dir. Disk use is capped at roughly
+// segment_bytes * max_segments.
+bool telemetry_spool_open(TelemetrySpool* spool, const char* dir,
+                          uint64_t segment_bytes, uint32_t max_segments);
+void telemetry_spool_close(TelemetrySpool* spool);
+
+bool telemetry_spool_append(TelemetrySpool* spool, const MMITTelemetryPacket* packet);
+
+// Read up to max of the oldest records without consuming them. *bytes
+// receives the spool bytes they occupy (pass it to consume).
+uint32_t telemetry_spool_peek(TelemetrySpool* spool, MMITTelemetryPacket* out,
+                              uint32_t max, uint64_t* bytes);
+
+// Retire records returned by peek once they are delivered
+void telemetry_spool_consume(TelemetrySpool* spool, uint32_t count, uint64_t bytes);
+
+uint64_t telemetry_spool_pending(const TelemetrySpool* spool);
+
+#endif // TELEMETRY_SPOOL_H
@@ -0,0 +1,183 @@
+/*
+ * BlackBox DPU - Telemetry Binary Wire Format Implementation
+ */
+
+#include "telemetry_wire.h"
+#include "telemetry_deadband.h"
+#include <string.h>
+
+// Float fields in wire order
+#define WIRE_FLOAT_COUNT    18
+
+static void packet_floats(const MMITTelemetryPacket* p, float out[WIRE_FLOAT_COUNT]) {
+    out[0] = p->speed_kph;
+    out[1] = p->rpm;
+    out[2] = p->throttle_pct;
+    out[3] = p->brake_pct;
+    out[4] = p->battery_voltage;
+    out[5] = p->engine_temp_c;
+    out[6] = p->fuel_level_pct;
+    out[7] = p->gps_lat;
+    out[8] = p->gps_lon;
+    out[9] = p->ambient_temp_c;
+    out[10] = p->humidity_pct;
+    out[11] = p->wheel_fl;
+    out[12] = p->wheel_fr;
+    out[13] = p->wheel_rl;
+    out[14] = p->wheel_rr;
+    out[15] = p->cpu_usage_pct;
+    out[16] = p->ram_usage_pct;
+    out[17] = p->network_latency_ms;
+}
+
+static void packet_set_floats(MMITTelemetryPacket* p, const float in[WIRE_FLOAT_COUNT]) {
+    p->speed_kph = in[0];
+    p->rpm = in[1];
+    p->throttle_pct = in[2];
+    p->brake_pct = in[3];
+    p->battery_voltage = in[4];
+    p->engine_temp_c = in[5];
+    p->fuel_level_pct = in[6];
+    p->gps_lat = in[7];
+    p->gps_lon = in[8];
+    p->ambient_temp_c = in[9];
+    p->humidity_pct = in[10];
+    p->wheel_fl = in[11];
+    p->wheel_fr = in[12];
+    p->wheel_rl = in[13];
+    p->wheel_rr = in[14];
+    p->cpu_usage_pct = in[15];
+    p->ram_usage_pct = in[16];
+    p->network_latency_ms = in[17];
+}
+
+/* ============================================================================
+ * LITTLE-ENDIAN HELPERS
+ * ============================================================================ */
+
+static void put_le16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void put_le64(uint8_t* p, uint64_t v) {
+    put_le32(p, (uint32_t)v);
+    put_le32(p + 4, (uint32_t)(v >> 32));
+}
+
+static uint16_t get_le16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_le32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_le64(const uint8_t* p) {
+    return (uint64_t)get_le32(p) | ((uint64_t)get_le32(p + 4) << 32);
+}
+
+/* ============================================================================
+ * ENCODE / DECODE
+ * ============================================================================ */
+
+size_t telemetry_wire_record_size(const MMITTelemetryPacket* packet) {
+    return TELEMETRY_WIRE_FIXED_SIZE + strnlen(packet->vehicle_id, sizeof(packet->vehicle_id) - 1);
+}
+
+// Common 16-byte record header
+static void put_header(uint8_t* buf, const MMITTelemetryPacket* packet, uint8_t flags,
+                       size_t total, size_t id_len) {
+    if (packet->abs_active) flags |= TELEMETRY_WIRE_FLAG_ABS;
+    if (packet->traction_control) flags |= TELEMETRY_WIRE_FLAG_TC;
+
+    buf[0] = TELEMETRY_WIRE_MAGIC0;
+    buf[1] = TELEMETRY_WIRE_MAGIC1;
+    buf[2] = TELEMETRY_WIRE_VERSION;
+    buf[3] = flags;
+    put_le16(buf + 4, (uint16_t)total);
+    buf[6] = (uint8_t)(int8_t)packet->gear;
+    buf[7] = (uint8_t)id_len;
+    put_le64(buf + 8, packet->timestamp_ns);
+}
+
+size_t telemetry_wire_encode(uint8_t* buf, size_t cap, const MMITTelemetryPacket* packet) {
+    size_t total = telemetry_wire_record_size(packet);
+    size_t id_len = total - TELEMETRY_WIRE_FIXED_SIZE;
+    if (total > cap) return 0;
+
+    put_header(buf, packet, 0, total, id_len);
+
+    float values[WIRE_FLOAT_COUNT];
+    packet_floats(packet, values);
+    for (int i = 0; i < WIRE_FLOAT_COUNT; i++) {
+        uint32_t bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+        put_le32(buf + 16 + i * 4, bits);
+    }
+
+    memcpy(buf + TELEMETRY_WIRE_FIXED_SIZE, packet->vehicle_id, id_len);
+    return total;
+}
+
+size_t telemetry_wire_encode_delta(uint8_t* buf, size_t cap, const MMITTelemetryPacket* packet,
+                                   uint32_t mask) {
+    mask &= TELEMETRY_FIELDS_ALL;
+    uint32_t floats = mask & ((1u << WIRE_FLOAT_COUNT) - 1);
+    size_t id_len = telemetry_wire_record_size(packet) - TELEMETRY_WIRE_FIXED_SIZE;
+    size_t total = TELEMETRY_WIRE_DELTA_HEADER + 4 * (size_t)__builtin_popcount(floats) + id_len;
+    if (total > cap) return 0;
+
+    put_header(buf, packet, TELEMETRY_WIRE_FLAG_DELTA, total, id_len);
+    put_le32(buf + 16, mask);
+
+    float values[WIRE_FLOAT_COUNT];
+    packet_floats(packet, values);
+    uint8_t* p = buf + TELEMETRY_WIRE_DELTA_HEADER;
+    for (int i = 0; i < WIRE_FLOAT_COUNT; i++) {
+        if (!(floats & (1u << i))) continue;
+        uint32_t bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+        put_le32(p, bits);
+        p += 4;
+    }
+
+    memcpy(p, packet->vehicle_id, id_len);
+    return total;
+}
+
+size_t telemetry_wire_decode(const uint8_t* buf, size_t len, MMITTelemetryPacket* packet) {
+    if (len < TELEMETRY_WIRE_FIXED_SIZE) return 0;
+    if (buf[0] != TELEMETRY_WIRE_MAGIC0 || buf[1] != TELEMETRY_WIRE_MAGIC1) return 0;
+    if (buf[2] < TELEMETRY_WIRE_VERSION) return 0;
+    if (buf[3] & TELEMETRY_WIRE_FLAG_DELTA) return 0;
+
+    size_t record_len = get_le16(buf + 4);
+    size_t id_len = buf[7];
+    if (id_len >= sizeof(packet->vehicle_id)) return 0;
+    if (record_len < TELEMETRY_WIRE_FIXED_SIZE + id_len || record_len > len) return 0;
+
+    memset(packet, 0, sizeof(MMITTelemetryPacket));
+    packet->abs_active = (buf[3] & TELEMETRY_WIRE_FLAG_ABS) != 0;
+    packet->traction_control = (buf[3] & TELEMETRY_WIRE_FLAG_TC) != 0;
+    packet->gear = (int8_t)buf[6];
+    packet->timestamp_ns = get_le64(buf + 8);
+
+    float values[WIRE_FLOAT_COUNT];
+    for (int i = 0; i < WIRE_FLOAT_COUNT; i++) {
+        uint32_t bits = get_le32(buf + 16 + i * 4);
+        memcpy(&values[i], &bits, sizeof(bits));
+    }
+    packet_set_floats(packet, values);
+
+    memcpy(packet->vehicle_id, buf + TELEMETRY_WIRE_FIXED_SIZE, id_len);
+    packet->vehicle_id[id_len] = '\0';
+    return record_len;
+}
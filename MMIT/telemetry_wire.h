@@ -0,0 +1,75 @@
+/*
+ * BlackBox DPU - Telemetry Binary Wire Format
+ * Versioned little-endian encoding of MMITTelemetryPacket
+ * (Content-Type: application/octet-stream)
+ */
+
+#ifndef TELEMETRY_WIRE_H
+#define TELEMETRY_WIRE_H
+
+#include "telemetry_sender.h"
+#include <stddef.h>
+
+/*
+ * Record layout, version 1 (all fields little-endian, no padding):
+ *
+ *   0   u8[2]  magic "MT"
+ *   2   u8     version
+ *   3   u8     flags (bit 0 ABS active, bit 1 traction control)
+ *   4   u16    record length in bytes, including this header
+ *   6   i8     gear
+ *   7   u8     vehicle_id length (n)
+ *   8   u64    timestamp_ns (Unix ns; 0 = receiver's clock)
+ *  16   f32    x18: speed_kph, rpm, throttle_pct, brake_pct, battery_voltage,
+ *              engine_temp_c, fuel_level_pct, gps_lat, gps_lon,
+ *              ambient_temp_c, humidity_pct, wheel_fl, wheel_fr, wheel_rl,
+ *              wheel_rr, cpu_usage_pct, ram_usage_pct, network_latency_ms
+ *  88   u8[n]  vehicle_id (not NUL-terminated)
+ *
+ * A batch body is records back to back. Decoders must honour the record
+ * length so newer versions can append fields without breaking them.
+ *
+ * Delta records (flag bit 2, see telemetry_deadband.h) keep the 16-byte
+ * header and carry only changed fields:
+ *
+ *  16   u32    field mask (TelemetryField bits)
+ *  20   f32    one per set float bit (0-17), in field order
+ *   …   u8[n]  vehicle_id
+ *
+ * Gear and the ABS/TC flags stay in the header; mask bits 18-20 say whether
+ * they belong to the delta. The backend merges a delta onto the last packet
+ * it holds for the vehicle.
+ */
+#define TELEMETRY_WIRE_MAGIC0       'M'
+#define TELEMETRY_WIRE_MAGIC1       'T'
+#define TELEMETRY_WIRE_VERSION      1
+#define TELEMETRY_WIRE_FIXED_SIZE   88
+#define TELEMETRY_WIRE_MAX          (TELEMETRY_WIRE_FIXED_SIZE + 32)
+#define TELEMETRY_WIRE_CONTENT_TYPE "application/octet-stream"
+
+#define TELEMETRY_WIRE_FLAG_ABS     0x01
+#define TELEMETRY_WIRE_FLAG_TC      0x02
+#define TELEMETRY_WIRE_FLAG_DELTA   0x04
+
+#define TELEMETRY_WIRE_DELTA_HEADER 20
+
+/* ============================================================================
+ * WIRE FORMAT FUNCTIONS
+ * ============================================================================ */
+
+// Encode one record into buf. Returns bytes written, or 0 if it did not fit.
+size_t telemetry_wire_encode(uint8_t* buf, size_t cap, const MMITTelemetryPacket* packet);
+
+// Encoded size of a packet's record
+size_t telemetry_wire_record_size(const MMITTelemetryPacket* packet);
+
+// Encode only the fields set in mask (TelemetryField bits) as a delta record.
+// Returns bytes written, or 0 if it did not fit.
+size_t telemetry_wire_encode_delta(uint8_t* buf, size_t cap, const MMITTelemetryPacket* packet,
+                                   uint32_t mask);
+
+// Decode the full record at the start of buf. Returns the bytes it occupies,
+// or 0 if buf is truncated, a delta record, or not a supported record.
+size_t telemetry_wire_decode(const uint8_t* buf, size_t len, MMITTelemetryPacket* packet);
+
+#endif // TELEMETRY_WIRE_H
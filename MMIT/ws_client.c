@@ -0,0 +1,486 @@
+/*
+ * BlackBox DPU - WebSocket Client Implementation
+ * Plain TCP (ws://) client: opening handshake, masked client frames,
+ * ping/pong and close handling
+ */
+
+#include "ws_client.h"
+#include "blackbox_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#ifdef __unix__
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+#define WS_GUID "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+/* ============================================================================
+ * SHA-1 / BASE64 (handshake key check)
+ * ============================================================================ */
+
+static uint32_t rol32(uint32_t v, int n) {
+    return (v << n) | (v >> (32 - n));
+}
+
+static void sha1(const uint8_t* data, size_t len, uint8_t out[20]) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+    uint64_t bit_len = (uint64_t)len * 8;
+    size_t total = ((len + 8) / 64 + 1) * 64;
+
+    for (size_t block = 0; block < total; block += 64) {
+        uint8_t chunk[64];
+        for (size_t i = 0; i < 64; i++) {
+            size_t pos = block + i;
+            if (pos < len) chunk[i] = data[pos];
+            else if (pos == len) chunk[i] = 0x80;
+            else if (pos >= total - 8) chunk[i] = (uint8_t)(bit_len >> (8 * (total - 1 - pos)));
+            else chunk[i] = 0;
+        }
+
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++) {
+            w[i] = ((uint32_t)chunk[i * 4] << 24) | ((uint32_t)chunk[i * 4 + 1] << 16) |
+                   ((uint32_t)chunk[i * 4 + 2] << 8) | chunk[i * 4 + 3];
+        }
+        for (int i = 16; i < 80; i++) {
+            w[i] = rol32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; i++) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            uint32_t t = rol32(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rol32(b, 30);
+            b = a;
+            a = t;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    for (int i = 0; i < 5; i++) {
+        out[i * 4] = (uint8_t)(h[i] >> 24);
+        out[i * 4 + 1] = (uint8_t)(h[i] >> 16);
+        out[i * 4 + 2] = (uint8_t)(h[i] >> 8);
+        out[i * 4 + 3] = (uint8_t)h[i];
+    }
+}
+
+static void base64_encode(const uint8_t* in, size_t len, char* out) {
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)in[i] << 16;
+        if (i + 1 < len) v |= (uint32_t)in[i + 1] << 8;
+        if (i + 2 < len) v |= in[i + 2];
+        out[o++] = table[(v >> 18) & 63];
+        out[o++] = table[(v >> 12) & 63];
+        out[o++] = i + 1 < len ? table[(v >> 6) & 63] : '=';
+        out[o++] = i + 2 < len ? table[v & 63] : '=';
+    }
+    out[o] = '\0';
+}
+
+// xorshift64*: masking keys only need to be unpredictable to proxies
+static uint32_t next_mask(WsClient* ws) {
+    ws->mask_state ^= ws->mask_state >> 12;
+    ws->mask_state ^= ws->mask_state << 25;
+    ws->mask_state ^= ws->mask_state >> 27;
+    return (uint32_t)((ws->mask_state * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+/* ============================================================================
+ * LIFECYCLE
+ * ============================================================================ */
+
+bool ws_client_init(WsClient* ws, const char* host, int port, const char* path) {
+    memset(ws, 0, sizeof(WsClient));
+    snprintf(ws->host, sizeof(ws->host), "%s", host);
+    ws->port = port;
+    snprintf(ws->path, sizeof(ws->path), "%s", path);
+    ws->fd = -1;
+    ws->backoff_ms = WS_BACKOFF_INITIAL_MS;
+    ws->mask_state = monotonic_ns() | 1;
+    ws->rx = (uint8_t*)malloc(WS_RX_BUFFER);
+    return ws->rx != NULL;
+}
+
+void ws_client_free(WsClient* ws) {
+    ws_client_close(ws);
+    free(ws->rx);
+    free(ws->tx);
+    ws->rx = NULL;
+    ws->tx = NULL;
+}
+
+void ws_client_set_path(WsClient* ws, const char* path) {
+    if (strcmp(ws->path, path) == 0) return;
+    snprintf(ws->path, sizeof(ws->path), "%s", path);
+    ws_client_close(ws);
+    // New endpoint: no reason to wait out the old backoff
+    ws->next_attempt_ns = 0;
+    ws->backoff_ms = WS_BACKOFF_INITIAL_MS;
+}
+
+#ifdef __unix__
+
+static void schedule_retry(WsClient* ws) {
+    // Exponential backoff with +/-25% jitter so a fleet does not reconnect in step
+    uint32_t jitter = next_mask(ws) % (ws->backoff_ms / 2 + 1);
+    uint64_t delay_ms = ws->backoff_ms - ws->backoff_ms / 4 + jitter;
+    ws->next_attempt_ns = monotonic_ns() + delay_ms * 1000000ULL;
+    ws->backoff_ms = ws->backoff_ms * 2 > WS_BACKOFF_MAX_MS ? WS_BACKOFF_MAX_MS : ws->backoff_ms * 2;
+}
+
+static bool send_all(int fd, const uint8_t* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static int open_socket(const WsClient* ws) {
+    char port[16];
+    snprintf(port, sizeof(port), "%d", ws->port);
+    struct addrinfo hints;
+    struct addrinfo* res = NULL;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(ws->host, port, &hints, &res) != 0) return -1;
+
+    int fd = -1;
+    for (struct addrinfo* ai = res; ai && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0) continue;
+
+        // Non-blocking connect so an unreachable host cannot stall sampling
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        int rc = connect(fd, ai->ai_addr, ai->ai_addrlen);
+        if (rc != 0 && errno == EINPROGRESS) {
+            struct pollfd pfd = {fd, POLLOUT, 0};
+            int err = 0;
+            socklen_t err_len = sizeof(err);
+            if (poll(&pfd, 1, WS_CONNECT_TIMEOUT_MS) == 1 &&
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &err_len) == 0 && err == 0) {
+                rc = 0;
+            }
+        }
+        if (rc != 0) {
+            close(fd);
+            fd = -1;
+            continue;
+        }
+        fcntl(fd, F_SETFL, flags);
+    }
+    freeaddrinfo(res);
+    if (fd < 0) return -1;
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    struct timeval tv = {WS_SEND_TIMEOUT_SEC, 0};
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    return fd;
+}
+
+static bool handshake(WsClient* ws) {
+    uint8_t nonce[16];
+    for (int i = 0; i < 16; i += 4) {
+        uint32_t r = next_mask(ws);
+        memcpy(nonce + i, &r, 4);
+    }
+    char key[32];
+    base64_encode(nonce, sizeof(nonce), key);
+
+    char request[512];
+    int len = snprintf(request, sizeof(request),
+                       "GET %s HTTP/1.1\r\n"
+                       "Host: %s:%d\r\n"
+                       "Upgrade: websocket\r\n"
+                       "Connection: Upgrade\r\n"
+                       "Sec-WebSocket-Key: %s\r\n"
+                       "Sec-WebSocket-Version: 13\r\n\r\n",
+                       ws->path, ws->host, ws->port, key);
+    if (len <= 0 || !send_all(ws->fd, (const uint8_t*)request, (size_t)len)) return false;
+
+    // Read the response headers
+    char response[2048];
+    size_t got = 0;
+    char* end = NULL;
+    uint64_t deadline = monotonic_ns() + WS_CONNECT_TIMEOUT_MS * 1000000ULL;
+    while (!end) {
+        uint64_t now = monotonic_ns();
+        if (now >= deadline || got >= sizeof(response) - 1) return false;
+        struct pollfd pfd = {ws->fd, POLLIN, 0};
+        if (poll(&pfd, 1, (int)((deadline - now) / 1000000ULL) + 1) <= 0) return false;
+        ssize_t n = recv(ws->fd, response + got, sizeof(response) - 1 - got, 0);
+        if (n <= 0) return false;
+        got += (size_t)n;
+        response[got] = '\0';
+        end = strstr(response, "\r\n\r\n");
+    }
+
+    if (strncmp(response, "HTTP/1.1 101", 12) != 0) return false;
+
+    // Sec-WebSocket-Accept must be base64(SHA1(key + GUID))
+    char concat[96];
+    uint8_t digest[20];
+    char expected[32];
+    snprintf(concat, sizeof(concat), "%s%s", key, WS_GUID);
+    sha1((const uint8_t*)concat, strlen(concat), digest);
+    base64_encode(digest, sizeof(digest), expected);
+
+    bool accepted = false;
+    for (char* line = strstr(response, "\r\n"); line && line < end; line = strstr(line + 2, "\r\n")) {
+        const char* name = "Sec-WebSocket-Accept:";
+        if (strncasecmp(line + 2, name, strlen(name)) == 0) {
+            const char* value = line + 2 + strlen(name);
+            while (*value == ' ') value++;
+            accepted = strncmp(value, expected, strlen(expected)) == 0;
+            break;
+        }
+    }
+    if (!accepted) return false;
+
+    // Anything after the headers is already frame data
+    size_t extra = got - (size_t)(end + 4 - response);
+    memcpy(ws->rx, end + 4, extra);
+    ws->rx_len = extra;
+    return true;
+}
+
+bool ws_client_connect(WsClient* ws) {
+    if (ws->connected) return true;
+
+    ws->fd = open_socket(ws);
+    if (ws->fd >= 0 && handshake(ws)) {
+        ws->connected = true;
+        ws->backoff_ms = WS_BACKOFF_INITIAL_MS;
+        ws->stats.connects++;
+        return true;
+    }
+
+    if (ws->fd >= 0) close(ws->fd);
+    ws->fd = -1;
+    ws->stats.connect_failures++;
+    schedule_retry(ws);
+    return false;
+}
+
+void ws_client_close(WsClient* ws) {
+    if (ws->fd >= 0) {
+        if (ws->connected) {
+            // Best-effort close frame (status 1000)
+            uint8_t frame[8] = {0x80 | WS_OP_CLOSE, 0x80 | 2, 0, 0, 0, 0, 0x03, 0xE8};
+            send(ws->fd, frame, sizeof(frame), MSG_NOSIGNAL | MSG_DONTWAIT);
+            ws->stats.disconnects++;
+        }
+        close(ws->fd);
+    }
+    ws->fd = -1;
+    ws->connected = false;
+    ws->rx_len = 0;
+}
+
+static void drop_connection(WsClient* ws) {
+    ws_client_close(ws);
+    schedule_retry(ws);
+}
+
+/* ============================================================================
+ * FRAMING
+ * ============================================================================ */
+
+static bool send_frame(WsClient* ws, WsOpcode opcode, const void* payload, size_t len) {
+    size_t need = len + 14;
+    if (need > ws->tx_cap) {
+        uint8_t* tx = (uint8_t*)realloc(ws->tx, need);
+        if (!tx) return false;
+        ws->tx = tx;
+        ws->tx_cap = need;
+    }
+
+    uint8_t* p = ws->tx;
+    *p++ = (uint8_t)(0x80 | opcode);   // FIN, no fragmentation
+    if (len < 126) {
+        *p++ = (uint8_t)(0x80 | len);
+    } else if (len <= 0xFFFF) {
+        *p++ = 0x80 | 126;
+        *p++ = (uint8_t)(len >> 8);
+        *p++ = (uint8_t)len;
+    } else {
+        *p++ = 0x80 | 127;
+        for (int i = 7; i >= 0; i--) *p++ = (uint8_t)((uint64_t)len >> (8 * i));
+    }
+
+    // Client frames are always masked
+    uint32_t mask = next_mask(ws);
+    uint8_t key[4];
+    memcpy(key, &mask, 4);
+    memcpy(p, key, 4);
+    p += 4;
+    const uint8_t* src = (const uint8_t*)payload;
+    for (size_t i = 0; i < len; i++) p[i] = src[i] ^ key[i & 3];
+    p += len;
+
+    return send_all(ws->fd, ws->tx, (size_t)(p - ws->tx));
+}
+
+bool ws_client_send(WsClient* ws, WsOpcode opcode, const void* payload, size_t len) {
+    if (!ws->connected) {
+        if (monotonic_ns() < ws->next_attempt_ns) return false;
+        if (!ws_client_connect(ws)) return false;
+    }
+    if (!send_frame(ws, opcode, payload, len)) {
+        drop_connection(ws);
+        return false;
+    }
+    ws->stats.frames_sent++;
+    ws->stats.bytes_sent += len;
+    return true;
+}
+
+// Parse complete frames from the receive buffer
+static int process_frames(WsClient* ws) {
+    int delivered = 0;
+    size_t pos = 0;
+    while (ws->connected && ws->rx_len - pos >= 2) {
+        const uint8_t* f = ws->rx + pos;
+        size_t avail = ws->rx_len - pos;
+        WsOpcode opcode = (WsOpcode)(f[0] & 0x0F);
+        bool masked = (f[1] & 0x80) != 0;
+        uint64_t len = f[1] & 0x7F;
+        size_t header = 2;
+        if (len == 126) {
+            if (avail < 4) break;
+            len = ((uint64_t)f[2] << 8) | f[3];
+            header = 4;
+        } else if (len == 127) {
+            if (avail < 10) break;
+            len = 0;
+            for (int i = 0; i < 8; i++) len = (len << 8) | f[2 + i];
+            header = 10;
+        }
+        if (masked) header += 4;
+        if (header + len > WS_RX_BUFFER) {
+            // Larger than we ever expect from the backend
+            drop_connection(ws);
+            return delivered;
+        }
+        if (avail < header + len) break;
+
+        uint8_t* payload = (uint8_t*)f + header;
+        if (masked) {
+            const uint8_t* key = f + header - 4;
+            for (uint64_t i = 0; i < len; i++) payload[i] ^= key[i & 3];
+        }
+
+        switch (opcode) {
+            case WS_OP_PING:
+                send_frame(ws, WS_OP_PONG, payload, (size_t)len);
+                break;
+            case WS_OP_CLOSE:
+                drop_connection(ws);
+                return delivered;
+            case WS_OP_PONG:
+                break;
+            default:
+                ws->stats.frames_received++;
+                delivered++;
+                if (ws->on_message) ws->on_message(ws->user, opcode, payload, (size_t)len);
+                break;
+        }
+        pos += header + (size_t)len;
+    }
+
+    if (ws->connected && pos > 0) {
+        memmove(ws->rx, ws->rx + pos, ws->rx_len - pos);
+        ws->rx_len -= pos;
+    }
+    return delivered;
+}
+
+int ws_client_poll(WsClient* ws, int timeout_ms) {
+    if (!ws->connected) return 0;
+
+    struct pollfd pfd = {ws->fd, POLLIN, 0};
+    if (poll(&pfd, 1, timeout_ms) <= 0) return 0;
+
+    int delivered = 0;
+    while (ws->connected) {
+        ssize_t n = recv(ws->fd, ws->rx + ws->rx_len, WS_RX_BUFFER - ws->rx_len, MSG_DONTWAIT);
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+            drop_connection(ws);
+            break;
+        }
+        if (n < 0) break;
+        ws->rx_len += (size_t)n;
+        delivered += process_frames(ws);
+    }
+    return delivered;
+}
+
+#else
+
+/* ============================================================================
+ * WINDOWS STUB (BSD sockets not wired up)
+ * ============================================================================ */
+
+bool ws_client_connect(WsClient* ws) {
+    ws->stats.connect_failures++;
+    return false;
+}
+
+void ws_client_close(WsClient* ws) {
+    ws->connected = false;
+}
+
+bool ws_client_send(WsClient* ws, WsOpcode opcode, const void* payload, size_t len) {
+    (void)opcode;
+    (void)payload;
+    (void)len;
+    return ws_client_connect(ws);
+}
+
+int ws_client_poll(WsClient* ws, int timeout_ms) {
+    (void)ws;
+    (void)timeout_ms;
+    return 0;
+}
+
+#endif
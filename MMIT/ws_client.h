@@ -0,0 +1,85 @@
+/*
+ * BlackBox DPU - WebSocket Client
+ * One long-lived RFC 6455 connection for streaming telemetry frames,
+ * with automatic reconnect and exponential backoff
+ */
+
+#ifndef WS_CLIENT_H
+#define WS_CLIENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define WS_RX_BUFFER            65536
+#define WS_CONNECT_TIMEOUT_MS   3000
+#define WS_SEND_TIMEOUT_SEC     5
+#define WS_BACKOFF_INITIAL_MS   500
+#define WS_BACKOFF_MAX_MS       30000
+
+typedef enum {
+    WS_OP_CONTINUATION = 0x0,
+    WS_OP_TEXT = 0x1,
+    WS_OP_BINARY = 0x2,
+    WS_OP_CLOSE = 0x8,
+    WS_OP_PING = 0x9,
+    WS_OP_PONG = 0xA
+} WsOpcode;
+
+// Text/binary frame received from the server (payload valid for the call)
+typedef void (*WsMessageFn)(void* user, WsOpcode opcode, const uint8_t* payload, size_t len);
+
+typedef struct {
+    uint64_t frames_sent;
+    uint64_t bytes_sent;
+    uint64_t frames_received;
+    uint64_t connects;
+    uint64_t connect_failures;
+    uint64_t disconnects;
+} WsClientStats;
+
+typedef struct {
+    char host[128];
+    int port;
+    char path[256];
+
+    int fd;
+    bool connected;
+    uint32_t backoff_ms;
+    uint64_t next_attempt_ns;    // Earliest reconnect (monotonic)
+    uint64_t mask_state;
+
+    uint8_t* rx;
+    size_t rx_len;
+    uint8_t* tx;
+    size_t tx_cap;
+
+    WsMessageFn on_message;
+    void* user;
+    WsClientStats stats;
+} WsClient;
+
+/* ============================================================================
+ * WEBSOCKET CLIENT FUNCTIONS
+ * ============================================================================ */
+
+bool ws_client_init(WsClient* ws, const char* host, int port, const char* path);
+void ws_client_free(WsClient* ws);
+
+// Change the endpoint path; reconnects on the next send if it differs
+void ws_client_set_path(WsClient* ws, const char* path);
+
+// Connect now (blocking handshake, bounded by WS_CONNECT_TIMEOUT_MS).
+// Failures schedule the next attempt with exponential backoff.
+bool ws_client_connect(WsClient* ws);
+void ws_client_close(WsClient* ws);
+
+// Send one unfragmented frame. Reconnects first if the backoff allows;
+// returns false immediately while disconnected and backing off.
+bool ws_client_send(WsClient* ws, WsOpcode opcode, const void* payload, size_t len);
+
+// Read pending frames for up to timeout_ms: answers pings, handles close,
+// and passes data frames to on_message. Returns frames delivered.
+int ws_client_poll(WsClient* ws, int timeout_ms);
+
+#endif // WS_CLIENT_H
@@ -10,12 +10,30 @@
  * (Simplified for simulation - real HW would use full Zstd algorithm)
  * ============================================================================ */
 
+// Nonzero if any byte of v is zero
+#define RLE_HAS_ZERO_BYTE(v) \
+    (((v) - 0x0101010101010101ULL) & ~(v) & 0x8080808080808080ULL)
+
 uint32_t simple_compress(uint8_t* src, uint32_t src_len, uint8_t* dst, uint32_t level) {
     // Simplified compression model: Run-Length Encoding for demonstration
     uint32_t dst_idx = 0;
     uint32_t i = 0;
     
     while (i < src_len) {
+        // Fast path for incompressible data: eight bytes with no 0xFF and no
+        // byte equal to its successor are eight single-byte literals
+        if (i + 9 <= src_len) {
+            uint64_t cur, next;
+            memcpy(&cur, src + i, 8);
+            memcpy(&next, src + i + 1, 8);
+            if (!RLE_HAS_ZERO_BYTE(cur ^ next) && !RLE_HAS_ZERO_BYTE(~cur)) {
+                memcpy(dst + dst_idx, &cur, 8);
+                dst_idx += 8;
+                i += 8;
+                continue;
+            }
+        }
+        
         uint8_t value = src[i];
         uint32_t count = 1;
         
@@ -39,6 +57,29 @@ uint32_t simple_compress(uint8_t* src, uint32_t src_len, uint8_t* dst, uint32_t
     return dst_idx;
 }
 
+uint32_t simple_decompress(const uint8_t* src, uint32_t src_len, uint8_t* dst, uint32_t dst_cap) {
+    // 0xFF introduces a run (value, count); every other byte is a literal
+    uint32_t dst_idx = 0;
+    uint32_t i = 0;
+    
+    while (i < src_len) {
+        if (src[i] != 0xFF) {
+            if (dst_idx >= dst_cap) return 0;
+            dst[dst_idx++] = src[i++];
+            continue;
+        }
+        if (i + 2 >= src_len) return 0;
+        uint8_t value = src[i + 1];
+        uint32_t count = src[i + 2];
+        if (count > dst_cap - dst_idx) return 0;
+        memset(dst + dst_idx, value, count);
+        dst_idx += count;
+        i += 3;
+    }
+    
+    return dst_idx;
+}
+
 /* ============================================================================
  * ZSTANDARD ACCELERATOR MODEL
  * ============================================================================ */
@@ -15,6 +15,10 @@
  * ============================================================================ */
 
 uint32_t simple_compress(uint8_t* src, uint32_t src_len, uint8_t* dst, uint32_t level);
+
+// Inverse of simple_compress. Returns the decoded length, or 0 if the input
+// is malformed or would not fit in dst_cap.
+uint32_t simple_decompress(const uint8_t* src, uint32_t src_len, uint8_t* dst, uint32_t dst_cap);
 void zstd_start_compression(BlackBoxSoC* soc);
 
 #endif // ZSTD_ACCELERATOR_H
@@ -1,4 +1,4 @@
-from fastapi import FastAPI, WebSocket, Depends, HTTPException, status, Header
+from fastapi import FastAPI, WebSocket, Depends, HTTPException, status, Header, Request
 from fastapi.middleware.cors import CORSMiddleware
 from fastapi.responses import JSONResponse
 from contextlib import asynccontextmanager
@@ -13,6 +13,8 @@ import os
 import random
 import math
 import time
+import struct
+import zlib
 
 # ==================== CONFIG ====================
 SECRET_KEY = os.getenv("SECRET_KEY", "your-secret-key-change-in-production")
@@ -70,6 +72,270 @@ class TelemetryUpdate(BaseModel):
     vehicle_id: str
     data: TelemetryData
 
+# Packet shape posted by the MMIT BlackBox DPU (telemetry_sender.c)
+class MMITGps(BaseModel):
+    lat: float
+    lon: float
+
+class MMITWheelSpeed(BaseModel):
+    front_left: float
+    front_right: float
+    rear_left: float
+    rear_right: float
+
+class MMITTelemetryBody(BaseModel):
+    speed_kph: float
+    rpm: float
+    throttle_pct: float = 0
+    brake_pct: float = 0
+    gear: int = 0
+    battery_voltage: float
+    engine_temp_c: float
+    fuel_level_pct: float
+    gps: MMITGps
+    ambient_temp_c: float
+    humidity_pct: float
+    wheel_speed: MMITWheelSpeed
+
+class MMITSystem(BaseModel):
+    cpu_usage_pct: float
+    ram_usage_pct: float
+    network_latency_ms: float
+    last_sync: str = ""
+
+class MMITStatus(BaseModel):
+    ABS_active: bool = False
+    traction_control: bool = False
+    DTC: List[str] = []
+
+class MMITPacket(BaseModel):
+    vehicle_id: str
+    timestamp: str
+    telemetry: MMITTelemetryBody
+    system: MMITSystem
+    status: MMITStatus
+
+class MMITBatch(BaseModel):
+    vehicle_id: str
+    packets: List[Dict[str, Any]]  # Full MMITPacket objects or deltas
+
+# Binary wire format (MMIT/telemetry_wire.h), Content-Type application/octet-stream
+MMIT_WIRE_CONTENT_TYPE = "application/octet-stream"
+MMIT_WIRE_MAGIC = b"MT"
+MMIT_WIRE_VERSION = 1
+MMIT_WIRE_HEADER = struct.Struct("<2sBBHbBQ18f")
+MMIT_WIRE_FLAG_ABS = 0x01
+MMIT_WIRE_FLAG_TC = 0x02
+MMIT_WIRE_FLAG_DELTA = 0x04
+MMIT_WIRE_DELTA_HEADER = struct.Struct("<2sBBHbBQI")
+
+# Send-on-change deltas (MMIT/telemetry_deadband.h): field name -> path in
+# MMITPacket, in TelemetryField bit order. The first 18 are the wire floats.
+MMIT_DELTA_FIELDS = {
+    "speed_kph": ("telemetry", "speed_kph"),
+    "rpm": ("telemetry", "rpm"),
+    "throttle_pct": ("telemetry", "throttle_pct"),
+    "brake_pct": ("telemetry", "brake_pct"),
+    "battery_voltage": ("telemetry", "battery_voltage"),
+    "engine_temp_c": ("telemetry", "engine_temp_c"),
+    "fuel_level_pct": ("telemetry", "fuel_level_pct"),
+    "gps_lat": ("telemetry", "gps", "lat"),
+    "gps_lon": ("telemetry", "gps", "lon"),
+    "ambient_temp_c": ("telemetry", "ambient_temp_c"),
+    "humidity_pct": ("telemetry", "humidity_pct"),
+    "wheel_fl": ("telemetry", "wheel_speed", "front_left"),
+    "wheel_fr": ("telemetry", "wheel_speed", "front_right"),
+    "wheel_rl": ("telemetry", "wheel_speed", "rear_left"),
+    "wheel_rr": ("telemetry", "wheel_speed", "rear_right"),
+    "cpu_usage_pct": ("system", "cpu_usage_pct"),
+    "ram_usage_pct": ("system", "ram_usage_pct"),
+    "network_latency_ms": ("system", "network_latency_ms"),
+    "gear": ("telemetry", "gear"),
+    "ABS_active": ("status", "ABS_active"),
+    "traction_control": ("status", "traction_control"),
+}
+MMIT_DELTA_FIELD_NAMES = list(MMIT_DELTA_FIELDS)
+MMIT_WIRE_FLOAT_COUNT = 18
+
+# Last full state per vehicle, the base that deltas are merged onto
+mmit_last_packets: Dict[str, "MMITPacket"] = {}
+
+def mmit_wire_timestamp(timestamp_ns: int) -> str:
+    """ISO timestamp as the JSON encoding writes it (ms when the DPU stamped it)"""
+    captured = datetime.utcfromtimestamp(timestamp_ns // 1_000_000_000) if timestamp_ns else datetime.utcnow()
+    timestamp = captured.strftime("%Y-%m-%dT%H:%M:%S")
+    if timestamp_ns:
+        timestamp += f".{timestamp_ns // 1_000_000 % 1000:03d}"
+    return timestamp + "Z"
+
+def mmit_round(index: int, value: float) -> float:
+    """Same precision the JSON encoding carries (%.2f, GPS %.6f)"""
+    return round(value, 6 if index in (7, 8) else 2)
+
+def decode_mmit_wire_delta(body: bytes, offset: int) -> Dict[str, Any]:
+    """Decode one delta record into the JSON delta shape"""
+    (_, _, flags, record_len, gear, id_len, timestamp_ns,
+     mask) = MMIT_WIRE_DELTA_HEADER.unpack_from(body, offset)
+    floats = [i for i in range(MMIT_WIRE_FLOAT_COUNT) if mask & (1 << i)]
+    if record_len != MMIT_WIRE_DELTA_HEADER.size + 4 * len(floats) + id_len:
+        raise ValueError("bad delta record length")
+
+    values = struct.unpack_from(f"<{len(floats)}f", body, offset + MMIT_WIRE_DELTA_HEADER.size)
+    delta = {MMIT_DELTA_FIELD_NAMES[i]: mmit_round(i, v) for i, v in zip(floats, values)}
+    if mask & (1 << 18):
+        delta["gear"] = gear
+    if mask & (1 << 19):
+        delta["ABS_active"] = bool(flags & MMIT_WIRE_FLAG_ABS)
+    if mask & (1 << 20):
+        delta["traction_control"] = bool(flags & MMIT_WIRE_FLAG_TC)
+
+    id_start = offset + record_len - id_len
+    return {
+        "vehicle_id": body[id_start:offset + record_len].decode("ascii"),
+        "timestamp": mmit_wire_timestamp(timestamp_ns),
+        "delta": delta,
+    }
+
+def decode_mmit_wire(body: bytes) -> List[Any]:
+    """Decode back-to-back binary records into MMIT packets and delta dicts"""
+    packets = []
+    offset = 0
+    while offset < len(body):
+        if len(body) - offset < MMIT_WIRE_DELTA_HEADER.size:
+            raise ValueError("truncated record header")
+        magic, version, flags, record_len = struct.unpack_from("<2sBBH", body, offset)
+        if magic != MMIT_WIRE_MAGIC or version < MMIT_WIRE_VERSION:
+            raise ValueError("not an MMIT telemetry record")
+        if offset + record_len > len(body):
+            raise ValueError("bad record length")
+        if flags & MMIT_WIRE_FLAG_DELTA:
+            packets.append(decode_mmit_wire_delta(body, offset))
+            offset += record_len
+            continue
+
+        if len(body) - offset < MMIT_WIRE_HEADER.size:
+            raise ValueError("truncated record header")
+        (_, _, _, _, gear, id_len, timestamp_ns,
+         *values) = MMIT_WIRE_HEADER.unpack_from(body, offset)
+        if record_len < MMIT_WIRE_HEADER.size + id_len:
+            raise ValueError("bad record length")
+
+        id_start = offset + MMIT_WIRE_HEADER.size
+        vehicle_id = body[id_start:id_start + id_len].decode("ascii")
+        timestamp = mmit_wire_timestamp(timestamp_ns)
+        v = [mmit_round(i, x) for i, x in enumerate(values)]
+        packets.append(MMITPacket(
+            vehicle_id=vehicle_id,
+            timestamp=timestamp,
+            telemetry=MMITTelemetryBody(
+                speed_kph=v[0], rpm=v[1], throttle_pct=v[2], brake_pct=v[3], gear=gear,
+                battery_voltage=v[4], engine_temp_c=v[5], fuel_level_pct=v[6],
+                gps=MMITGps(lat=v[7], lon=v[8]),
+                ambient_temp_c=v[9], humidity_pct=v[10],
+                wheel_speed=MMITWheelSpeed(front_left=v[11], front_right=v[12],
+                                           rear_left=v[13], rear_right=v[14]),
+            ),
+            system=MMITSystem(cpu_usage_pct=v[15], ram_usage_pct=v[16],
+                              network_latency_ms=v[17], last_sync=timestamp),
+            status=MMITStatus(ABS_active=bool(flags & MMIT_WIRE_FLAG_ABS),
+                              traction_control=bool(flags & MMIT_WIRE_FLAG_TC)),
+        ))
+        offset += record_len
+    return packets
+
+# Request-body compression (Content-Encoding); the decoded size is capped so a
+# small compressed upload cannot expand without bound
+MMIT_MAX_DECODED_BODY = 16 * 1024 * 1024
+MMIT_ZLIB_WBITS = {"gzip": 16 + zlib.MAX_WBITS, "deflate": zlib.MAX_WBITS}
+
+async def read_request_body(request: Request) -> bytes:
+    """Return the request body with any gzip/deflate Content-Encoding removed"""
+    body = await request.body()
+    encoding = request.headers.get("content-encoding", "identity").strip().lower()
+    if encoding == "identity":
+        return body
+    if encoding not in MMIT_ZLIB_WBITS:
+        raise HTTPException(status_code=415, detail=f"Unsupported Content-Encoding: {encoding}")
+    try:
+        decoder = zlib.decompressobj(MMIT_ZLIB_WBITS[encoding])
+        decoded = decoder.decompress(body, MMIT_MAX_DECODED_BODY)
+        if decoder.unconsumed_tail:
+            raise HTTPException(status_code=413, detail="Decoded body too large")
+        return decoded + decoder.flush()
+    except zlib.error as e:
+        raise HTTPException(status_code=400, detail=f"Invalid {encoding} body: {e}")
+
+def resolve_mmit_packets(items: List[Any]) -> List[MMITPacket]:
+    """Turn decoded items into full packets, in order, merging each delta
+    onto the vehicle's last known state"""
+    packets = []
+    for item in items:
+        if isinstance(item, MMITPacket):
+            packet = item
+        elif "delta" in item:
+            base = mmit_last_packets.get(item["vehicle_id"])
+            if base is None:
+                # The DPU resends in full after a failed delivery
+                raise HTTPException(status_code=409, detail="Delta without a baseline packet")
+            data = base.model_dump()
+            data["timestamp"] = item["timestamp"]
+            data["system"]["last_sync"] = item["timestamp"]
+            for name, value in item["delta"].items():
+                *parents, leaf = MMIT_DELTA_FIELDS[name]
+                target = data
+                for key in parents:
+                    target = target[key]
+                target[leaf] = value
+            packet = MMITPacket(**data)
+        else:
+            packet = MMITPacket(**item)
+        mmit_last_packets[packet.vehicle_id] = packet
+        packets.append(packet)
+    return packets
+
+async def read_mmit_packets(request: Request) -> List[MMITPacket]:
+    """Decode a request body by Content-Type; JSON (single or batch) is the default"""
+    content_type = request.headers.get("content-type", "application/json").split(";")[0].strip()
+    body = await read_request_body(request)
+    try:
+        if content_type == MMIT_WIRE_CONTENT_TYPE:
+            return resolve_mmit_packets(decode_mmit_wire(body))
+        if content_type == "application/json":
+            payload = json.loads(body)
+            if "packets" in payload:
+                return resolve_mmit_packets(MMITBatch(**payload).packets)
+            return resolve_mmit_packets([payload])
+    except (ValueError, TypeError, KeyError, struct.error) as e:
+        raise HTTPException(status_code=422, detail=f"Invalid telemetry payload: {e}")
+    raise HTTPException(status_code=415, detail=f"Unsupported Content-Type: {content_type}")
+
+def mmit_to_telemetry_data(packet: MMITPacket) -> TelemetryData:
+    """Map an MMIT packet onto the dashboard's TelemetryData model"""
+    t = packet.telemetry
+    return TelemetryData(
+        # Stored timestamps are naive UTC (see get_telemetry_history)
+        timestamp=packet.timestamp.rstrip("Z"),
+        speed=t.speed_kph,
+        rpm=int(round(t.rpm)),
+        engine_temp=t.engine_temp_c,
+        battery_voltage=t.battery_voltage,
+        fuel_level=t.fuel_level_pct,
+        traction_control=packet.status.traction_control,
+        cpu_usage=packet.system.cpu_usage_pct,
+        memory_usage=packet.system.ram_usage_pct,
+        latency_ms=packet.system.network_latency_ms,
+        uptime_seconds=0,
+        ambient_temp=t.ambient_temp_c,
+        humidity=t.humidity_pct,
+        gps_lat=t.gps.lat,
+        gps_lon=t.gps.lon,
+        wheel_speed_fl=t.wheel_speed.front_left,
+        wheel_speed_fr=t.wheel_speed.front_right,
+        wheel_speed_rl=t.wheel_speed.rear_left,
+        wheel_speed_rr=t.wheel_speed.rear_right,
+        diagnostics=packet.status.DTC,
+    )
+
 # ==================== REALISTIC VEHICLE SIMULATOR ====================
 class VehicleSimulator:
     """Simulates realistic vehicle telemetry with physically accurate correlations"""
@@ -475,18 +741,22 @@ class DataStore:
         return self.data["vehicles"].get(vehicle_id)
 
     def add_telemetry(self, vehicle_id: str, telemetry: TelemetryData):
+        return self.add_telemetry_batch(vehicle_id, [telemetry])[-1]
+
+    def add_telemetry_batch(self, vehicle_id: str, telemetry: List[TelemetryData]) -> List[Dict]:
+        """Append a batch in capture order and persist once"""
         if vehicle_id not in self.data["telemetry"]:
             self.data["telemetry"][vehicle_id] = []
         
-        telemetry_dict = telemetry.dict()
-        self.data["telemetry"][vehicle_id].append(telemetry_dict)
+        added = [t.dict() for t in telemetry]
+        self.data["telemetry"][vehicle_id].extend(added)
         
         # Keep only last 1000 entries per vehicle
         if len(self.data["telemetry"][vehicle_id]) > 1000:
             self.data["telemetry"][vehicle_id] = self.data["telemetry"][vehicle_id][-1000:]
         
         self.save_to_file()
-        return telemetry_dict
+        return added
 
     def get_telemetry(self, vehicle_id: str, limit: int = 100) -> List[Dict]:
         telemetry_list = self.data["telemetry"].get(vehicle_id, [])
@@ -685,6 +955,22 @@ async def report_telemetry(vehicle_id: str, data: TelemetryData, authorization:
     result = store.add_telemetry(vehicle_id, data)
     return {"success": True, "data": result}
 
+@app.post("/api/v1/telemetry/{vehicle_id}/update")
+async def update_telemetry(vehicle_id: str, request: Request):
+    """Single packet from the MMIT BlackBox DPU (JSON or binary)"""
+    packets = await read_mmit_packets(request)
+    if len(packets) != 1:
+        raise HTTPException(status_code=422, detail="Expected exactly one packet")
+    result = store.add_telemetry(vehicle_id, mmit_to_telemetry_data(packets[0]))
+    return {"success": True, "data": result}
+
+@app.post("/api/v1/telemetry/{vehicle_id}/batch")
+async def batch_telemetry(vehicle_id: str, request: Request):
+    """Batched packets from the MMIT BlackBox DPU, stored in capture order"""
+    packets = sorted(await read_mmit_packets(request), key=lambda p: p.timestamp)
+    result = store.add_telemetry_batch(vehicle_id, [mmit_to_telemetry_data(p) for p in packets])
+    return {"success": True, "count": len(result)}
+
 # ==================== WEBSOCKET ====================
 class ConnectionManager:
     def __init__(self):
@@ -711,11 +997,25 @@ async def websocket_endpoint(websocket: WebSocket, vehicle_id: str):
     await manager.connect(websocket)
     try:
         while True:
-            data = await websocket.receive_text()
-            message = json.loads(data)
-            
-            if message.get("type") == "telemetry":
-                telemetry = TelemetryData(**message.get("data"))
+            frame = await websocket.receive()
+            if frame["type"] == "websocket.disconnect":
+                break
+
+            # Dashboard clients send {"type":"telemetry","data":TelemetryData};
+            # the MMIT DPU streams raw MMIT packets (JSON text or binary wire frames)
+            if frame.get("bytes") is not None:
+                packets = resolve_mmit_packets(decode_mmit_wire(frame["bytes"]))
+                updates = [mmit_to_telemetry_data(p) for p in packets]
+            else:
+                message = json.loads(frame.get("text") or "{}")
+                if message.get("type") == "telemetry":
+                    updates = [TelemetryData(**message.get("data"))]
+                elif ("telemetry" in message or "delta" in message) and "vehicle_id" in message:
+                    updates = [mmit_to_telemetry_data(p) for p in resolve_mmit_packets([message])]
+                else:
+                    continue
+
+            for telemetry in updates:
                 store.add_telemetry(vehicle_id, telemetry)
                 await manager.broadcast({
                     "type": "telemetry_update",